@@ -61,6 +61,8 @@
 #    error Itcl 4 build requires tcl.h from Tcl 8.6 or later
 #endif
 
+#include <tclOO.h>
+
 /*
  * For C++ compilers, use extern "C"
  */
@@ -174,6 +176,20 @@ typedef struct Itcl_List {
  */
 typedef struct Itcl_InterpState_ *Itcl_InterpState;
 
+/*
+ *  Token representing a method of a class, see Itcl_GetMethod.
+ */
+typedef struct Itcl_Method_ *Itcl_Method;
+
+/*
+ *  Procedure implementing a method, see Itcl_RegisterMethodC.
+ */
+struct ItclObject;
+struct ItclClass;
+typedef int (Itcl_MethodCProc)(ClientData clientData, Tcl_Interp *interp,
+	struct ItclObject *ioPtr, struct ItclClass *iclsPtr, int objc,
+	Tcl_Obj *const objv[]);
+
 
 /*
  * Include all the public API, generated from itcl.decls.
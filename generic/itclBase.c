@@ -232,8 +232,10 @@ Initialize (
     Tcl_InitHashTable(&infoPtr->namespaceClasses, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&infoPtr->procMethods, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&infoPtr->instances, TCL_STRING_KEYS);
-    Tcl_InitHashTable(&infoPtr->frameContext, TCL_ONE_WORD_KEYS);
+    ItclInitFrameContexts(infoPtr);
     Tcl_InitObjHashTable(&infoPtr->classTypes);
+    ItclInitObjectTables(&infoPtr->noObjectTables);
+    Tcl_InitHashTable(&infoPtr->argLists, TCL_STRING_KEYS);
 
     infoPtr->ensembleInfo = (EnsembleInfo *)ckalloc(sizeof(EnsembleInfo));
     memset(infoPtr->ensembleInfo, 0, sizeof(EnsembleInfo));
@@ -245,21 +247,13 @@ Initialize (
     infoPtr->buildingWidget = 0;
     infoPtr->typeDestructorArgumentPtr = Tcl_NewStringObj("", -1);
     Tcl_IncrRefCount(infoPtr->typeDestructorArgumentPtr);
+    infoPtr->codeWords[0] = Tcl_NewStringObj("namespace", -1);
+    Tcl_IncrRefCount(infoPtr->codeWords[0]);
+    infoPtr->codeWords[1] = Tcl_NewStringObj("inscope", -1);
+    Tcl_IncrRefCount(infoPtr->codeWords[1]);
     infoPtr->lastIoPtr = NULL;
 
-    Tcl_SetVar2(interp, ITCL_NAMESPACE"::internal::dicts::classes", NULL, "", 0);
-    Tcl_SetVar2(interp, ITCL_NAMESPACE"::internal::dicts::objects", NULL, "", 0);
-    Tcl_SetVar2(interp, ITCL_NAMESPACE"::internal::dicts::classOptions", NULL, "", 0);
-    Tcl_SetVar2(interp,
-            ITCL_NAMESPACE"::internal::dicts::classDelegatedOptions", NULL, "", 0);
-    Tcl_SetVar2(interp,
-            ITCL_NAMESPACE"::internal::dicts::classComponents", NULL, "", 0);
-    Tcl_SetVar2(interp,
-            ITCL_NAMESPACE"::internal::dicts::classVariables", NULL, "", 0);
-    Tcl_SetVar2(interp,
-            ITCL_NAMESPACE"::internal::dicts::classFunctions", NULL, "", 0);
-    Tcl_SetVar2(interp,
-            ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions", NULL, "", 0);
+    ItclInitDictInfo(interp, infoPtr);
 
     hPtr = Tcl_CreateHashEntry(&infoPtr->classTypes,
             (char *)Tcl_NewStringObj("class", -1), &isNew);
@@ -563,11 +557,15 @@ FreeItclObjectInfo(
 
     Tcl_DeleteHashTable(&infoPtr->instances);
     Tcl_DeleteHashTable(&infoPtr->classTypes);
+    ItclDeleteObjectTables(&infoPtr->noObjectTables);
+    ItclFinishArgLists(infoPtr);
     Tcl_DeleteHashTable(&infoPtr->procMethods);
     Tcl_DeleteHashTable(&infoPtr->objectCmds);
     Tcl_DeleteHashTable(&infoPtr->classes);
     Tcl_DeleteHashTable(&infoPtr->nameClasses);
     Tcl_DeleteHashTable(&infoPtr->namespaceClasses);
+    ItclFinishDictInfo(infoPtr->interp, infoPtr);
+    ItclFinishProfile(infoPtr);
 
     assert (infoPtr->infoVarsPtr == NULL);
     assert (infoPtr->infoVars4Ptr == NULL);
@@ -576,6 +574,11 @@ FreeItclObjectInfo(
 	Tcl_DecrRefCount(infoPtr->typeDestructorArgumentPtr);
 	infoPtr->typeDestructorArgumentPtr = NULL;
     }
+    if (infoPtr->codeWords[0]) {
+	Tcl_DecrRefCount(infoPtr->codeWords[0]);
+	Tcl_DecrRefCount(infoPtr->codeWords[1]);
+	infoPtr->codeWords[0] = infoPtr->codeWords[1] = NULL;
+    }
 
     /* cleanup ensemble info */
     if (infoPtr->ensembleInfo) {
@@ -29,6 +29,7 @@
  * See the file "license.terms" for information on usage and redistribution
  * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
  */
+#include <stdlib.h>
 #include "itclInt.h"
 
 static char initHullCmdsScript[] =
@@ -97,6 +98,8 @@ static Tcl_ObjCmdProc Itcl_BiSetupComponentCmd;
 static Tcl_ObjCmdProc Itcl_BiKeepComponentOptionCmd;
 static Tcl_ObjCmdProc Itcl_BiIgnoreComponentOptionCmd;
 static Tcl_ObjCmdProc Itcl_BiInitOptionsCmd;
+static Tcl_ObjCmdProc Itcl_BiSetOptionsCmd;
+static Tcl_ObjCmdProc Itcl_BiAddToItclOptionsCmd;
 
 /*
  *  FORWARD DECLARATIONS
@@ -105,6 +108,20 @@ static Tcl_Obj* ItclReportPublicOpt(Tcl_Interp *interp,
     ItclVariable *ivPtr, ItclObject *contextIoPtr);
 
 static Tcl_ObjCmdProc ItclBiClassUnknownCmd;
+static int HullConfigureOption(Tcl_Interp *interp, ItclObject *ioPtr,
+    Tcl_Obj *optPtr, Tcl_Obj *valuePtr);
+static int HullReportOptions(Tcl_Interp *interp, ItclObject *ioPtr);
+
+/*
+ *  Option/value pairs collected by ItclExtendedConfigure() for a single
+ *  component, forwarded as "<component> configure ?-option value ...?".
+ */
+typedef struct ItclConfigureGroup {
+    ItclComponent *icPtr;    /* component the options are delegated to */
+    int objc;                /* number of words used in objv */
+    Tcl_Obj **objv;          /* slots for component and "configure",
+                              * followed by the option/value pairs */
+} ItclConfigureGroup;
 /*
  *  Standard list of built-in methods for all objects.
  */
@@ -351,6 +368,16 @@ Itcl_BiInit(
     Tcl_CreateObjCommand(interp, "::itcl::builtin::classunknown",
             ItclBiClassUnknownCmd, infoPtr, NULL);
 
+    /*
+     *  Used by library/itclHullCmds.tcl, not imported into classes.
+     */
+    Tcl_CreateObjCommand(interp,
+            ITCL_NAMESPACE"::internal::commands::setoptions",
+            Itcl_BiSetOptionsCmd, infoPtr, NULL);
+    Tcl_CreateObjCommand(interp,
+            ITCL_NAMESPACE"::internal::commands::addtoitcloptions",
+            Itcl_BiAddToItclOptionsCmd, infoPtr, NULL);
+
     ItclInfoInit(interp, infoPtr);
     /*
      *  Export all commands in the built-in namespace so we can
@@ -590,6 +617,9 @@ Itcl_BiConfigureCmd(
     ItclVariable *ivPtr;
     ItclVarLookup *vlookup;
     ItclMemberCode *mcode;
+    Tcl_Var varPtr;
+    Tcl_Obj *varNamePtr;
+    Tcl_Obj *valuePtr;
     ItclHierIter hier;
     ItclObjectInfo *infoPtr;
     const char *lastval;
@@ -690,23 +720,15 @@ Itcl_BiConfigureCmd(
                 return TCL_ERROR;
             }
 
-            vlookup = NULL;
-            hPtr = ItclResolveVarEntry(contextIclsPtr, token+1);
-            if (hPtr) {
-                vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
-
-                if (vlookup->ivPtr->protection != ITCL_PUBLIC) {
-                    vlookup = NULL;
-                }
-            }
-            if (!vlookup) {
+            ivPtr = ItclFindPublicVar(contextIclsPtr, unparsedObjv[1]);
+            if (!ivPtr) {
                 Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
                     "unknown option \"", token, "\"",
                     NULL);
                 return TCL_ERROR;
             }
             resultPtr = ItclReportPublicOpt(interp,
-	            vlookup->ivPtr, contextIoPtr);
+	            ivPtr, contextIoPtr);
             Tcl_SetObjResult(interp, resultPtr);
             return TCL_OK;
         }
@@ -729,19 +751,26 @@ Itcl_BiConfigureCmd(
 	    result = TCL_ERROR;
             goto configureDone;
 	}
-        vlookup = NULL;
+        /*
+         *  The options are resolved through the configOptions table
+         *  of the class, so that each one is parsed only once.
+         */
+        ivPtr = ItclFindPublicVar(contextIclsPtr, unparsedObjv[i]);
         token = Tcl_GetString(unparsedObjv[i]);
-        if (*token == '-') {
+        if ((ivPtr == NULL) && (*token == '-')) {
             hPtr = ItclResolveVarEntry(contextIclsPtr, token+1);
             if (hPtr == NULL) {
                 hPtr = ItclResolveVarEntry(contextIclsPtr, token);
 	    }
             if (hPtr) {
                 vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
+                if (vlookup->ivPtr->protection == ITCL_PUBLIC) {
+                    ivPtr = vlookup->ivPtr;
+                }
             }
         }
 
-        if (!vlookup || (vlookup->ivPtr->protection != ITCL_PUBLIC)) {
+        if (ivPtr == NULL) {
             Tcl_AppendResult(interp, "unknown option \"", token, "\"",
                 NULL);
             result = TCL_ERROR;
@@ -754,7 +783,6 @@ Itcl_BiConfigureCmd(
             goto configureDone;
         }
 
-        ivPtr = vlookup->ivPtr;
         Tcl_DStringSetLength(&buffer2, 0);
 	if (!(ivPtr->flags & ITCL_COMMON)) {
             Tcl_DStringAppend(&buffer2,
@@ -766,13 +794,35 @@ Itcl_BiConfigureCmd(
         Tcl_DStringAppend(&buffer2,
 	        Tcl_GetString(ivPtr->namePtr), -1);
 	varName = Tcl_DStringValue(&buffer2);
-        lastval = Tcl_GetVar2(interp, varName, NULL, 0);
+
+        /*
+         *  The variable itself is known, so access it directly instead
+         *  of resolving its name namespace by namespace.  The name is
+         *  still passed on for traces and error messages.
+         */
+        varPtr = ItclGetObjectVar(contextIoPtr, ivPtr);
+        if (varPtr != NULL) {
+            varNamePtr = Tcl_NewStringObj(varName,
+                    Tcl_DStringLength(&buffer2));
+            Tcl_IncrRefCount(varNamePtr);
+            valuePtr = Itcl_GetVarValue(interp, varPtr, varNamePtr, 0);
+            lastval = (valuePtr != NULL) ? Tcl_GetString(valuePtr) : NULL;
+        } else {
+            varNamePtr = NULL;
+            lastval = Tcl_GetVar2(interp, varName, NULL, 0);
+        }
         Tcl_DStringSetLength(&buffer, 0);
         Tcl_DStringAppend(&buffer, (lastval) ? lastval : "", -1);
 
-        token = Tcl_GetString(unparsedObjv[i+1]);
-        if (Tcl_SetVar2(interp, varName, NULL, token,
-                TCL_LEAVE_ERR_MSG) == NULL) {
+        if (varNamePtr != NULL) {
+            valuePtr = Itcl_SetVarValue(interp, varPtr, varNamePtr,
+                    unparsedObjv[i+1], TCL_LEAVE_ERR_MSG);
+            Tcl_DecrRefCount(varNamePtr);
+        } else {
+            valuePtr = Tcl_SetVar2Ex(interp, varName, NULL,
+                    unparsedObjv[i+1], TCL_LEAVE_ERR_MSG);
+        }
+        if (valuePtr == NULL) {
     	    Tcl_AppendObjToErrorInfo(interp, Tcl_ObjPrintf(
     		    "\n    (error in configuration of public variable \"%s\")",
     		    Tcl_GetString(ivPtr->fullNamePtr)));
@@ -853,8 +903,7 @@ Itcl_BiCgetCmd(
     ItclClass *contextIclsPtr;
     ItclObject *contextIoPtr;
 
-    Tcl_HashEntry *hPtr;
-    ItclVarLookup *vlookup;
+    ItclVariable *ivPtr;
     const char *name;
     const char *val;
     int result;
@@ -891,13 +940,8 @@ Itcl_BiCgetCmd(
     }
     name = Tcl_GetString(objv[1]);
 
-    vlookup = NULL;
-    hPtr = ItclResolveVarEntry(contextIclsPtr, name+1);
-    if (hPtr) {
-        vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
-    }
-
-    if ((vlookup == NULL) || (vlookup->ivPtr->protection != ITCL_PUBLIC)) {
+    ivPtr = ItclFindPublicVar(contextIclsPtr, objv[1]);
+    if (ivPtr == NULL) {
         Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
             "unknown option \"", name, "\"",
             NULL);
@@ -905,8 +949,8 @@ Itcl_BiCgetCmd(
     }
 
     val = Itcl_GetInstanceVar(interp,
-            Tcl_GetString(vlookup->ivPtr->namePtr),
-            contextIoPtr, vlookup->ivPtr->iclsPtr);
+            Tcl_GetString(ivPtr->namePtr),
+            contextIoPtr, ivPtr->iclsPtr);
 
     if (val) {
         Tcl_SetObjResult(interp, Tcl_NewStringObj(val, -1));
@@ -1058,6 +1102,49 @@ ItclReportOption(
 
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  ChainToMemberFunc()
+ *
+ *  Helper for NRBiChainCmd().  Invokes the implementation "chain" found
+ *  for the executing function with the arguments of the chain command.
+ * ------------------------------------------------------------------------
+ */
+static int
+ChainToMemberFunc(
+    Tcl_Interp *interp,         /* current interpreter */
+    ItclMemberFunc *imPtr,      /* implementation to invoke */
+    ItclObject *contextIoPtr,   /* object context or NULL */
+    int objc,                   /* number of arguments to chain */
+    Tcl_Obj *const objv[])      /* arguments to chain */
+{
+    Tcl_Obj *cmdlinePtr;
+    Tcl_Obj **newobjv;
+    int my_objc;
+    int result;
+
+    /*
+     *  NOTE:  Avoid the usual "virtual" behavior of
+     *         methods by passing the full name as
+     *         the command argument.
+     */
+
+    cmdlinePtr = Itcl_CreateArgs(interp,
+	    Tcl_GetString(imPtr->fullNamePtr), objc-1, objv+1);
+
+    (void) Tcl_ListObjGetElements(NULL, cmdlinePtr,
+        &my_objc, &newobjv);
+
+    if (imPtr->flags & ITCL_CONSTRUCTOR) {
+	contextIoPtr = imPtr->iclsPtr->infoPtr->currIoPtr;
+    }
+    ItclShowArgs(1, "___chain", objc-1, newobjv+1);
+    result = Itcl_EvalMemberCode(interp, imPtr, contextIoPtr,
+	    my_objc-1, newobjv+1);
+    Tcl_DecrRefCount(cmdlinePtr);
+    return result;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BiChainCmd()
@@ -1090,15 +1177,14 @@ NRBiChainCmd(
     ItclObject *contextIoPtr;
 
     const char *cmd;
-    char *cmd1;
     const char *head;
     ItclClass *iclsPtr;
+    ItclClass *startIclsPtr;
     ItclHierIter hier;
     Tcl_HashEntry *hPtr;
     ItclMemberFunc *imPtr;
+    ItclMemberFunc *currImPtr;
     Tcl_DString buffer;
-    Tcl_Obj *cmdlinePtr;
-    Tcl_Obj **newobjv;
     Tcl_Obj * const *cObjv;
     int cObjc;
     int idx;
@@ -1141,9 +1227,38 @@ NRBiChainCmd(
     } else {
 	idx = 1;
     }
-    cmd1 = (char *)ckalloc(strlen(Tcl_GetString(cObjv[idx]))+1);
-    strcpy(cmd1, Tcl_GetString(cObjv[idx]));
-    Itcl_ParseNamespPath(cmd1, &buffer, &head, &cmd);
+    cmd = Tcl_GetString(cObjv[idx]);
+    if (strstr(cmd, "::") == NULL) {
+        Tcl_DStringInit(&buffer);
+        objPtr = cObjv[idx];
+    } else {
+        Itcl_ParseNamespPath(cmd, &buffer, &head, &cmd);
+        objPtr = Tcl_NewStringObj(cmd, -1);
+    }
+    Tcl_IncrRefCount(objPtr);
+
+    /*
+     *  The function that is executing remembers where "chain" went to
+     *  for the most-specific class it was last called for, as long as
+     *  no class definition has changed since.
+     */
+    startIclsPtr = (contextIoPtr != NULL) ? contextIoPtr->iclsPtr
+            : contextIclsPtr;
+    currImPtr = NULL;
+    hPtr = Tcl_FindHashEntry(&contextIclsPtr->functions, (char *)objPtr);
+    if (hPtr != NULL) {
+        currImPtr = (ItclMemberFunc *)Tcl_GetHashValue(hPtr);
+        if ((currImPtr->chainClassPtr == startIclsPtr)
+                && (currImPtr->chainEpoch == currImPtr->infoPtr->protoEpoch)) {
+            Tcl_DecrRefCount(objPtr);
+            Tcl_DStringFree(&buffer);
+            if (currImPtr->chainPtr == NULL) {
+                return TCL_OK;
+            }
+            return ChainToMemberFunc(interp, currImPtr->chainPtr,
+                    contextIoPtr, objc, objv);
+        }
+    }
 
     /*
      *  Look for the specified command in one of the base classes.
@@ -1172,41 +1287,26 @@ NRBiChainCmd(
      *  Now search up the class hierarchy for the next implementation.
      *  If found, execute it.  Otherwise, do nothing.
      */
-    objPtr = Tcl_NewStringObj(cmd, -1);
-    ckfree(cmd1);
-    Tcl_IncrRefCount(objPtr);
+    imPtr = NULL;
     while ((iclsPtr = Itcl_AdvanceHierIter(&hier)) != NULL) {
         hPtr = Tcl_FindHashEntry(&iclsPtr->functions, (char *)objPtr);
         if (hPtr) {
-	    int my_objc;
             imPtr = (ItclMemberFunc*)Tcl_GetHashValue(hPtr);
-
-            /*
-             *  NOTE:  Avoid the usual "virtual" behavior of
-             *         methods by passing the full name as
-             *         the command argument.
-             */
-
-            cmdlinePtr = Itcl_CreateArgs(interp,
-	            Tcl_GetString(imPtr->fullNamePtr), objc-1, objv+1);
-
-            (void) Tcl_ListObjGetElements(NULL, cmdlinePtr,
-                &my_objc, &newobjv);
-
-	    if (imPtr->flags & ITCL_CONSTRUCTOR) {
-		contextIoPtr = imPtr->iclsPtr->infoPtr->currIoPtr;
-            }
-            ItclShowArgs(1, "___chain", objc-1, newobjv+1);
-            result = Itcl_EvalMemberCode(interp, imPtr, contextIoPtr,
-	            my_objc-1, newobjv+1);
-            Tcl_DecrRefCount(cmdlinePtr);
             break;
         }
     }
     Tcl_DecrRefCount(objPtr);
-
     Tcl_DStringFree(&buffer);
     Itcl_DeleteHierIter(&hier);
+
+    if (currImPtr != NULL) {
+        currImPtr->chainPtr = imPtr;
+        currImPtr->chainClassPtr = startIclsPtr;
+        currImPtr->chainEpoch = currImPtr->infoPtr->protoEpoch;
+    }
+    if (imPtr != NULL) {
+        result = ChainToMemberFunc(interp, imPtr, contextIoPtr, objc, objv);
+    }
     return result;
 }
 /* ARGSUSED */
@@ -1647,7 +1747,8 @@ ItclUnknownGuts(
     }
     icPtr = NULL;
     if (!isItclHull) {
-        FOREACH_HASH_VALUE(icPtr, &ioPtr->objectComponents) {
+        FOREACH_HASH_VALUE(icPtr,
+                &ItclObjectTablesOf(ioPtr)->objectComponents) {
             if (icPtr->flags & ITCL_COMPONENT_INHERIT) {
 	        val = Itcl_GetInstanceVar(interp,
 	                Tcl_GetString(icPtr->namePtr), ioPtr,
@@ -1962,6 +2063,9 @@ ItclExtendedConfigure(
     ItclComponent *icPtr;
     ItclOption *ioptPtr;
     ItclObjectInfo *infoPtr;
+    ItclOption **setOptions;
+    ItclConfigureGroup *groups;
+    ItclDelegateTarget *targetPtr;
     const char *val;
     int lObjc;
     int lObjc2;
@@ -1971,6 +2075,8 @@ ItclExtendedConfigure(
     int isNew;
     int result;
     int isOneOption;
+    int numPairs;
+    int numGroups;
     (void)dummy;
 
     ItclShowArgs(1, "ItclExtendedConfigure", objc, objv);
@@ -2055,14 +2161,14 @@ ItclExtendedConfigure(
     Tcl_DecrRefCount(methodNamePtr);
     /* now do the hard work */
     if (objc == 1) {
+	if (contextIclsPtr->flags & ITCL_ECLASS) {
+            return HullReportOptions(interp, contextIoPtr);
+	}
 	Tcl_InitObjHashTable(&unique);
 	/* plain configure */
         listPtr = Tcl_NewListObj(0, NULL);
-	if (contextIclsPtr->flags & ITCL_ECLASS) {
-            result = Tcl_EvalEx(interp, "::itcl::builtin::getEclassOptions", -1, 0);
-            return result;
-	}
-	FOREACH_HASH_VALUE(ioptPtr, &contextIoPtr->objectOptions) {
+	FOREACH_HASH_VALUE(ioptPtr,
+	        &ItclObjectTablesOf(contextIoPtr)->objectOptions) {
 	    hPtr2 = Tcl_CreateHashEntry(&unique,
 	            (char *)ioptPtr->namePtr, &isNew);
 	    if (!isNew) {
@@ -2094,7 +2200,8 @@ ItclExtendedConfigure(
 	    Tcl_ListObjAppendElement(interp, listPtr, objPtr);
 	}
 	/* now check for delegated options */
-	FOREACH_HASH_VALUE(idoPtr, &contextIoPtr->objectDelegatedOptions) {
+	FOREACH_HASH_VALUE(idoPtr,
+	        &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions) {
 
             if (idoPtr->icPtr != NULL) {
                 icPtr = idoPtr->icPtr;
@@ -2212,120 +2319,130 @@ ItclExtendedConfigure(
     }
     hPtr2 = NULL;
     /* first handle delegated options */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-            objv[1]);
-    if (hPtr == NULL) {
-	Tcl_Obj *objPtr;
-	objPtr = Tcl_NewStringObj("*",1);
-	Tcl_IncrRefCount(objPtr);
-        /* check if all options are delegated */
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
-	        (char *)objPtr);
-	Tcl_DecrRefCount(objPtr);
-        if (hPtr != NULL) {
-	    /* now check the exceptions */
-            idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_FindHashEntry(&idoPtr->exceptions, (char *)objv[1]);
-	    if (hPtr2 != NULL) {
-		/* found in exceptions, so no delegation for this option */
-	        hPtr = NULL;
+    targetPtr = NULL;
+    if (objc <= 3) {
+        targetPtr = ItclFindDelegateTarget(contextIoPtr, objv[1],
+	        ITCL_DELEGATE_CONFIGURE);
+    }
+    if (targetPtr == NULL) {
+	hPtr = Tcl_FindHashEntry(
+	        &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions,
+	        (char *)objv[1]);
+	if (hPtr == NULL) {
+	    Tcl_Obj *objPtr;
+	    objPtr = Tcl_NewStringObj("*",1);
+	    Tcl_IncrRefCount(objPtr);
+	    /* check if all options are delegated */
+	    hPtr = Tcl_FindHashEntry(
+	            &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions,
+		    (char *)objPtr);
+	    Tcl_DecrRefCount(objPtr);
+	    if (hPtr != NULL) {
+		/* now check the exceptions */
+		idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+		hPtr2 = Tcl_FindHashEntry(&idoPtr->exceptions, (char *)objv[1]);
+		if (hPtr2 != NULL) {
+		    /* found in exceptions, so no delegation for this option */
+		    hPtr = NULL;
+		}
 	    }
-        }
-    }
-    componentIcPtr = NULL;
-    /* check if it is not a local option defined before delegate option "*"
-     */
-    hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
-            (char *)objv[1]);
-    if (hPtr != NULL) {
-        idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
-        icPtr = idoPtr->icPtr;
-        if (icPtr != NULL) {
-	    if (icPtr->haveKeptOptions) {
-	        hPtr3 = Tcl_FindHashEntry(&icPtr->keptOptions, (char *)objv[1]);
-                if (hPtr3 != NULL) {
-		    /* ignore if it is an object option only */
-		    ItclHierIter hier;
-		    int found;
-
-		    found = 0;
-                    Itcl_InitHierIter(&hier, contextIoPtr->iclsPtr);
-		    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-		    while (iclsPtr2 != NULL) {
-			if (Tcl_FindHashEntry(&iclsPtr2->options,
-			        (char *)objv[1]) != NULL) {
-                            found = 1;
-			    break;
+	}
+	componentIcPtr = NULL;
+	/* check if it is not a local option defined before delegate option "*"
+	 */
+	hPtr2 = Tcl_FindHashEntry(
+	        &ItclObjectTablesOf(contextIoPtr)->objectOptions,
+		(char *)objv[1]);
+	if (hPtr != NULL) {
+	    idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+	    icPtr = idoPtr->icPtr;
+	    if (icPtr != NULL) {
+		if (icPtr->haveKeptOptions) {
+		    hPtr3 = Tcl_FindHashEntry(&icPtr->keptOptions,
+		            (char *)objv[1]);
+		    if (hPtr3 != NULL) {
+			/* ignore if it is an object option only */
+			ItclHierIter hier;
+			int found;
+
+			found = 0;
+			Itcl_InitHierIter(&hier, contextIoPtr->iclsPtr);
+			iclsPtr2 = Itcl_AdvanceHierIter(&hier);
+			while (iclsPtr2 != NULL) {
+			    if (Tcl_FindHashEntry(&iclsPtr2->options,
+				    (char *)objv[1]) != NULL) {
+				found = 1;
+				break;
+			    }
+			    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
+			}
+			Itcl_DeleteHierIter(&hier);
+			if (! found) {
+			    hPtr2 = NULL;
+			    componentIcPtr = icPtr;
 			}
-                        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-		    }
-		    Itcl_DeleteHierIter(&hier);
-                    if (! found) {
-		        hPtr2 = NULL;
-                        componentIcPtr = icPtr;
 		    }
-	        }
+		}
 	    }
 	}
-    }
-    if ((objc <= 3) && (hPtr != NULL) && (hPtr2 == NULL)) {
-	/* the option is delegated */
-        idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
-	if (componentIcPtr != NULL) {
-	    icPtr = componentIcPtr;
-	} else {
-            icPtr = idoPtr->icPtr;
-	}
-        val = ItclGetInstanceVar(interp,
-	        Tcl_GetString(icPtr->namePtr),
-                NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-        if ((val != NULL) && (strlen(val) > 0)) {
-	    if (idoPtr->asPtr != NULL) {
-                icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = idoPtr;
-	    }
-	    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+2));
-	    newObjv[0] = Tcl_NewStringObj(val, -1);
-	    Tcl_IncrRefCount(newObjv[0]);
-	    newObjv[1] = Tcl_NewStringObj("configure", 9);
-	    Tcl_IncrRefCount(newObjv[1]);
-	    if (idoPtr->asPtr != NULL) {
-	        newObjv[2] = idoPtr->asPtr;
+        if ((objc <= 3) && (hPtr != NULL) && (hPtr2 == NULL)) {
+	    /* the option is delegated */
+            idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+	    if (componentIcPtr != NULL) {
+	        icPtr = componentIcPtr;
 	    } else {
-	        newObjv[2] = objv[1];
-	    }
-	    Tcl_IncrRefCount(newObjv[2]);
-	    for(i=2;i<objc;i++) {
-	        newObjv[i+1] = objv[i];
-            }
-	    objPtr = Tcl_NewStringObj(val, -1);
-	    Tcl_IncrRefCount(objPtr);
-	    oPtr = Tcl_GetObjectFromObj(interp, objPtr);
-	    if (oPtr != NULL) {
-                ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
-                        infoPtr->object_meta_type);
-	        infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
+                icPtr = idoPtr->icPtr;
 	    }
-	    Tcl_DecrRefCount(objPtr);
-            ItclShowArgs(1, "extended eval delegated option", objc + 1,
-	            newObjv);
-            result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
-	    Tcl_DecrRefCount(newObjv[2]);
-            Tcl_DecrRefCount(newObjv[1]);
-            Tcl_DecrRefCount(newObjv[0]);
-            ckfree((char *)newObjv);
-            icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = NULL;
-	    if (oPtr != NULL) {
-	        infoPtr->currContextIclsPtr = NULL;
+            val = ItclGetInstanceVar(interp,
+	            Tcl_GetString(icPtr->namePtr),
+                    NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
+            if ((val == NULL) || (strlen(val) == 0)) {
+	        Tcl_AppendResult(interp, "INTERNAL ERROR component \"",
+	                Tcl_GetString(icPtr->namePtr), "\" not found",
+	                " or not set in ItclExtendedConfigure delegated option",
+		        NULL);
+	        return TCL_ERROR;
 	    }
-            return result;
-        } else {
-	    Tcl_AppendResult(interp, "INTERNAL ERROR component \"",
-	            Tcl_GetString(icPtr->namePtr), "\" not found",
-	            " or not set in ItclExtendedConfigure delegated option",
-		    NULL);
-	    return TCL_ERROR;
+	    targetPtr = ItclCacheDelegateTarget(contextIoPtr, objv[1], idoPtr,
+	            icPtr, val, ITCL_DELEGATE_CONFIGURE);
 	}
     }
+    if (targetPtr != NULL) {
+	/* the option is delegated */
+        idoPtr = targetPtr->idoPtr;
+	icPtr = targetPtr->icPtr;
+	if (idoPtr->asPtr != NULL) {
+            icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = idoPtr;
+	}
+	newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+2));
+	newObjv[0] = targetPtr->componentPtr;
+	Tcl_IncrRefCount(newObjv[0]);
+	newObjv[1] = Tcl_NewStringObj("configure", 9);
+	Tcl_IncrRefCount(newObjv[1]);
+	newObjv[2] = targetPtr->optionPtr;
+	Tcl_IncrRefCount(newObjv[2]);
+	for(i=2;i<objc;i++) {
+	    newObjv[i+1] = objv[i];
+        }
+	oPtr = Tcl_GetObjectFromObj(interp, newObjv[0]);
+	if (oPtr != NULL) {
+            ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+                    infoPtr->object_meta_type);
+	    infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
+	}
+        ItclShowArgs(1, "extended eval delegated option", objc + 1,
+	        newObjv);
+        result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
+	Tcl_DecrRefCount(newObjv[2]);
+        Tcl_DecrRefCount(newObjv[1]);
+        Tcl_DecrRefCount(newObjv[0]);
+        ckfree((char *)newObjv);
+        icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = NULL;
+	if (oPtr != NULL) {
+	    infoPtr->currContextIclsPtr = NULL;
+	}
+        return result;
+    }
 
     if (objc == 2) {
 	saveIdoPtr = infoPtr->currIdoPtr;
@@ -2334,29 +2451,18 @@ ItclExtendedConfigure(
             hPtr2 = Tcl_FindHashEntry(&contextIclsPtr->options,
 	            (char *) objv[1]);
             if (hPtr2 == NULL) {
-                hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+                hPtr2 = Tcl_FindHashEntry(
+                        &ItclObjectTablesOf(contextIoPtr)->objectOptions,
 	                (char *) objv[1]);
 	    } else {
 	       infoPtr->currIdoPtr = NULL;
 	    }
 	}
         if (hPtr2 == NULL) {
-            if (contextIclsPtr->flags & ITCL_ECLASS) {
-		newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * (objc));
-                newObjv[0] = Tcl_NewStringObj("::itcl::builtin::eclassConfigure", -1);
-		Tcl_IncrRefCount(newObjv[0]);
-		for (j = 1; j < objc; j++) {
-                    newObjv[j] = objv[j];
-		    Tcl_IncrRefCount(newObjv[j]);
-		}
-                result = Tcl_EvalObjv(interp, objc, newObjv, TCL_EVAL_DIRECT);
-		for (j = 0; j < objc; j++) {
-		    Tcl_DecrRefCount(newObjv[j]);
-		}
-                ckfree((char *)newObjv);
-		if (result == TCL_OK) {
-                  return TCL_OK;
-                }
+            if ((contextIclsPtr->flags & ITCL_ECLASS) &&
+                    (HullConfigureOption(interp, contextIoPtr, objv[1],
+                    NULL) == TCL_OK)) {
+                return TCL_OK;
 	    }
 	    /* no option at all, let the normal configure do the job */
 	    infoPtr->currIdoPtr = saveIdoPtr;
@@ -2368,86 +2474,80 @@ ItclExtendedConfigure(
 	Tcl_SetObjResult(interp, resultPtr);
 	return TCL_OK;
     }
+    if ((objc - 1) % 2 != 0) {
+	Tcl_AppendResult(interp, "need option value pair", NULL);
+	return TCL_ERROR;
+    }
     result = TCL_OK;
-    /* set one or more options */
+    /*
+     *  Set one or more options.  This is done in two passes: the first
+     *  one looks up every option and runs the read-only checks and
+     *  -validatemethods, the second one applies the values.  Options
+     *  delegated to the same component are collected and forwarded with
+     *  a single "configure" call on that component.
+     */
+    numPairs = (objc - 1) / 2;
+    setOptions = (ItclOption **)ckalloc(sizeof(ItclOption *) * numPairs);
+    groups = (ItclConfigureGroup *)ckalloc(
+            sizeof(ItclConfigureGroup) * numPairs);
+    numGroups = 0;
     for (i=1; i < objc; i+=2) {
-	if (i+1 >= objc) {
-	    Tcl_AppendResult(interp, "need option value pair", NULL);
-	    result = TCL_ERROR;
-	    break;
-	}
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+	setOptions[i/2] = NULL;
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(contextIoPtr)->objectOptions,
 	        (char *) objv[i]);
         if (hPtr == NULL) {
-            if (contextIclsPtr->flags & ITCL_ECLASS) {
-		newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * (objc));
-                newObjv[0] = Tcl_NewStringObj("::itcl::builtin::eclassConfigure", -1);
-		Tcl_IncrRefCount(newObjv[0]);
-		for (j = 1; j < objc; j++) {
-                    newObjv[j] = objv[j];
-		    Tcl_IncrRefCount(newObjv[j]);
-		}
-                result = Tcl_EvalObjv(interp, objc, newObjv, TCL_EVAL_DIRECT);
-		for (j = 0; j < objc; j++) {
-		    Tcl_DecrRefCount(newObjv[j]);
+            if ((contextIclsPtr->flags & ITCL_ECLASS) &&
+                    (HullConfigureOption(interp, contextIoPtr, objv[i],
+                    objv[i+1]) == TCL_OK)) {
+                continue;
+	    }
+            targetPtr = ItclFindDelegateTarget(contextIoPtr, objv[i],
+	            ITCL_DELEGATE_CONFIGURE_SET);
+	    if (targetPtr == NULL) {
+                hPtr = Tcl_FindHashEntry(
+                        &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions,
+	                (char *) objv[i]);
+                if (hPtr != NULL) {
+                    idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+                    icPtr = idoPtr->icPtr;
+                    val = ItclGetInstanceVar(interp,
+	                    Tcl_GetString(icPtr->ivPtr->namePtr),
+                            NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
+                    if ((val == NULL) || (strlen(val) == 0)) {
+	                Tcl_AppendResult(interp, "INTERNAL ERROR component ",
+			        "not found or not set in ItclExtendedConfigure ",
+			        "delegated option", NULL);
+		        result = TCL_ERROR;
+		        goto configureDone;
+	            }
+		    targetPtr = ItclCacheDelegateTarget(contextIoPtr, objv[i],
+		            idoPtr, icPtr, val, ITCL_DELEGATE_CONFIGURE_SET);
 		}
-                ckfree((char *)newObjv);
-		if (result == TCL_OK) {
-                  continue;
-                }
 	    }
-            hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
-	            (char *) objv[i]);
-            if (hPtr != NULL) {
+            if (targetPtr != NULL) {
 	        /* the option is delegated */
-                idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
-                icPtr = idoPtr->icPtr;
-                val = ItclGetInstanceVar(interp,
-	                Tcl_GetString(icPtr->ivPtr->namePtr),
-                        NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-                if ((val != NULL) && (strlen(val) > 0)) {
-	            if (idoPtr->asPtr != NULL) {
-                        icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = idoPtr;
-	            }
-	            newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+2));
-	            newObjv[0] = Tcl_NewStringObj(val, -1);
-	            Tcl_IncrRefCount(newObjv[0]);
-	            newObjv[1] = Tcl_NewStringObj("configure", 9);
-	            Tcl_IncrRefCount(newObjv[1]);
-	            if (idoPtr->asPtr != NULL) {
-	                newObjv[2] = idoPtr->asPtr;
-	            } else {
-	                newObjv[2] = objv[i];
-	            }
-	            Tcl_IncrRefCount(newObjv[2]);
-	            newObjv[3] = objv[i+1];
-	            objPtr = Tcl_NewStringObj(val, -1);
-	            Tcl_IncrRefCount(objPtr);
-	            oPtr = Tcl_GetObjectFromObj(interp, objPtr);
-	            if (oPtr != NULL) {
-                        ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
-                                infoPtr->object_meta_type);
-	                infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
-	            }
-	            Tcl_DecrRefCount(objPtr);
-                    ItclShowArgs(1, "extended eval delegated option", 4,
-		            newObjv);
-                    result = Tcl_EvalObjv(interp, 4, newObjv, TCL_EVAL_DIRECT);
-	            Tcl_DecrRefCount(newObjv[2]);
-                    Tcl_DecrRefCount(newObjv[1]);
-                    Tcl_DecrRefCount(newObjv[0]);
-                    ckfree((char *)newObjv);
-                    icPtr->ivPtr->iclsPtr->infoPtr->currIdoPtr = NULL;
-	            if (oPtr != NULL) {
-	                infoPtr->currContextIclsPtr = NULL;
-	            }
-                    continue;
-                } else {
-	            Tcl_AppendResult(interp, "INTERNAL ERROR component not ",
-		            "found or not set in ItclExtendedConfigure ",
-			    "delegated option", NULL);
-	            return TCL_ERROR;
-	        }
+                idoPtr = targetPtr->idoPtr;
+                icPtr = targetPtr->icPtr;
+		for (j = 0; j < numGroups; j++) {
+		    if (groups[j].icPtr == icPtr) {
+		        break;
+		    }
+		}
+		if (j == numGroups) {
+		    groups[j].icPtr = icPtr;
+		    groups[j].objv = (Tcl_Obj **)ckalloc(
+		            sizeof(Tcl_Obj *) * (objc + 1));
+		    groups[j].objc = 2;
+		    numGroups++;
+		}
+		if (idoPtr->asPtr != NULL) {
+		    groups[j].objv[groups[j].objc++] = idoPtr->asPtr;
+		} else {
+		    groups[j].objv[groups[j].objc++] = objv[i];
+		}
+		groups[j].objv[groups[j].objc++] = objv[i+1];
+                continue;
 	    }
 	}
         if (hPtr == NULL) {
@@ -2480,7 +2580,8 @@ ItclExtendedConfigure(
 	        Tcl_AppendResult(interp, "option \"",
 	                Tcl_GetString(ioptPtr->namePtr),
 		        "\" can only be set at instance creation", NULL);
-	        return TCL_ERROR;
+	        result = TCL_ERROR;
+		goto configureDone;
 	    }
 	}
         if (ioptPtr->validateMethodPtr != NULL) {
@@ -2497,9 +2598,19 @@ ItclExtendedConfigure(
 	    infoPtr->inOptionHandling = 0;
             ckfree((char *)newObjv);
 	    if (result != TCL_OK) {
-	        break;
+	        goto configureDone;
 	    }
 	}
+	setOptions[i/2] = ioptPtr;
+    }
+    result = TCL_OK;
+
+    /* now apply the local options in the order they were given */
+    for (i=1; i < objc; i+=2) {
+	ioptPtr = setOptions[i/2];
+	if (ioptPtr == NULL) {
+	    continue;
+	}
 	configureMethodPtr = NULL;
 	evalNsPtr = NULL;
 	if (ioptPtr->configureMethodPtr != NULL) {
@@ -2516,7 +2627,8 @@ ItclExtendedConfigure(
 		        " configuremethodvar \"",
 			Tcl_GetString(ioptPtr->configureMethodVarPtr),
 			"\"", NULL);
-		return TCL_ERROR;
+		result = TCL_ERROR;
+		goto configureDone;
 	    }
 	    objPtr = Tcl_NewStringObj(val, -1);
 	    hPtr = Tcl_FindHashEntry(&contextIoPtr->iclsPtr->resolveCmds,
@@ -2531,7 +2643,8 @@ ItclExtendedConfigure(
 	    } else {
 		Tcl_AppendResult(interp, "cannot find method \"",
 		        val, "\" found in configuremethodvar", NULL);
-		return TCL_ERROR;
+		result = TCL_ERROR;
+		goto configureDone;
 	    }
 	    configureMethodPtr = Tcl_NewStringObj(val, -1);
 	    Tcl_IncrRefCount(configureMethodPtr);
@@ -2555,19 +2668,64 @@ ItclExtendedConfigure(
 	    Itcl_SetCallFrameNamespace(interp, saveNsPtr);
 	    Tcl_DecrRefCount(configureMethodPtr);
 	    if (result != TCL_OK) {
-	        break;
+	        goto configureDone;
 	    }
 	} else {
 	    if (ItclSetInstanceVar(interp, "itcl_options",
 	            Tcl_GetString(objv[i]), Tcl_GetString(objv[i+1]),
 		    contextIoPtr, ioptPtr->iclsPtr) == NULL) {
 		result = TCL_ERROR;
-	        break;
+	        goto configureDone;
 	    }
 	}
 	Tcl_ResetResult(interp);
-        result = TCL_OK;
     }
+
+    /* and forward the delegated options, one call per component */
+    for (j = 0; j < numGroups; j++) {
+	icPtr = groups[j].icPtr;
+        val = ItclGetInstanceVar(interp,
+	        Tcl_GetString(icPtr->ivPtr->namePtr),
+                NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
+        if ((val == NULL) || (strlen(val) == 0)) {
+	    Tcl_AppendResult(interp, "INTERNAL ERROR component not ",
+		    "found or not set in ItclExtendedConfigure ",
+		    "delegated option", NULL);
+	    result = TCL_ERROR;
+	    goto configureDone;
+	}
+	newObjv = groups[j].objv;
+	newObjv[0] = Tcl_NewStringObj(val, -1);
+	Tcl_IncrRefCount(newObjv[0]);
+	newObjv[1] = Tcl_NewStringObj("configure", 9);
+	Tcl_IncrRefCount(newObjv[1]);
+	oPtr = Tcl_GetObjectFromObj(interp, newObjv[0]);
+	if (oPtr != NULL) {
+            ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+                    infoPtr->object_meta_type);
+	    infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
+	}
+        ItclShowArgs(1, "extended eval delegated options", groups[j].objc,
+	        newObjv);
+        result = Tcl_EvalObjv(interp, groups[j].objc, newObjv,
+	        TCL_EVAL_DIRECT);
+        Tcl_DecrRefCount(newObjv[1]);
+        Tcl_DecrRefCount(newObjv[0]);
+	if (oPtr != NULL) {
+	    infoPtr->currContextIclsPtr = NULL;
+	}
+	if (result != TCL_OK) {
+	    goto configureDone;
+	}
+	Tcl_ResetResult(interp);
+    }
+
+configureDone:
+    for (j = 0; j < numGroups; j++) {
+	ckfree((char *)groups[j].objv);
+    }
+    ckfree((char *)groups);
+    ckfree((char *)setOptions);
     if (infoPtr->unparsedObjc > 0) {
 	if (result == TCL_OK) {
             return TCL_CONTINUE;
@@ -2575,7 +2733,7 @@ ItclExtendedConfigure(
     }
     return result;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  ItclExtendedCget()
@@ -2616,6 +2774,7 @@ ItclExtendedCget(
     ItclObjectInfo *infoPtr;
     ItclOption *ioptPtr;
     ItclObject *ioPtr;
+    ItclDelegateTarget *targetPtr;
     const char *val;
     int i;
     int result;
@@ -2698,82 +2857,77 @@ ItclExtendedCget(
     }
     /* now do the hard work */
     /* first handle delegated options */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-            objv[1]);
-    hPtr3 = Tcl_FindHashEntry(&contextIoPtr->objectOptions, (char *)
-            objv[1]);
+    targetPtr = ItclFindDelegateTarget(contextIoPtr, objv[1],
+            ITCL_DELEGATE_CGET);
     hPtr2 = NULL;
-    if (hPtr == NULL) {
-	objPtr2 = Tcl_NewStringObj("*", -1);
-        /* check for "*" option delegated */
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-                objPtr2);
-	Tcl_DecrRefCount(objPtr2);
-        hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions, (char *)
+    hPtr3 = NULL;
+    if (targetPtr == NULL) {
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions,
+	        (char *)objv[1]);
+        hPtr3 = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(contextIoPtr)->objectOptions, (char *)
                 objv[1]);
-    }
-    if ((hPtr != NULL) && (hPtr2 == NULL) && (hPtr3 == NULL)) {
-	/* the option is delegated */
-        idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
-	/* if the option is in the exceptions, do nothing */
-        hPtr = Tcl_FindHashEntry(&idoPtr->exceptions, (char *)
-                objv[1]);
-	if (hPtr) {
-	    return TCL_CONTINUE;
-	}
-        icPtr = idoPtr->icPtr;
-	if (icPtr->ivPtr->flags & ITCL_COMMON) {
-            val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-                    NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-	} else {
+        if (hPtr == NULL) {
+	    objPtr2 = Tcl_NewStringObj("*", -1);
+            /* check for "*" option delegated */
+            hPtr = Tcl_FindHashEntry(
+                    &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions,
+	            (char *)objPtr2);
+	    Tcl_DecrRefCount(objPtr2);
+            hPtr2 = Tcl_FindHashEntry(
+                    &ItclObjectTablesOf(contextIoPtr)->objectOptions, (char *)
+                    objv[1]);
+        }
+        if ((hPtr != NULL) && (hPtr2 == NULL) && (hPtr3 == NULL)) {
+	    /* the option is delegated */
+            idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+	    /* if the option is in the exceptions, do nothing */
+            hPtr = Tcl_FindHashEntry(&idoPtr->exceptions, (char *)
+                    objv[1]);
+	    if (hPtr) {
+	        return TCL_CONTINUE;
+	    }
+            icPtr = idoPtr->icPtr;
             val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
                     NULL, contextIoPtr, icPtr->ivPtr->iclsPtr);
-	}
-        if ((val != NULL) && (strlen(val) > 0)) {
-	    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+1));
-	    newObjv[0] = Tcl_NewStringObj(val, -1);
-	    Tcl_IncrRefCount(newObjv[0]);
-	    newObjv[1] = Tcl_NewStringObj("cget", 4);
-	    Tcl_IncrRefCount(newObjv[1]);
-	    for(i=1;i<objc;i++) {
-		if (strcmp(Tcl_GetString(idoPtr->namePtr),
-		        Tcl_GetString(objv[i])) == 0) {
-		    if (idoPtr->asPtr != NULL) {
-		        newObjv[i+1] = idoPtr->asPtr;
-		    } else {
-	                newObjv[i+1] = objv[i];
-		    }
-		} else {
-	            newObjv[i+1] = objv[i];
-	        }
-	    }
-	    objPtr = Tcl_NewStringObj(val, -1);
-	    Tcl_IncrRefCount(objPtr);
-	    oPtr = Tcl_GetObjectFromObj(interp, objPtr);
-	    if (oPtr != NULL) {
-                ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
-                        infoPtr->object_meta_type);
-	        infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
-	    }
-	    ItclShowArgs(1, "ExtendedCget delegated option", objc+1, newObjv);
-            result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
-	    Tcl_DecrRefCount(newObjv[0]);
-	    Tcl_DecrRefCount(newObjv[1]);
-	    Tcl_DecrRefCount(objPtr);
-	    if (oPtr != NULL) {
-	        infoPtr->currContextIclsPtr = NULL;
+            if ((val == NULL) || (strlen(val) == 0)) {
+	        Tcl_ResetResult(interp);
+	        Tcl_AppendResult(interp, "component \"",
+	                Tcl_GetString(icPtr->namePtr),
+	                "\" is undefined, needed for option \"",
+		        Tcl_GetString(objv[1]),
+	                "\"", NULL);
+	        return TCL_ERROR;
 	    }
-	    ckfree((char *)newObjv);
-            return result;
-        } else {
-	    Tcl_ResetResult(interp);
-	    Tcl_AppendResult(interp, "component \"",
-	            Tcl_GetString(icPtr->namePtr),
-	            "\" is undefined, needed for option \"",
-		    Tcl_GetString(objv[1]),
-	            "\"", NULL);
-	    return TCL_ERROR;
+	    targetPtr = ItclCacheDelegateTarget(contextIoPtr, objv[1], idoPtr,
+	            icPtr, val, ITCL_DELEGATE_CGET);
+	}
+    }
+    if (targetPtr != NULL) {
+	newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+1));
+	newObjv[0] = targetPtr->componentPtr;
+	Tcl_IncrRefCount(newObjv[0]);
+	newObjv[1] = Tcl_NewStringObj("cget", 4);
+	Tcl_IncrRefCount(newObjv[1]);
+	newObjv[2] = targetPtr->optionPtr;
+	Tcl_IncrRefCount(newObjv[2]);
+	oPtr = Tcl_GetObjectFromObj(interp, newObjv[0]);
+	if (oPtr != NULL) {
+            ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+                    infoPtr->object_meta_type);
+	    infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
+	}
+	ItclShowArgs(1, "ExtendedCget delegated option", objc+1, newObjv);
+        result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
+	Tcl_DecrRefCount(newObjv[0]);
+	Tcl_DecrRefCount(newObjv[1]);
+	Tcl_DecrRefCount(newObjv[2]);
+	if (oPtr != NULL) {
+	    infoPtr->currContextIclsPtr = NULL;
 	}
+	ckfree((char *)newObjv);
+        return result;
     }
 
     /* now look if it is an option at all */
@@ -2889,7 +3043,8 @@ ItclExtendedSetGet(
         return TCL_ERROR;
     }
     /* look if it is an methodvariable at all */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectMethodVariables,
+    hPtr = Tcl_FindHashEntry(
+            &ItclObjectTablesOf(contextIoPtr)->objectMethodVariables,
             (char *) objv[1]);
     if (hPtr == NULL) {
 	Tcl_AppendResult(interp, "no such methodvariable \"",
@@ -3013,7 +3168,8 @@ Itcl_BiInstallComponentCmd(
     hPtr = Tcl_FindHashEntry(&contextIclsPtr->components, (char *)objv[1]);
     if (hPtr == NULL) {
 	numOpts = 0;
-	FOREACH_HASH_VALUE(idoPtr, &contextIoPtr->objectDelegatedOptions) {
+	FOREACH_HASH_VALUE(idoPtr,
+	        &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions) {
             if (idoPtr == NULL) {
                 /* FIXME need code here !! */
 	    }
@@ -3583,16 +3739,733 @@ Itcl_BiItclHullCmd(
 
 /*
  * ------------------------------------------------------------------------
- *  Itcl_BiCreateHullCmd()
- *
- *  Invoked by Tcl normally during evaluating constructor
- *  the "createhull" command is invoked to install and setup an
- *  ::itcl::extendedclass itcl_hull
- *  for an object.  Handles the following syntax:
+ *  Hull and option initialization of ::itcl::extendedclass objects
+ *
+ *  createhull, setupcomponent, itcl_initoptions and the option helpers
+ *  of library/itclHullCmds.tcl work directly on the option tables of
+ *  the object.  The value of every option is recorded in the
+ *  "itcl_options" array of the object together with its resource name,
+ *  class name and default value in the "__itcl_option_infos" array of
+ *  the variable namespace of the object, which is where configure and
+ *  cget find the component options.
+ * ------------------------------------------------------------------------
+ */
+
+/*
+ *  State of one run of recording options for an object.  The words of
+ *  the "::option get" resource database lookup are built once and only
+ *  the resource and class name are replaced for each option.
+ */
+typedef struct HullOptionInit {
+    ItclObject *ioPtr;          /* object the options are recorded for */
+    Tcl_Obj *infosNamePtr;      /* full name of its __itcl_option_infos */
+    Tcl_Obj *rdbObjv[5];        /* "::option get <win> <resource> <class>",
+                                 * rdbObjv[2] is NULL for no lookups */
+    int argc;                   /* explicit option/value pairs */
+    Tcl_Obj *const *argv;
+    Tcl_HashTable rdbCache;     /* results of the database lookups, keyed
+                                 * by the list {resource class} */
+} HullOptionInit;
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullCmdsInit()
+ *
+ *  Sources library/itclHullCmds.tcl (which loads Tk) the first time
+ *  one of the hull commands is used in an interpreter.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullCmdsInit(
+    Tcl_Interp *interp,
+    ItclObjectInfo *infoPtr)
+{
+    if (!infoPtr->itclHullCmdsInitted) {
+        if (Tcl_EvalEx(interp, initHullCmdsScript, -1, 0) != TCL_OK) {
+            return TCL_ERROR;
+        }
+        infoPtr->itclHullCmdsInitted = 1;
+    }
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullEvalObjv()
+ *
+ *  Like Tcl_EvalObjv(), but also takes words without references, which
+ *  are freed afterwards.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullEvalObjv(
+    Tcl_Interp *interp,
+    int objc,
+    Tcl_Obj *objv[],
+    int flags)
+{
+    int result;
+    int i;
+
+    for (i = 0; i < objc; i++) {
+        Tcl_IncrRefCount(objv[i]);
+    }
+    result = Tcl_EvalObjv(interp, objc, objv, flags);
+    for (i = 0; i < objc; i++) {
+        Tcl_DecrRefCount(objv[i]);
+    }
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullCheckOptions()
+ *
+ *  Checks the ?-option value ...? arguments of a hull command.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullCheckOptions(
+    Tcl_Interp *interp,
+    int objc,
+    Tcl_Obj *const objv[],
+    int needPairs)              /* 1 if a value must follow each option */
+{
+    int i;
+
+    for (i = 0; i < objc; i += 2) {
+        if (Tcl_GetString(objv[i])[0] != '-') {
+            Tcl_AppendResult(interp, "bad option name \"",
+                    Tcl_GetString(objv[i]),
+                    "\" options must start with a \"-\"", NULL);
+            return TCL_ERROR;
+        }
+    }
+    if (needPairs && (objc % 2 != 0)) {
+        Tcl_AppendResult(interp, "value for \"",
+                Tcl_GetString(objv[objc-1]), "\" missing", NULL);
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullTail()
+ *
+ *  Returns the part of a command name after the last "::".
+ * ------------------------------------------------------------------------
+ */
+static const char *
+HullTail(
+    const char *name)
+{
+    const char *tail;
+    const char *p;
+
+    tail = name;
+    for (p = name; *p != '\0'; p++) {
+        if ((p[0] == ':') && (p[1] == ':')) {
+            tail = p + 2;
+        }
+    }
+    return tail;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullCompareNames()
+ *
+ *  qsort() callback, options are recorded in the order of their names.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullCompareNames(
+    const void *a,
+    const void *b)
+{
+    return strcmp(Tcl_GetString(*(Tcl_Obj *const *)a),
+            Tcl_GetString(*(Tcl_Obj *const *)b));
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullOptionInfosName()
+ *
+ *  Returns the full name of the __itcl_option_infos array of an object.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj *
+HullOptionInfosName(
+    ItclObject *ioPtr)
+{
+    Tcl_Obj *namePtr;
+
+    namePtr = Tcl_DuplicateObj(ioPtr->varNsNamePtr);
+    Tcl_AppendToObj(namePtr, "::__itcl_option_infos", -1);
+    return namePtr;
+}
+
+static void
+HullOptionInitStart(
+    HullOptionInit *initPtr,
+    ItclObject *ioPtr,
+    Tcl_Obj *winPtr,            /* window for resource lookups or NULL */
+    int argc,
+    Tcl_Obj *const argv[])
+{
+    int i;
+
+    initPtr->ioPtr = ioPtr;
+    initPtr->infosNamePtr = HullOptionInfosName(ioPtr);
+    Tcl_IncrRefCount(initPtr->infosNamePtr);
+    initPtr->rdbObjv[0] = Tcl_NewStringObj("::option", -1);
+    initPtr->rdbObjv[1] = Tcl_NewStringObj("get", -1);
+    initPtr->rdbObjv[2] = winPtr;
+    initPtr->rdbObjv[3] = NULL;
+    initPtr->rdbObjv[4] = NULL;
+    for (i = 0; i < 3; i++) {
+        if (initPtr->rdbObjv[i] != NULL) {
+            Tcl_IncrRefCount(initPtr->rdbObjv[i]);
+        }
+    }
+    initPtr->argc = argc;
+    initPtr->argv = argv;
+    Tcl_InitObjHashTable(&initPtr->rdbCache);
+}
+
+static void
+HullOptionInitDone(
+    HullOptionInit *initPtr)
+{
+    FOREACH_HASH_DECLS;
+    Tcl_Obj *valuePtr;
+    int i;
+
+    FOREACH_HASH_VALUE(valuePtr, &initPtr->rdbCache) {
+        Tcl_DecrRefCount(valuePtr);
+    }
+    Tcl_DeleteHashTable(&initPtr->rdbCache);
+    Tcl_DecrRefCount(initPtr->infosNamePtr);
+    for (i = 0; i < 3; i++) {
+        if (initPtr->rdbObjv[i] != NULL) {
+            Tcl_DecrRefCount(initPtr->rdbObjv[i]);
+        }
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullOptionValue()
+ *
+ *  Determines the initial value of an option: the explicitly given
+ *  value, else the value in the option database for the window, else
+ *  the default value.  Errors of the database lookup are ignored unless
+ *  rdbErrors is set.  The value is returned with a reference in
+ *  *valuePtrPtr.
+ *
+ *  Tk has no way to look up many resources at once, so instead each
+ *  resource and class is looked up only once per run: synonyms and
+ *  options kept for several components share the result.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullOptionValue(
+    Tcl_Interp *interp,
+    HullOptionInit *initPtr,
+    Tcl_Obj *optPtr,
+    Tcl_Obj *resourcePtr,
+    Tcl_Obj *classPtr,
+    Tcl_Obj *defaultPtr,
+    int rdbErrors,
+    Tcl_Obj **valuePtrPtr)
+{
+    Tcl_Obj *valuePtr;
+    const char *opt;
+    int result;
+    int i;
+
+    opt = Tcl_GetString(optPtr);
+    for (i = (initPtr->argc & ~1) - 2; i >= 0; i -= 2) {
+        if (strcmp(Tcl_GetString(initPtr->argv[i]), opt) == 0) {
+            *valuePtrPtr = initPtr->argv[i+1];
+            Tcl_IncrRefCount(*valuePtrPtr);
+            return TCL_OK;
+        }
+    }
+    valuePtr = NULL;
+    if ((initPtr->rdbObjv[2] != NULL) && (resourcePtr != NULL) &&
+            (classPtr != NULL)) {
+        Tcl_HashEntry *hPtr;
+        Tcl_Obj *keyPtr;
+        int isNew;
+
+        keyPtr = Tcl_NewListObj(0, NULL);
+        Tcl_ListObjAppendElement(NULL, keyPtr, resourcePtr);
+        Tcl_ListObjAppendElement(NULL, keyPtr, classPtr);
+        Tcl_IncrRefCount(keyPtr);
+        hPtr = Tcl_FindHashEntry(&initPtr->rdbCache, (char *)keyPtr);
+        if (hPtr != NULL) {
+            valuePtr = (Tcl_Obj *)Tcl_GetHashValue(hPtr);
+        } else {
+            initPtr->rdbObjv[3] = resourcePtr;
+            initPtr->rdbObjv[4] = classPtr;
+            result = Tcl_EvalObjv(interp, 5, initPtr->rdbObjv,
+                    TCL_EVAL_GLOBAL);
+            initPtr->rdbObjv[3] = NULL;
+            initPtr->rdbObjv[4] = NULL;
+            if (result == TCL_OK) {
+                valuePtr = Tcl_GetObjResult(interp);
+                Tcl_IncrRefCount(valuePtr);
+                hPtr = Tcl_CreateHashEntry(&initPtr->rdbCache,
+                        (char *)keyPtr, &isNew);
+                Tcl_SetHashValue(hPtr, valuePtr);
+            } else if (rdbErrors) {
+                Tcl_DecrRefCount(keyPtr);
+                return TCL_ERROR;
+            }
+        }
+        Tcl_DecrRefCount(keyPtr);
+        if ((valuePtr != NULL) && (Tcl_GetCharLength(valuePtr) == 0)) {
+            valuePtr = NULL;
+        }
+    }
+    if (valuePtr == NULL) {
+        valuePtr = defaultPtr;
+    }
+    if (valuePtr == NULL) {
+        valuePtr = Tcl_NewObj();
+    }
+    Tcl_IncrRefCount(valuePtr);
+    Tcl_ResetResult(interp);
+    *valuePtrPtr = valuePtr;
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullOptionRecord()
+ *
+ *  Sets itcl_options(<option>) of the object and records the resource
+ *  name, class name and default value of the option.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullOptionRecord(
+    Tcl_Interp *interp,
+    HullOptionInit *initPtr,
+    Tcl_Obj *optPtr,
+    Tcl_Obj *valuePtr,
+    Tcl_Obj *resourcePtr,
+    Tcl_Obj *classPtr,
+    Tcl_Obj *defaultPtr)
+{
+    Tcl_Obj *infoPtr;
+    ItclObject *ioPtr;
+
+    ioPtr = initPtr->ioPtr;
+    if (ItclSetInstanceVar(interp, "itcl_options", Tcl_GetString(optPtr),
+            Tcl_GetString(valuePtr), ioPtr, ioPtr->iclsPtr) == NULL) {
+        Tcl_ResetResult(interp);
+        Tcl_AppendResult(interp, "cannot set option \"",
+                Tcl_GetString(optPtr), "\" of object \"",
+                Tcl_GetString(ioPtr->namePtr), "\"", NULL);
+        return TCL_ERROR;
+    }
+    infoPtr = Tcl_NewListObj(0, NULL);
+    Tcl_ListObjAppendElement(NULL, infoPtr,
+            (resourcePtr != NULL) ? resourcePtr : Tcl_NewObj());
+    Tcl_ListObjAppendElement(NULL, infoPtr,
+            (classPtr != NULL) ? classPtr : Tcl_NewObj());
+    Tcl_ListObjAppendElement(NULL, infoPtr,
+            (defaultPtr != NULL) ? defaultPtr : Tcl_NewObj());
+    if (Tcl_ObjSetVar2(interp, initPtr->infosNamePtr, optPtr, infoPtr,
+            TCL_LEAVE_ERR_MSG) == NULL) {
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullFindClassOption()
+ *
+ *  Looks for an option in a class and its base classes.
+ * ------------------------------------------------------------------------
+ */
+static ItclOption *
+HullFindClassOption(
+    ItclClass *iclsPtr,
+    Tcl_Obj *optPtr)
+{
+    Tcl_HashEntry *hPtr;
+    ItclHierIter hier;
+    ItclClass *iclsPtr2;
+
+    hPtr = NULL;
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+        hPtr = Tcl_FindHashEntry(&iclsPtr2->options, (char *)optPtr);
+        if (hPtr != NULL) {
+            break;
+        }
+    }
+    Itcl_DeleteHierIter(&hier);
+    if (hPtr == NULL) {
+        return NULL;
+    }
+    return (ItclOption *)Tcl_GetHashValue(hPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullAddToItclOptions()
+ *
+ *  Records the options of a component widget for an object.  widgetType
+ *  is the command the component was created with.  For an [incr Tcl]
+ *  class the resource names, class names and default values come from
+ *  the option definitions of the class, for other widget types from a
+ *  single "configure" call on the component (pathPtr) or, if there is
+ *  none, on a temporary widget of that type.  optionsPtr lists the
+ *  options to record, NULL records all options of the component.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullAddToItclOptions(
+    Tcl_Interp *interp,
+    HullOptionInit *initPtr,
+    Tcl_Obj *widgetTypePtr,
+    Tcl_Obj *pathPtr,
+    Tcl_Obj *optionsPtr)
+{
+    FOREACH_HASH_DECLS;
+    Tcl_HashTable specs;
+    Tcl_Obj *cmdObjv[3];
+    Tcl_Obj *specListPtr;
+    Tcl_Obj *tmpPathPtr;
+    Tcl_Obj *valuePtr;
+    Tcl_Obj *optPtr;
+    Tcl_Obj **names;
+    Tcl_Obj **specObjv;
+    Tcl_Obj **elemObjv;
+    Tcl_Obj *specPtr;
+    ItclClass *iclsPtr;
+    ItclOption *ioptPtr;
+    ItclHierIter hier;
+    ItclClass *iclsPtr2;
+    int numNames;
+    int numSpecs;
+    int numElems;
+    int isNew;
+    int result;
+    int i;
+    int j;
+
+    result = TCL_OK;
+    specListPtr = NULL;
+    tmpPathPtr = NULL;
+    Tcl_InitObjHashTable(&specs);
+    iclsPtr = Itcl_FindClass(interp, Tcl_GetString(widgetTypePtr),
+            /* no autoload */ 0);
+    if (iclsPtr == NULL) {
+        if (pathPtr == NULL) {
+            tmpPathPtr = Tcl_NewStringObj(".___xx", -1);
+            Tcl_IncrRefCount(tmpPathPtr);
+            cmdObjv[0] = widgetTypePtr;
+            cmdObjv[1] = tmpPathPtr;
+            if (HullEvalObjv(interp, 2, cmdObjv, TCL_EVAL_GLOBAL) != TCL_OK) {
+                result = TCL_ERROR;
+                goto done;
+            }
+            pathPtr = tmpPathPtr;
+        }
+        cmdObjv[0] = pathPtr;
+        cmdObjv[1] = Tcl_NewStringObj("configure", -1);
+        result = HullEvalObjv(interp, 2, cmdObjv, 0);
+        if (result == TCL_OK) {
+            specListPtr = Tcl_GetObjResult(interp);
+            Tcl_IncrRefCount(specListPtr);
+            result = Tcl_ListObjGetElements(interp, specListPtr,
+                    &numSpecs, &specObjv);
+        }
+        if (tmpPathPtr != NULL) {
+            cmdObjv[0] = Tcl_NewStringObj("::destroy", -1);
+            cmdObjv[1] = tmpPathPtr;
+            if (result == TCL_OK) {
+                result = HullEvalObjv(interp, 2, cmdObjv, TCL_EVAL_GLOBAL);
+            } else {
+                Itcl_InterpState istate = Itcl_SaveInterpState(interp, 0);
+                HullEvalObjv(interp, 2, cmdObjv, TCL_EVAL_GLOBAL);
+                Itcl_RestoreInterpState(interp, istate);
+            }
+        }
+        if (result != TCL_OK) {
+            goto done;
+        }
+        Tcl_ResetResult(interp);
+        for (i = 0; i < numSpecs; i++) {
+            if ((Tcl_ListObjGetElements(interp, specObjv[i],
+                    &numElems, &elemObjv) != TCL_OK) || (numElems < 1)) {
+                continue;
+            }
+            hPtr = Tcl_CreateHashEntry(&specs, (char *)elemObjv[0], &isNew);
+            if (isNew) {
+                Tcl_SetHashValue(hPtr, specObjv[i]);
+            }
+        }
+    }
+
+    /*
+     *  The names of the options to record, sorted and without duplicates.
+     */
+    if (optionsPtr != NULL) {
+        if (Tcl_ListObjGetElements(interp, optionsPtr, &numElems,
+                &elemObjv) != TCL_OK) {
+            result = TCL_ERROR;
+            goto done;
+        }
+        names = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * (numElems + 1));
+        memcpy(names, elemObjv, sizeof(Tcl_Obj *) * numElems);
+        numNames = numElems;
+    } else if (iclsPtr != NULL) {
+        numNames = 0;
+        Itcl_InitHierIter(&hier, iclsPtr);
+        while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+            numNames += iclsPtr2->options.numEntries;
+        }
+        Itcl_DeleteHierIter(&hier);
+        names = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * (numNames + 1));
+        numNames = 0;
+        Itcl_InitHierIter(&hier, iclsPtr);
+        while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+            FOREACH_HASH_VALUE(ioptPtr, &iclsPtr2->options) {
+                names[numNames++] = ioptPtr->namePtr;
+            }
+        }
+        Itcl_DeleteHierIter(&hier);
+    } else {
+        names = (Tcl_Obj **)ckalloc(
+                sizeof(Tcl_Obj *) * (specs.numEntries + 1));
+        numNames = 0;
+        FOREACH_HASH(optPtr, specPtr, &specs) {
+            names[numNames++] = optPtr;
+        }
+    }
+    qsort(names, numNames, sizeof(Tcl_Obj *), HullCompareNames);
+
+    for (i = 0; i < numNames; i++) {
+        Tcl_Obj *resourcePtr;
+        Tcl_Obj *classPtr;
+        Tcl_Obj *defaultPtr;
+
+        optPtr = names[i];
+        if ((i > 0) && (strcmp(Tcl_GetString(optPtr),
+                Tcl_GetString(names[i-1])) == 0)) {
+            continue;
+        }
+        if (iclsPtr != NULL) {
+            ioptPtr = HullFindClassOption(iclsPtr, optPtr);
+            if (ioptPtr == NULL) {
+                continue;
+            }
+            resourcePtr = ioptPtr->resourceNamePtr;
+            classPtr = ioptPtr->classNamePtr;
+            defaultPtr = ioptPtr->defaultValuePtr;
+        } else {
+            /* a synonym like -bg reports the option it stands for */
+            specPtr = NULL;
+            for (j = 0; j < 2; j++) {
+                hPtr = Tcl_FindHashEntry(&specs,
+                        (char *)((j == 0) ? optPtr : specPtr));
+                if (hPtr == NULL) {
+                    specPtr = NULL;
+                    break;
+                }
+                specPtr = (Tcl_Obj *)Tcl_GetHashValue(hPtr);
+                Tcl_ListObjGetElements(NULL, specPtr, &numElems, &elemObjv);
+                if (numElems != 2) {
+                    break;
+                }
+                specPtr = elemObjv[1];
+            }
+            if ((specPtr == NULL) || (numElems < 4)) {
+                continue;
+            }
+            resourcePtr = elemObjv[1];
+            classPtr = elemObjv[2];
+            defaultPtr = elemObjv[3];
+        }
+        if (HullOptionValue(interp, initPtr, optPtr, resourcePtr, classPtr,
+                defaultPtr, /* rdbErrors */ 0, &valuePtr) != TCL_OK) {
+            result = TCL_ERROR;
+            break;
+        }
+        result = HullOptionRecord(interp, initPtr, optPtr, valuePtr,
+                resourcePtr, classPtr, defaultPtr);
+        Tcl_DecrRefCount(valuePtr);
+        if (result != TCL_OK) {
+            break;
+        }
+    }
+    ckfree((char *)names);
+done:
+    if (specListPtr != NULL) {
+        Tcl_DecrRefCount(specListPtr);
+    }
+    if (tmpPathPtr != NULL) {
+        Tcl_DecrRefCount(tmpPathPtr);
+    }
+    Tcl_DeleteHashTable(&specs);
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullDeletedTrace()
+ *
+ *  Invoked when the hull widget of an object is deleted, for example
+ *  ::itcl::internal::widgets::hull1.lw.  Deletes the object .lw too.
+ * ------------------------------------------------------------------------
+ */
+static void
+HullDeletedTrace(
+    ClientData clientData,
+    Tcl_Interp *interp,
+    const char *oldName,
+    const char *newName,
+    int flags)
+{
+    Itcl_InterpState istate;
+    const char *objName;
+    (void)clientData;
+    (void)newName;
+
+    if (flags & TCL_INTERP_DESTROYED) {
+        return;
+    }
+    objName = strchr(HullTail(oldName), '.');
+    if ((objName == NULL) ||
+            (Tcl_FindCommand(interp, objName, NULL, TCL_GLOBAL_ONLY) == NULL)) {
+        return;
+    }
+    istate = Itcl_SaveInterpState(interp, 0);
+    Itcl_RenameCommand(interp, objName, "");
+    Itcl_RestoreInterpState(interp, istate);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullConfigureOption()
+ *
+ *  Handles "configure -option ?value?" of an ::itcl::extendedclass object
+ *  for the component options recorded by setupcomponent.  Returns
+ *  TCL_ERROR without a message if optPtr is not one of them.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullConfigureOption(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    Tcl_Obj *optPtr,
+    Tcl_Obj *valuePtr)          /* new value or NULL to report the option */
+{
+    Tcl_Obj *infosNamePtr;
+    Tcl_Obj *infoPtr;
+    Tcl_Obj *resultPtr;
+    const char *val;
+
+    infosNamePtr = HullOptionInfosName(ioPtr);
+    Tcl_IncrRefCount(infosNamePtr);
+    infoPtr = Tcl_ObjGetVar2(interp, infosNamePtr, optPtr, 0);
+    Tcl_DecrRefCount(infosNamePtr);
+    if (infoPtr == NULL) {
+        return TCL_ERROR;
+    }
+    if (valuePtr != NULL) {
+        if (ItclSetInstanceVar(interp, "itcl_options", Tcl_GetString(optPtr),
+                Tcl_GetString(valuePtr), ioPtr, ioPtr->iclsPtr) == NULL) {
+            return TCL_ERROR;
+        }
+        Tcl_ResetResult(interp);
+        return TCL_OK;
+    }
+    val = ItclGetInstanceVar(interp, "itcl_options", Tcl_GetString(optPtr),
+            ioPtr, ioPtr->iclsPtr);
+    if (val == NULL) {
+        return TCL_ERROR;
+    }
+    resultPtr = Tcl_NewListObj(1, &optPtr);
+    Tcl_ListObjAppendList(NULL, resultPtr, infoPtr);
+    Tcl_ListObjAppendElement(NULL, resultPtr, Tcl_NewStringObj(val, -1));
+    Tcl_SetObjResult(interp, resultPtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HullReportOptions()
+ *
+ *  Handles plain "configure" of an ::itcl::extendedclass object, which
+ *  reports the component options recorded by setupcomponent.
+ * ------------------------------------------------------------------------
+ */
+static int
+HullReportOptions(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr)
+{
+    Tcl_Obj *cmdObjv[3];
+    Tcl_Obj *infosPtr;
+    Tcl_Obj *listPtr;
+    Tcl_Obj *entryPtr;
+    Tcl_Obj **infosObjv;
+    const char *val;
+    int numInfos;
+    int i;
+
+    cmdObjv[0] = Tcl_NewStringObj("::array", -1);
+    cmdObjv[1] = Tcl_NewStringObj("get", -1);
+    cmdObjv[2] = HullOptionInfosName(ioPtr);
+    if (HullEvalObjv(interp, 3, cmdObjv, TCL_EVAL_GLOBAL) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    infosPtr = Tcl_GetObjResult(interp);
+    Tcl_IncrRefCount(infosPtr);
+    Tcl_ListObjGetElements(NULL, infosPtr, &numInfos, &infosObjv);
+    listPtr = Tcl_NewListObj(0, NULL);
+    for (i = 0; i + 1 < numInfos; i += 2) {
+        val = ItclGetInstanceVar(interp, "itcl_options",
+                Tcl_GetString(infosObjv[i]), ioPtr, ioPtr->iclsPtr);
+        if (val == NULL) {
+            continue;
+        }
+        entryPtr = Tcl_NewListObj(1, &infosObjv[i]);
+        Tcl_ListObjAppendList(NULL, entryPtr, infosObjv[i+1]);
+        Tcl_ListObjAppendElement(NULL, entryPtr, Tcl_NewStringObj(val, -1));
+        Tcl_ListObjAppendElement(NULL, listPtr, entryPtr);
+    }
+    Tcl_DecrRefCount(infosPtr);
+    Tcl_SetObjResult(interp, listPtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_BiCreateHullCmd()
+ *
+ *  Invoked by Tcl normally during evaluating constructor
+ *  the "createhull" command is invoked to install and setup an
+ *  ::itcl::extendedclass itcl_hull
+ *  for an object.  Handles the following syntax:
  *
  *      createhull <widget_type> <widget_path> ?-class <widgetClassName>?
  *          ?<optionName> <optionValue> <optionName> <optionValue> ...?
  *
+ *  The object command is moved aside while the widget is created with
+ *  the name of the object, then the widget is renamed to a unique name
+ *  ::itcl::internal::widgets::hull<number><widget_path>, which becomes
+ *  component itcl_hull, and itcl_interior is set to the widget path.
+ *  Deleting the hull widget deletes the object too.
  * ------------------------------------------------------------------------
  */
 static int
@@ -3602,20 +4475,215 @@ Itcl_BiCreateHullCmd(
     int objc,                /* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
 {
-    int result;
+    FOREACH_HASH_DECLS;
+    HullOptionInit init;
+    Tcl_Obj **newObjv;
+    Tcl_Obj *cmdObjv[4];
+    Tcl_Obj *thisPtr;
+    Tcl_Obj *tmpNamePtr;
+    Tcl_Obj *winPtr;
+    Tcl_Obj *widgetPtr;
+    Tcl_Obj *hullNamePtr;
+    Tcl_Obj *resourcePtr;
+    Tcl_Obj *valuePtr;
+    ItclClass *iclsPtr;
+    ItclObject *ioPtr;
+    ItclDelegatedOption *idoPtr;
     ItclObjectInfo *infoPtr = (ItclObjectInfo*)clientData;
+    const char *name;
+    int isRenamed;
+    int idx;
+    int result;
+    int i;
 
     ItclShowArgs(1, "Itcl_BiCreateHullCmd", objc, objv);
-    if (!infoPtr->itclHullCmdsInitted) {
-        result =  Tcl_EvalEx(interp, initHullCmdsScript, -1, 0);
+    if (objc < 3) {
+        Tcl_WrongNumArgs(interp, 1, objv,
+                "widgetType widgetPath ?-option value ...?");
+        return TCL_ERROR;
+    }
+    if (HullCmdsInit(interp, infoPtr) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (HullCheckOptions(interp, objc - 3, objv + 3, 0) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    iclsPtr = NULL;
+    ioPtr = NULL;
+    if ((Itcl_GetContext(interp, &iclsPtr, &ioPtr) != TCL_OK) ||
+            (ioPtr == NULL)) {
+        Tcl_ResetResult(interp);
+        Tcl_AppendResult(interp, "cannot access object-specific info ",
+                "without an object context", NULL);
+        return TCL_ERROR;
+    }
+    thisPtr = Tcl_GetVar2Ex(interp, "this", NULL, TCL_LEAVE_ERR_MSG);
+    if (thisPtr == NULL) {
+        return TCL_ERROR;
+    }
+    Tcl_IncrRefCount(thisPtr);
+    tmpNamePtr = Tcl_DuplicateObj(thisPtr);
+    Tcl_AppendToObj(tmpNamePtr, "_", -1);
+    Tcl_IncrRefCount(tmpNamePtr);
+    winPtr = Tcl_NewStringObj(HullTail(Tcl_GetString(objv[2])), -1);
+    Tcl_IncrRefCount(winPtr);
+    widgetPtr = NULL;
+    hullNamePtr = NULL;
+    isRenamed = 0;
+    if (Itcl_RenameCommand(interp, Tcl_GetString(thisPtr),
+            Tcl_GetString(tmpNamePtr)) != TCL_OK) {
+        result = TCL_ERROR;
+        goto done;
+    }
+    isRenamed = 1;
+
+    /*
+     *  Create the widget with the name of the object.
+     */
+    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * (objc + 1));
+    newObjv[0] = objv[1];
+    newObjv[1] = winPtr;
+    for (i = 3; i < objc; i += 2) {
+        newObjv[i-1] = objv[i];
+        if (i + 1 >= objc) {
+            newObjv[i] = Tcl_NewObj();
+        } else if (strcmp(Tcl_GetString(objv[i]), "-class") == 0) {
+            newObjv[i] = Tcl_NewStringObj(
+                    HullTail(Tcl_GetString(objv[i+1])), -1);
+        } else {
+            newObjv[i] = objv[i+1];
+        }
+    }
+    result = HullEvalObjv(interp, 2 + ((objc - 2) & ~1), newObjv, 0);
+    ckfree((char *)newObjv);
+    if (result != TCL_OK) {
+        goto done;
+    }
+    widgetPtr = Tcl_GetObjResult(interp);
+    Tcl_IncrRefCount(widgetPtr);
+    Tcl_ResetResult(interp);
+    Tcl_TraceCommand(interp, Tcl_GetString(widgetPtr), TCL_TRACE_DELETE,
+            HullDeletedTrace, NULL);
+
+    /*
+     *  Options delegated to the hull with "-as" get their value from
+     *  the option database.
+     */
+    HullOptionInitStart(&init, ioPtr, winPtr, 0, NULL);
+    FOREACH_HASH_VALUE(idoPtr, &ioPtr->iclsPtr->delegatedOptions) {
+        if ((idoPtr->icPtr == NULL) || (idoPtr->asPtr == NULL) ||
+                (strcmp(Tcl_GetString(idoPtr->icPtr->namePtr),
+                "itcl_hull") != 0)) {
+            continue;
+        }
+        name = Tcl_GetString(idoPtr->asPtr);
+        if (*name == '-') {
+            name++;
+        }
+        resourcePtr = Tcl_NewStringObj(name, -1);
+        Tcl_IncrRefCount(resourcePtr);
+        cmdObjv[0] = Tcl_NewStringObj("*", -1);
+        Tcl_IncrRefCount(cmdObjv[0]);
+        result = HullOptionValue(interp, &init, idoPtr->asPtr, resourcePtr,
+                cmdObjv[0], NULL, /* rdbErrors */ 1, &valuePtr);
+        Tcl_DecrRefCount(cmdObjv[0]);
+        if (result == TCL_OK) {
+            if (Tcl_GetCharLength(valuePtr) > 0) {
+                cmdObjv[0] = winPtr;
+                cmdObjv[1] = Tcl_NewStringObj("configure", -1);
+                cmdObjv[2] = Tcl_NewStringObj("-", -1);
+                Tcl_AppendObjToObj(cmdObjv[2], resourcePtr);
+                cmdObjv[3] = valuePtr;
+                result = HullEvalObjv(interp, 4, cmdObjv, 0);
+            }
+            Tcl_DecrRefCount(valuePtr);
+        }
+        Tcl_DecrRefCount(resourcePtr);
         if (result != TCL_OK) {
-            return result;
+            break;
+        }
+    }
+    HullOptionInitDone(&init);
+    if (result != TCL_OK) {
+        goto done;
+    }
+
+    /*
+     *  Give the widget its unique name and the object its name back.
+     */
+    for (idx = 1; ; idx++) {
+        hullNamePtr = Tcl_ObjPrintf(ITCL_NAMESPACE"::internal::widgets::hull%d%s",
+                idx, Tcl_GetString(winPtr));
+        if (Tcl_FindCommand(interp, Tcl_GetString(hullNamePtr), NULL, 0)
+                == NULL) {
+            break;
+        }
+        Tcl_DecrRefCount(hullNamePtr);
+    }
+    Tcl_IncrRefCount(hullNamePtr);
+    if (Itcl_RenameCommand(interp, Tcl_GetString(widgetPtr),
+            Tcl_GetString(hullNamePtr)) != TCL_OK) {
+        result = TCL_ERROR;
+        goto done;
+    }
+    isRenamed = 0;
+    if (Itcl_RenameCommand(interp, Tcl_GetString(tmpNamePtr),
+            Tcl_GetString(thisPtr)) != TCL_OK) {
+        result = TCL_ERROR;
+        goto done;
+    }
+    if (Tcl_GetVar2Ex(interp, "itcl_hull", NULL, 0) == NULL) {
+        cmdObjv[0] = Tcl_NewStringObj("::itcl::addcomponent", -1);
+        cmdObjv[1] = thisPtr;
+        cmdObjv[2] = Tcl_NewStringObj("itcl_hull", -1);
+        if (HullEvalObjv(interp, 3, cmdObjv, 0) != TCL_OK) {
+            result = TCL_ERROR;
+            goto done;
+        }
+    }
+    cmdObjv[0] = Tcl_NewStringObj("::itcl::setcomponent", -1);
+    cmdObjv[1] = thisPtr;
+    cmdObjv[2] = Tcl_NewStringObj("itcl_hull", -1);
+    cmdObjv[3] = hullNamePtr;
+    if (HullEvalObjv(interp, 4, cmdObjv, 0) != TCL_OK) {
+        result = TCL_ERROR;
+        goto done;
+    }
+    if (Tcl_GetVar2Ex(interp, "itcl_interior", NULL, 0) == NULL) {
+        cmdObjv[0] = Tcl_NewStringObj("::itcl::addcomponent", -1);
+        cmdObjv[1] = thisPtr;
+        cmdObjv[2] = Tcl_NewStringObj("itcl_interior", -1);
+        if (HullEvalObjv(interp, 3, cmdObjv, 0) != TCL_OK) {
+            result = TCL_ERROR;
+            goto done;
         }
-        infoPtr->itclHullCmdsInitted = 1;
     }
-    return Tcl_EvalObjv(interp, objc, objv, 0);
+    if (Tcl_SetVar2Ex(interp, "itcl_interior", NULL, winPtr,
+            TCL_LEAVE_ERR_MSG) == NULL) {
+        result = TCL_ERROR;
+        goto done;
+    }
+    Tcl_SetObjResult(interp, winPtr);
+done:
+    if (isRenamed) {
+        /* give the object its name back */
+        Itcl_InterpState istate = Itcl_SaveInterpState(interp, result);
+        Itcl_RenameCommand(interp, Tcl_GetString(tmpNamePtr),
+                Tcl_GetString(thisPtr));
+        result = Itcl_RestoreInterpState(interp, istate);
+    }
+    if (hullNamePtr != NULL) {
+        Tcl_DecrRefCount(hullNamePtr);
+    }
+    if (widgetPtr != NULL) {
+        Tcl_DecrRefCount(widgetPtr);
+    }
+    Tcl_DecrRefCount(winPtr);
+    Tcl_DecrRefCount(tmpNamePtr);
+    Tcl_DecrRefCount(thisPtr);
+    return result;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BiSetupComponentCmd()
@@ -3628,6 +4696,9 @@ Itcl_BiCreateHullCmd(
  *      setupcomponent <componentName> using <widgetType> <widget_path>
  *          ?<optionName> <optionValue> <optionName> <optionValue> ...?
  *
+ *  The options of the new component are recorded for the object (or,
+ *  for a component of a component, for the outermost object), see
+ *  HullAddToItclOptions().
  * ------------------------------------------------------------------------
  */
 static int
@@ -3637,20 +4708,105 @@ Itcl_BiSetupComponentCmd(
     int objc,                /* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
 {
-    int result;
+    HullOptionInit init;
+    Tcl_Obj **newObjv;
+    Tcl_Obj *cmdObjv[4];
+    Tcl_Obj *thisPtr;
+    Tcl_Obj *winPtr;
+    Tcl_Obj *compPtr;
+    Tcl_Obj *compObjectPtr;
+    ItclClass *iclsPtr;
+    ItclObject *ioPtr;
+    ItclObject *compIoPtr;
     ItclObjectInfo *infoPtr = (ItclObjectInfo*)clientData;
+    int result;
+    int i;
 
     ItclShowArgs(1, "Itcl_BiSetupComponentCmd", objc, objv);
-    if (!infoPtr->itclHullCmdsInitted) {
-        result =  Tcl_EvalEx(interp, initHullCmdsScript, -1, 0);
-        if (result != TCL_OK) {
-            return result;
-        }
-        infoPtr->itclHullCmdsInitted = 1;
+    if (objc < 5) {
+        Tcl_WrongNumArgs(interp, 1, objv,
+                "componentName using widgetType widgetPath ?-option value ...?");
+        return TCL_ERROR;
+    }
+    if (HullCmdsInit(interp, infoPtr) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (HullCheckOptions(interp, objc - 5, objv + 5, 1) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    iclsPtr = NULL;
+    ioPtr = NULL;
+    if ((Itcl_GetContext(interp, &iclsPtr, &ioPtr) != TCL_OK) ||
+            (ioPtr == NULL)) {
+        Tcl_ResetResult(interp);
+        Tcl_AppendResult(interp, "cannot access object-specific info ",
+                "without an object context", NULL);
+        return TCL_ERROR;
+    }
+    thisPtr = Tcl_GetVar2Ex(interp, "this", NULL, TCL_LEAVE_ERR_MSG);
+    if (thisPtr == NULL) {
+        return TCL_ERROR;
+    }
+    Tcl_IncrRefCount(thisPtr);
+    winPtr = Tcl_GetVar2Ex(interp, "win", NULL, TCL_LEAVE_ERR_MSG);
+    if (winPtr == NULL) {
+        Tcl_DecrRefCount(thisPtr);
+        return TCL_ERROR;
+    }
+    Tcl_IncrRefCount(winPtr);
+
+    /*
+     *  The options of components of components belong to the object
+     *  that created the first component.
+     */
+    compObjectPtr = Tcl_GetVar2Ex(interp,
+            ITCL_NAMESPACE"::internal::component_objects",
+            Tcl_GetString(ioPtr->namePtr), TCL_GLOBAL_ONLY);
+    if (compObjectPtr == NULL) {
+        compObjectPtr = ioPtr->namePtr;
+        Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::component_objects",
+                Tcl_GetString(objv[4]), compObjectPtr, TCL_GLOBAL_ONLY);
+    }
+    compIoPtr = NULL;
+    if ((Itcl_FindObject(interp, Tcl_GetString(compObjectPtr), &compIoPtr)
+            != TCL_OK) || (compIoPtr == NULL)) {
+        Tcl_ResetResult(interp);
+        compIoPtr = ioPtr;
     }
-    return Tcl_EvalObjv(interp, objc, objv, 0);
+    Itcl_PreserveData(compIoPtr);
+
+    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * (objc - 3));
+    newObjv[0] = objv[3];
+    for (i = 4; i < objc; i++) {
+        newObjv[i-3] = objv[i];
+    }
+    result = HullEvalObjv(interp, objc - 3, newObjv, TCL_EVAL_GLOBAL);
+    ckfree((char *)newObjv);
+    if (result != TCL_OK) {
+        goto done;
+    }
+    compPtr = Tcl_GetObjResult(interp);
+    Tcl_IncrRefCount(compPtr);
+    Tcl_ResetResult(interp);
+    cmdObjv[0] = Tcl_NewStringObj("::itcl::setcomponent", -1);
+    cmdObjv[1] = thisPtr;
+    cmdObjv[2] = objv[1];
+    cmdObjv[3] = compPtr;
+    result = HullEvalObjv(interp, 4, cmdObjv, 0);
+    if (result == TCL_OK) {
+        Tcl_ResetResult(interp);
+        HullOptionInitStart(&init, compIoPtr, winPtr, objc - 5, objv + 5);
+        result = HullAddToItclOptions(interp, &init, objv[3], compPtr, NULL);
+        HullOptionInitDone(&init);
+    }
+    Tcl_DecrRefCount(compPtr);
+done:
+    Itcl_ReleaseData(compIoPtr);
+    Tcl_DecrRefCount(winPtr);
+    Tcl_DecrRefCount(thisPtr);
+    return result;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BiInitOptionsCmd()
@@ -3662,8 +4818,12 @@ Itcl_BiSetupComponentCmd(
  *
  *      itcl_initoptions
  *          ?<optionName> <optionValue> <optionName> <optionValue> ...?
- * FIXME !!!! seems no longer been used !!!
  *
+ *  Every option of the class and every option kept for one of its
+ *  components (see keepcomponentoption) gets the given value, else the
+ *  one from the option database, else its default value.  The options
+ *  of the class are then configured on the object, kept options on the
+ *  components.
  * ------------------------------------------------------------------------
  */
 static int
@@ -3673,38 +4833,415 @@ Itcl_BiInitOptionsCmd(
     int objc,                /* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
 {
-    int result;
-    ItclObjectInfo *infoPtr = (ItclObjectInfo*)clientData;
+    FOREACH_HASH_DECLS;
+    HullOptionInit init;
+    Tcl_DictSearch search2;
+    Tcl_Obj *cmdObjv[4];
+    Tcl_Obj *winPtr;
+    Tcl_Obj *dictPtr;
+    Tcl_Obj *compsPtr;
+    Tcl_Obj *compInfoPtr;
+    Tcl_Obj *compNamePtr;
+    Tcl_Obj *keptPtr;
+    Tcl_Obj *keyPtr;
+    Tcl_Obj *valuePtr;
+    Tcl_Obj *optPtr;
+    Tcl_Obj *compValuePtr;
+    Tcl_Obj *listPtr;
+    Tcl_Obj *specPtr;
+    Tcl_Obj **names;
+    Tcl_Obj **comps;
+    Tcl_Obj **kept;
+    Tcl_Obj **elemObjv;
     ItclClass *iclsPtr;
     ItclObject *ioPtr;
-    ItclDelegatedOption *idoptPtr;
     ItclOption *ioptPtr;
-    FOREACH_HASH_DECLS;
+    ItclObjectInfo *infoPtr = (ItclObjectInfo*)clientData;
+    int numNames;
+    int numComps;
+    int numKept;
+    int numElems;
+    int found;
+    int done;
+    int result;
+    int i;
+    int j;
+    int k;
 
-    /* instead ::itcl::builtin::initoptions in ../library/itclHullCmds.tcl is used !! */
     ItclShowArgs(1, "Itcl_BiInitOptionsCmd", objc, objv);
-    if (!infoPtr->itclHullCmdsInitted) {
-        result =  Tcl_EvalEx(interp, initHullCmdsScript, -1, 0);
-        if (result != TCL_OK) {
-            return result;
+    if (HullCmdsInit(interp, infoPtr) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (HullCheckOptions(interp, objc - 1, objv + 1, 1) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    iclsPtr = NULL;
+    ioPtr = NULL;
+    if ((Itcl_GetContext(interp, &iclsPtr, &ioPtr) != TCL_OK) ||
+            (ioPtr == NULL)) {
+        Tcl_ResetResult(interp);
+        Tcl_AppendResult(interp, "cannot access object-specific info ",
+                "without an object context", NULL);
+        return TCL_ERROR;
+    }
+    winPtr = Tcl_GetVar2Ex(interp, "win", NULL, TCL_LEAVE_ERR_MSG);
+    if (winPtr == NULL) {
+        return TCL_ERROR;
+    }
+    Tcl_IncrRefCount(winPtr);
+    Itcl_PreserveData(ioPtr);
+
+    /*
+     *  The components of the class with the options kept for them, from
+     *  ::itcl::internal::dicts::classComponents.
+     */
+    numComps = 0;
+    comps = NULL;
+    dictPtr = Tcl_GetVar2Ex(interp,
+            ITCL_NAMESPACE"::internal::dicts::classComponents", NULL,
+            TCL_GLOBAL_ONLY);
+    compsPtr = NULL;
+    if ((dictPtr == NULL) || (Tcl_DictObjGet(NULL, dictPtr,
+            iclsPtr->fullNamePtr, &compsPtr) != TCL_OK)) {
+        compsPtr = NULL;
+    }
+    if (compsPtr != NULL) {
+        Tcl_IncrRefCount(compsPtr);
+        if (Tcl_DictObjSize(NULL, compsPtr, &numElems) != TCL_OK) {
+            numElems = 0;
         }
-        infoPtr->itclHullCmdsInitted = 1;
+        comps = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * 2 * (numElems + 1));
+        keyPtr = Tcl_NewStringObj("-keptoptions", -1);
+        Tcl_IncrRefCount(keyPtr);
+        if (Tcl_DictObjFirst(NULL, compsPtr, &search2, &compNamePtr,
+                &compInfoPtr, &done) != TCL_OK) {
+            done = 1;
+        }
+        for (; !done; Tcl_DictObjNext(&search2, &compNamePtr,
+                &compInfoPtr, &done)) {
+            if ((Tcl_DictObjGet(NULL, compInfoPtr, keyPtr, &keptPtr)
+                    == TCL_OK) && (keptPtr != NULL)) {
+                comps[2*numComps] = compNamePtr;
+                comps[2*numComps+1] = keptPtr;
+                numComps++;
+            }
+        }
+        Tcl_DictObjDone(&search2);
+        Tcl_DecrRefCount(keyPtr);
+    }
+
+    /*
+     *  The names of the options, sorted and without duplicates.
+     */
+    numNames = iclsPtr->options.numEntries;
+    for (j = 0; j < numComps; j++) {
+        Tcl_ListObjLength(NULL, comps[2*j+1], &numKept);
+        numNames += numKept;
+    }
+    names = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) * (numNames + 1));
+    numNames = 0;
+    FOREACH_HASH_VALUE(ioptPtr, &iclsPtr->options) {
+        names[numNames++] = ioptPtr->namePtr;
+    }
+    for (j = 0; j < numComps; j++) {
+        Tcl_ListObjGetElements(NULL, comps[2*j+1], &numKept, &kept);
+        for (k = 0; k < numKept; k++) {
+            names[numNames++] = kept[k];
+        }
+    }
+    qsort(names, numNames, sizeof(Tcl_Obj *), HullCompareNames);
+
+    result = TCL_OK;
+    HullOptionInitStart(&init, ioPtr, winPtr, objc - 1, objv + 1);
+    for (i = 0; (i < numNames) && (result == TCL_OK); i++) {
+        optPtr = names[i];
+        if ((i > 0) && (strcmp(Tcl_GetString(optPtr),
+                Tcl_GetString(names[i-1])) == 0)) {
+            continue;
+        }
+        valuePtr = NULL;
+        found = 0;
+        hPtr = Tcl_FindHashEntry(&ItclObjectTablesOf(ioPtr)->objectOptions,
+                (char *)optPtr);
+        if (hPtr != NULL) {
+            ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr);
+            found = 1;
+            result = HullOptionValue(interp, &init, optPtr,
+                    ioptPtr->resourceNamePtr, ioptPtr->classNamePtr,
+                    ioptPtr->defaultValuePtr, /* rdbErrors */ 0, &valuePtr);
+            if (result == TCL_OK) {
+                result = HullOptionRecord(interp, &init, optPtr, valuePtr,
+                        ioptPtr->resourceNamePtr, ioptPtr->classNamePtr,
+                        ioptPtr->defaultValuePtr);
+            }
+            if (result != TCL_OK) {
+                if (valuePtr != NULL) {
+                    Tcl_DecrRefCount(valuePtr);
+                }
+                break;
+            }
+            cmdObjv[0] = winPtr;
+            cmdObjv[1] = Tcl_NewStringObj("configure", -1);
+            cmdObjv[2] = optPtr;
+            cmdObjv[3] = valuePtr;
+            HullEvalObjv(interp, 4, cmdObjv, 0);
+            Tcl_ResetResult(interp);
+        }
+
+        /*
+         *  The first component the option is kept for determines its
+         *  value, if it is not an option of the class.
+         */
+        for (j = 0; (j < numComps) && (result == TCL_OK); j++) {
+            Tcl_ListObjGetElements(NULL, comps[2*j+1], &numKept, &kept);
+            for (k = 0; k < numKept; k++) {
+                if (strcmp(Tcl_GetString(kept[k]),
+                        Tcl_GetString(optPtr)) == 0) {
+                    break;
+                }
+            }
+            if (k >= numKept) {
+                continue;
+            }
+            result = TCL_ERROR;
+            compValuePtr = Tcl_ObjGetVar2(interp, comps[2*j], NULL,
+                    TCL_LEAVE_ERR_MSG);
+            if (compValuePtr == NULL) {
+                break;
+            }
+            Tcl_IncrRefCount(compValuePtr);
+            cmdObjv[0] = compValuePtr;
+            cmdObjv[1] = Tcl_NewStringObj("configure", -1);
+            cmdObjv[2] = optPtr;
+            if (found == 0) {
+                if (HullEvalObjv(interp, 3, cmdObjv, 0) != TCL_OK) {
+                    goto compDone;
+                }
+                specPtr = Tcl_GetObjResult(interp);
+                Tcl_IncrRefCount(specPtr);
+                if ((Tcl_ListObjGetElements(interp, specPtr, &numElems,
+                        &elemObjv) != TCL_OK) || (numElems < 4)) {
+                    Tcl_DecrRefCount(specPtr);
+                    goto compDone;
+                }
+                found = 2;
+                if ((HullOptionValue(interp, &init, optPtr, elemObjv[1],
+                        elemObjv[2], elemObjv[3], /* rdbErrors */ 1,
+                        &valuePtr) != TCL_OK) ||
+                        (HullOptionRecord(interp, &init, optPtr, valuePtr,
+                        elemObjv[1], elemObjv[2], elemObjv[3]) != TCL_OK)) {
+                    Tcl_DecrRefCount(specPtr);
+                    goto compDone;
+                }
+                Tcl_DecrRefCount(specPtr);
+                cmdObjv[1] = Tcl_NewStringObj("configure", -1);
+            }
+            cmdObjv[3] = valuePtr;
+            HullEvalObjv(interp, 4, cmdObjv, 0);
+            Tcl_ResetResult(interp);
+
+            /*
+             *  Remember the component in itcl_option_components(<option>).
+             */
+            listPtr = Tcl_GetVar2Ex(interp, "itcl_option_components",
+                    Tcl_GetString(optPtr), 0);
+            numElems = 0;
+            if (listPtr != NULL) {
+                Tcl_ListObjGetElements(NULL, listPtr, &numElems, &elemObjv);
+            }
+            for (k = 0; k < numElems; k++) {
+                if (strcmp(Tcl_GetString(elemObjv[k]),
+                        Tcl_GetString(comps[2*j])) == 0) {
+                    break;
+                }
+            }
+            if ((listPtr == NULL) || (k >= numElems)) {
+                cmdObjv[3] = Tcl_GetVar2Ex(interp, "itcl_options",
+                        Tcl_GetString(optPtr), 0);
+                if (cmdObjv[3] != NULL) {
+                    cmdObjv[0] = compValuePtr;
+                    cmdObjv[1] = Tcl_NewStringObj("configure", -1);
+                    cmdObjv[2] = optPtr;
+                    if (HullEvalObjv(interp, 4, cmdObjv, 0) != TCL_OK) {
+                        goto compDone;
+                    }
+                    Tcl_ResetResult(interp);
+                }
+                if (Tcl_SetVar2Ex(interp, "itcl_option_components",
+                        Tcl_GetString(optPtr), comps[2*j], TCL_LEAVE_ERR_MSG|
+                        TCL_APPEND_VALUE|TCL_LIST_ELEMENT) == NULL) {
+                    goto compDone;
+                }
+            }
+            result = TCL_OK;
+compDone:
+            Tcl_DecrRefCount(compValuePtr);
+        }
+        if (valuePtr != NULL) {
+            Tcl_DecrRefCount(valuePtr);
+        }
+    }
+    HullOptionInitDone(&init);
+    ckfree((char *)names);
+    if (comps != NULL) {
+        ckfree((char *)comps);
+    }
+    if (compsPtr != NULL) {
+        Tcl_DecrRefCount(compsPtr);
+    }
+    Itcl_ReleaseData(ioPtr);
+    Tcl_DecrRefCount(winPtr);
+    if (result == TCL_OK) {
+        Tcl_ResetResult(interp);
+    }
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_BiSetOptionsCmd()
+ *
+ *  Invoked by ::itcl::builtin::setoptions in library/itclHullCmds.tcl
+ *  within a method of an ::itcl::extendedclass object.  Handles the
+ *  following syntax:
+ *
+ *      setoptions ?<optionName> <optionValue> ...?
+ *
+ *  Every option of the object gets the given value or its default
+ *  value, without looking at the option database.
+ * ------------------------------------------------------------------------
+ */
+static int
+Itcl_BiSetOptionsCmd(
+    void *clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    FOREACH_HASH_DECLS;
+    HullOptionInit init;
+    Tcl_Obj *valuePtr;
+    Tcl_Obj **names;
+    ItclClass *iclsPtr;
+    ItclObject *ioPtr;
+    ItclOption *ioptPtr;
+    int numNames;
+    int result;
+    int i;
+    (void)clientData;
+
+    ItclShowArgs(1, "Itcl_BiSetOptionsCmd", objc, objv);
+    if (HullCheckOptions(interp, objc - 1, objv + 1, 1) != TCL_OK) {
+        return TCL_ERROR;
     }
-    result = Tcl_EvalObjv(interp, objc, objv, 0);
     iclsPtr = NULL;
-    if (Itcl_GetContext(interp, &iclsPtr, &ioPtr) != TCL_OK) {
+    ioPtr = NULL;
+    if ((Itcl_GetContext(interp, &iclsPtr, &ioPtr) != TCL_OK) ||
+            (ioPtr == NULL)) {
+        Tcl_ResetResult(interp);
+        Tcl_AppendResult(interp, "cannot access object-specific info ",
+                "without an object context", NULL);
         return TCL_ERROR;
     }
-    /* first handle delegated options */
-    FOREACH_HASH_VALUE(idoptPtr, &ioPtr->objectDelegatedOptions) {
-fprintf(stderr, "delopt!%s!\n", Tcl_GetString(idoptPtr->namePtr));
+    names = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *) *
+            (ItclObjectTablesOf(ioPtr)->objectOptions.numEntries + 1));
+    numNames = 0;
+    FOREACH_HASH_VALUE(ioptPtr, &ItclObjectTablesOf(ioPtr)->objectOptions) {
+        names[numNames++] = ioptPtr->namePtr;
     }
-    FOREACH_HASH_VALUE(ioptPtr, &ioPtr->objectOptions) {
-fprintf(stderr, "opt!%s!\n", Tcl_GetString(ioptPtr->namePtr));
+    qsort(names, numNames, sizeof(Tcl_Obj *), HullCompareNames);
+    result = TCL_OK;
+    HullOptionInitStart(&init, ioPtr, NULL, objc - 1, objv + 1);
+    for (i = 0; i < numNames; i++) {
+        hPtr = Tcl_FindHashEntry(&ItclObjectTablesOf(ioPtr)->objectOptions,
+                (char *)names[i]);
+        ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr);
+        result = HullOptionValue(interp, &init, names[i], NULL, NULL,
+                ioptPtr->defaultValuePtr, /* rdbErrors */ 0, &valuePtr);
+        if (result != TCL_OK) {
+            break;
+        }
+        result = HullOptionRecord(interp, &init, names[i], valuePtr,
+                ioptPtr->resourceNamePtr, ioptPtr->classNamePtr,
+                ioptPtr->defaultValuePtr);
+        Tcl_DecrRefCount(valuePtr);
+        if (result != TCL_OK) {
+            break;
+        }
     }
+    HullOptionInitDone(&init);
+    ckfree((char *)names);
     return result;
 }
-
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_BiAddToItclOptionsCmd()
+ *
+ *  Invoked by ::itcl::builtin::addToItclOptions in
+ *  library/itclHullCmds.tcl (used by keepcomponentoption).  Handles the
+ *  following syntax:
+ *
+ *      addtoitcloptions <widgetType> <objectName> <optionList> <argsDict>
+ *
+ *  Records the options in optionList of widgets of type widgetType for
+ *  the object, see HullAddToItclOptions().
+ * ------------------------------------------------------------------------
+ */
+static int
+Itcl_BiAddToItclOptionsCmd(
+    void *clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    HullOptionInit init;
+    Tcl_Obj **argv;
+    Tcl_Obj *winPtr;
+    ItclObject *ioPtr;
+    const char *win;
+    int argc;
+    int result;
+    (void)clientData;
+
+    ItclShowArgs(1, "Itcl_BiAddToItclOptionsCmd", objc, objv);
+    if (objc != 5) {
+        Tcl_WrongNumArgs(interp, 1, objv,
+                "widgetType objectName optionList argsDict");
+        return TCL_ERROR;
+    }
+    ioPtr = NULL;
+    if (Itcl_FindObject(interp, Tcl_GetString(objv[2]), &ioPtr) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (ioPtr == NULL) {
+        Tcl_AppendResult(interp, "object \"", Tcl_GetString(objv[2]),
+                "\" not found", NULL);
+        return TCL_ERROR;
+    }
+    if (Tcl_ListObjGetElements(interp, objv[4], &argc, &argv) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    win = ItclGetInstanceVar(interp, "win", NULL, ioPtr, ioPtr->iclsPtr);
+    if (win == NULL) {
+        win = HullTail(Tcl_GetString(ioPtr->namePtr));
+    }
+    winPtr = Tcl_NewStringObj(win, -1);
+    Tcl_IncrRefCount(winPtr);
+    Tcl_IncrRefCount(objv[4]);
+    Itcl_PreserveData(ioPtr);
+    HullOptionInitStart(&init, ioPtr, winPtr, argc, argv);
+    result = HullAddToItclOptions(interp, &init, objv[1], NULL, objv[3]);
+    HullOptionInitDone(&init);
+    Itcl_ReleaseData(ioPtr);
+    Tcl_DecrRefCount(objv[4]);
+    Tcl_DecrRefCount(winPtr);
+    if (result == TCL_OK) {
+        Tcl_ResetResult(interp);
+    }
+    return result;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BiKeepComponentOptionCmd()
@@ -3791,7 +5328,8 @@ Itcl_BiIgnoreComponentOptionCmd(
         return TCL_ERROR;
     }
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectComponents, (char *)objv[1]);
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(ioPtr)->objectComponents, (char *)objv[1]);
         if (hPtr == NULL) {
 	    Tcl_AppendResult(interp,
 	            "ignorecomponentoption cannot find component \"",
@@ -3800,13 +5338,15 @@ Itcl_BiIgnoreComponentOptionCmd(
 	}
         icPtr = (ItclComponent *)Tcl_GetHashValue(hPtr);
 	icPtr->haveKeptOptions = 1;
+	ItclResetDelegateTargets(ioPtr);
 	for (idx = 2; idx < objc; idx++) {
 	    hPtr = Tcl_CreateHashEntry(&icPtr->keptOptions, (char *)objv[idx],
 	            &isNew);
             if (isNew) {
 	        Tcl_SetHashValue(hPtr, objv[idx]);
 	    }
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+	    hPtr2 = Tcl_CreateHashEntry(
+	            &ItclCreateObjectTables(ioPtr)->objectDelegatedOptions,
 	            (char *)objv[idx], &isNew);
 	    if (isNew) {
 		idoPtr = (ItclDelegatedOption *)ckalloc(sizeof(
@@ -34,6 +34,8 @@
 
 static Tcl_NamespaceDeleteProc* _TclOONamespaceDeleteProc = NULL;
 static void ItclDeleteOption(char *cdata);
+static int AddVirtualCmd(ItclClass *iclsPtr, Tcl_Obj *namePtr,
+        ItclMemberFunc *imPtr);
 
 /*
  *  FORWARD DECLARATIONS
@@ -285,6 +287,10 @@ Itcl_CreateClass(
     Tcl_InitObjHashTable(&iclsPtr->delegatedFunctions);
     Tcl_InitObjHashTable(&iclsPtr->methodVariables);
     Tcl_InitObjHashTable(&iclsPtr->resolveCmds);
+    Tcl_InitHashTable(&iclsPtr->resolveCmdNames, TCL_STRING_KEYS);
+    Tcl_InitHashTable(&iclsPtr->resolveCmdCache, TCL_STRING_KEYS);
+    Tcl_InitObjHashTable(&iclsPtr->configOptions);
+    Tcl_InitHashTable(&iclsPtr->qualifierClasses, TCL_STRING_KEYS);
 
     iclsPtr->numInstanceVars = 0;
     Tcl_InitHashTable(&iclsPtr->classCommons, TCL_ONE_WORD_KEYS);
@@ -411,6 +417,8 @@ Itcl_CreateClass(
     hPtr = Tcl_CreateHashEntry(&infoPtr->namespaceClasses, (char *)classNs,
             &newEntry);
     Tcl_SetHashValue(hPtr, iclsPtr);
+    /* cached access checks may refer to the namespace */
+    infoPtr->protoEpoch++;
   if (classNs != ooNs) {
     hPtr = Tcl_CreateHashEntry(&infoPtr->namespaceClasses, (char *)ooNs,
             &newEntry);
@@ -581,7 +589,6 @@ CallDeleteOneObject(
     int result)
 {
     Tcl_HashEntry *hPtr;
-    Tcl_HashSearch place;
     ItclClass *iclsPtr2 = NULL;
     ItclObject *contextIoPtr;
     ItclClass *iclsPtr = (ItclClass *)data[0];
@@ -601,34 +608,38 @@ CallDeleteOneObject(
         return result;
     }
     /*
-     * Fix 227804: Whenever an object to delete was found we
-     * have to reset the search to the beginning as the
-     * current entry in the search was deleted and accessing it
-     * is therefore not allowed anymore.
+     * Deleting an object takes it out of the instance list of its
+     * class, so the next one to delete is always the first one.
      */
 
-    hPtr = Tcl_FirstHashEntry(&infoPtr->objects, &place);
-    if (hPtr) {
-        contextIoPtr = (ItclObject*)Tcl_GetHashValue(hPtr);
+    contextIoPtr = iclsPtr->firstInstancePtr;
 
-        while (contextIoPtr->iclsPtr != iclsPtr) {
-            hPtr = Tcl_NextHashEntry(&place);
-            if (hPtr == NULL) {
-                break;
-            }
+    /*
+     * Objects that run no destructor are deleted right here, without
+     * going through the callback machinery once per object.  Variable
+     * traces may still run scripts, so make sure the class survives
+     * each of them.
+     */
+    while ((contextIoPtr != NULL) && !ItclObjectHasDestructors(contextIoPtr)) {
+        if (Itcl_DeleteObject(interp, contextIoPtr) != TCL_OK) {
+            iclsPtr2 = iclsPtr;
+            goto deleteClassFail;
         }
-        if (hPtr) {
-	    callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
-            if (Itcl_DeleteObject(interp, contextIoPtr) != TCL_OK) {
-                iclsPtr2 = iclsPtr;
-                goto deleteClassFail;
-            }
-
-            Tcl_NRAddCallback(interp, CallDeleteOneObject, iclsPtr,
-	            infoPtr, NULL, NULL);
-            return Itcl_NRRunCallbacks(interp, callbackPtr);
+        if (Tcl_FindHashEntry(&infoPtr->classes, (char *)iclsPtr) == NULL) {
+            return TCL_OK;
+        }
+        contextIoPtr = iclsPtr->firstInstancePtr;
+    }
+    if (contextIoPtr != NULL) {
+	callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
+        if (Itcl_DeleteObject(interp, contextIoPtr) != TCL_OK) {
+            iclsPtr2 = iclsPtr;
+            goto deleteClassFail;
         }
 
+        Tcl_NRAddCallback(interp, CallDeleteOneObject, iclsPtr,
+	        infoPtr, NULL, NULL);
+        return Itcl_NRRunCallbacks(interp, callbackPtr);
     }
 
     return TCL_OK;
@@ -821,8 +832,6 @@ void
 ItclDestroyClassNamesp(
     ClientData cdata)  /* class definition to be destroyed */
 {
-    Tcl_HashEntry *hPtr;
-    Tcl_HashSearch place;
     Tcl_Command cmdPtr;
     ItclClass *iclsPtr;
     ItclObject *ioPtr;
@@ -865,28 +874,23 @@ ItclDestroyClassNamesp(
      *  Scan through and find all objects that belong to this class.
      *  Destroy them quietly by deleting their access command.
      */
-    hPtr = Tcl_FirstHashEntry(&iclsPtr->infoPtr->objects, &place);
-    while (hPtr) {
-        ioPtr = (ItclObject*)Tcl_GetHashValue(hPtr);
-        if (ioPtr->iclsPtr == iclsPtr) {
-	    if ((ioPtr->accessCmd != NULL) && (!(ioPtr->flags &
-	            (ITCL_OBJECT_IS_DESTRUCTED)))) {
-		Itcl_PreserveData(ioPtr);
-                Tcl_DeleteCommandFromToken(iclsPtr->interp, ioPtr->accessCmd);
-	        ioPtr->accessCmd = NULL;
-		Itcl_ReleaseData(ioPtr);
-	        /*
-	         * Fix 227804: Whenever an object to delete was found we
-	         * have to reset the search to the beginning as the
-	         * current entry in the search was deleted and accessing it
-	         * is therefore not allowed anymore.
-	         */
-
-	        hPtr = Tcl_FirstHashEntry(&iclsPtr->infoPtr->objects, &place);
-	        continue;
-	    }
-        }
-        hPtr = Tcl_NextHashEntry(&place);
+    ioPtr = iclsPtr->firstInstancePtr;
+    while (ioPtr) {
+	if ((ioPtr->accessCmd != NULL) && (!(ioPtr->flags &
+	        (ITCL_OBJECT_IS_DESTRUCTED)))) {
+	    Itcl_PreserveData(ioPtr);
+            Tcl_DeleteCommandFromToken(iclsPtr->interp, ioPtr->accessCmd);
+	    ioPtr->accessCmd = NULL;
+	    Itcl_ReleaseData(ioPtr);
+	    /*
+	     * Destructors may have deleted any other object of the
+	     * list as well, so start over from its head.
+	     */
+
+	    ioPtr = iclsPtr->firstInstancePtr;
+	    continue;
+	}
+        ioPtr = ioPtr->nextInstancePtr;
     }
 
     /*
@@ -1025,6 +1029,11 @@ ItclFreeClass(
 	Tcl_DeleteHashEntry(hPtr);
     }
     Tcl_DeleteHashTable(&iclsPtr->resolveCmds);
+    Tcl_DeleteHashTable(&iclsPtr->resolveCmdNames);
+    Tcl_DeleteHashTable(&iclsPtr->resolveCmdCache);
+    Tcl_DeleteHashTable(&iclsPtr->configOptions);
+    Tcl_DeleteHashTable(&iclsPtr->qualifierClasses);
+    ItclFreeObjectProto(iclsPtr);
 
     /*
      *  Delete all option definitions.
@@ -1123,6 +1132,8 @@ ItclFreeClass(
             (char *)iclsPtr->nsPtr);
     if (hPtr != NULL) {
         Tcl_DeleteHashEntry(hPtr);
+	/* cached access checks may refer to the namespace */
+	iclsPtr->infoPtr->protoEpoch++;
     }
 
     /* remove owerself from the all classes entry */
@@ -1175,6 +1186,9 @@ ItclFreeClass(
 
     Tcl_DecrRefCount(iclsPtr->namePtr);
     Tcl_DecrRefCount(iclsPtr->fullNamePtr);
+    if (iclsPtr->codeNsNamePtr != NULL) {
+        Tcl_DecrRefCount(iclsPtr->codeNsNamePtr);
+    }
 
     if (iclsPtr->resolvePtr != NULL) {
         ckfree((char *)iclsPtr->resolvePtr->clientData);
@@ -1818,6 +1832,40 @@ ItclResolveVarEntry(
     }
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  AddVirtualCmd()
+ *
+ *  Enters one name of a member function into the command resolution
+ *  tables of a class, unless the name is already taken by a more
+ *  specific member.  Returns 1 if the name was added, 0 otherwise.
+ * ------------------------------------------------------------------------
+ */
+static int
+AddVirtualCmd(
+    ItclClass *iclsPtr,       /* class definition being updated */
+    Tcl_Obj *namePtr,         /* name of the function in this scope */
+    ItclMemberFunc *imPtr)    /* function the name refers to */
+{
+    Tcl_HashEntry *hPtr;
+    ItclCmdLookup *clookupPtr;
+    int newEntry;
+
+    hPtr = Tcl_CreateHashEntry(&iclsPtr->resolveCmds, (char *)namePtr,
+            &newEntry);
+    if (!newEntry) {
+        return 0;
+    }
+    clookupPtr = (ItclCmdLookup *)ckalloc(sizeof(ItclCmdLookup));
+    memset(clookupPtr, 0, sizeof(ItclCmdLookup));
+    clookupPtr->imPtr = imPtr;
+    Tcl_SetHashValue(hPtr, clookupPtr);
+    hPtr = Tcl_CreateHashEntry(&iclsPtr->resolveCmdNames,
+            Tcl_GetString(namePtr), &newEntry);
+    Tcl_SetHashValue(hPtr, clookupPtr);
+    return 1;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BuildVirtualTables()
@@ -1850,12 +1898,16 @@ Itcl_BuildVirtualTables(
     Tcl_Namespace* nsPtr;
     Tcl_DString buffer, buffer2, *bufferC, *bufferC2, *bufferSwp;
     Tcl_Obj *objPtr;
+    Tcl_HashEntry *hPtr2;
     ItclMemberFunc *imPtr;
     ItclDelegatedFunction *idmPtr;
-    ItclHierIter hier;
     ItclClass *iclsPtr2;
     ItclCmdLookup *clookupPtr;
+    ItclVariable *ivPtr;
+    Itcl_ListElem *elem;
+    Tcl_HashSearch search;
     int newEntry;
+    int slot;
 
     Tcl_DStringInit(&buffer);
     Tcl_DStringInit(&buffer2);
@@ -1874,96 +1926,366 @@ Itcl_BuildVirtualTables(
     }
     Tcl_DeleteHashTable(&iclsPtr->resolveCmds);
     Tcl_InitObjHashTable(&iclsPtr->resolveCmds);
+    Tcl_DeleteHashTable(&iclsPtr->resolveCmdNames);
+    Tcl_InitHashTable(&iclsPtr->resolveCmdNames, TCL_STRING_KEYS);
+    ItclResetResolveCmdCache(iclsPtr);
+    Tcl_DeleteHashTable(&iclsPtr->configOptions);
+    Tcl_InitObjHashTable(&iclsPtr->configOptions);
+    Tcl_DeleteHashTable(&iclsPtr->qualifierClasses);
+    Tcl_InitHashTable(&iclsPtr->qualifierClasses, TCL_STRING_KEYS);
 
     /*
-     *  Scan through all classes in the hierarchy, from most to
-     *  least specific.  Look for the first (most-specific) definition
-     *  of each member function, and enter it into the table.
+     *  Derived classes see this class through their own prototypes,
+     *  so outdate all of them.
      */
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
-        hPtr = Tcl_FirstHashEntry(&iclsPtr2->functions, &place);
-        while (hPtr) {
-            imPtr = (ItclMemberFunc*)Tcl_GetHashValue(hPtr);
+    iclsPtr->infoPtr->protoEpoch++;
 
-            /*
-             *  Create all possible names for this function and enter
-             *  them into the command resolution table:
-             *     func
-             *     class::func
-             *     namesp1::class::func
-             *     namesp2::namesp1::class::func
-             *     ...
-             */
-            Tcl_DStringSetLength(&buffer, 0);
-            Tcl_DStringAppend(&buffer, Tcl_GetString(imPtr->namePtr), -1);
-            bufferC = &buffer; bufferC2 = &buffer2;
-            nsPtr = iclsPtr2->nsPtr;
-
-            while (1) {
-		objPtr = Tcl_NewStringObj(Tcl_DStringValue(bufferC),
-				Tcl_DStringLength(bufferC));
-                hPtr = Tcl_CreateHashEntry(&iclsPtr->resolveCmds,
-                        (char *)objPtr, &newEntry);
-
-                if (newEntry) {
-		    clookupPtr = (ItclCmdLookup *)ckalloc(sizeof(ItclCmdLookup));
-		    memset(clookupPtr, 0, sizeof(ItclCmdLookup));
-		    clookupPtr->imPtr = imPtr;
-                    Tcl_SetHashValue(hPtr, clookupPtr);
-                } else {
-		    Tcl_DecrRefCount(objPtr);
-		}
+    /*
+     *  Enter all possible names of the functions of this class into
+     *  the table.  They shadow anything in the base classes.
+     */
+    FOREACH_HASH_VALUE(imPtr, &iclsPtr->functions) {
+        /*
+         *  Create all possible names for this function and enter
+         *  them into the command resolution table:
+         *     func
+         *     class::func
+         *     namesp1::class::func
+         *     namesp2::namesp1::class::func
+         *     ...
+         */
+        Tcl_DStringSetLength(&buffer, 0);
+        Tcl_DStringAppend(&buffer, Tcl_GetString(imPtr->namePtr), -1);
+        bufferC = &buffer; bufferC2 = &buffer2;
+        nsPtr = iclsPtr->nsPtr;
+
+        while (1) {
+	    objPtr = Tcl_NewStringObj(Tcl_DStringValue(bufferC),
+			    Tcl_DStringLength(bufferC));
+            if (AddVirtualCmd(iclsPtr, objPtr, imPtr) == 0) {
+		Tcl_DecrRefCount(objPtr);
+	    }
 
-                if (nsPtr == NULL) {
-                    break;
-                }
+            if (nsPtr == NULL) {
+                break;
+            }
 
-                Tcl_DStringSetLength(bufferC2, 0);
-                Tcl_DStringAppend(bufferC2, nsPtr->name, -1);
-                Tcl_DStringAppend(bufferC2, "::", 2);
-                Tcl_DStringAppend(bufferC2, Tcl_DStringValue(bufferC),
-				Tcl_DStringLength(bufferC));
-                bufferSwp = bufferC; bufferC = bufferC2; bufferC2 = bufferSwp;
+            Tcl_DStringSetLength(bufferC2, 0);
+            Tcl_DStringAppend(bufferC2, nsPtr->name, -1);
+            Tcl_DStringAppend(bufferC2, "::", 2);
+            Tcl_DStringAppend(bufferC2, Tcl_DStringValue(bufferC),
+			    Tcl_DStringLength(bufferC));
+            bufferSwp = bufferC; bufferC = bufferC2; bufferC2 = bufferSwp;
 
-                nsPtr = nsPtr->parentPtr;
-            }
-            hPtr = Tcl_NextHashEntry(&place);
+            nsPtr = nsPtr->parentPtr;
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
 
     /*
-     *  Scan through all classes in the hierarchy, from most to
-     *  least specific.  Look for the first (most-specific) definition
-     *  of each delegated member function, and enter it into the table.
+     *  The table of each base class already holds the most-specific
+     *  definition of every name in its part of the hierarchy, and no
+     *  class appears twice in a heritage.  So merging the tables of
+     *  the bases in order gives the same result as scanning the whole
+     *  hierarchy from most to least specific, without building any
+     *  names again.
      */
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
-        hPtr = Tcl_FirstHashEntry(&iclsPtr2->delegatedFunctions, &place);
+    for (elem = Itcl_FirstListElem(&iclsPtr->bases); elem != NULL;
+            elem = Itcl_NextListElem(elem)) {
+        iclsPtr2 = (ItclClass *)Itcl_GetListValue(elem);
+        hPtr = Tcl_FirstHashEntry(&iclsPtr2->resolveCmds, &place);
         while (hPtr) {
-            idmPtr = (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
-	    hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions,
-	            (char *)idmPtr->namePtr);
-	    if (hPtr == NULL) {
-	        hPtr = Tcl_CreateHashEntry(&iclsPtr->delegatedFunctions,
-		        (char *)idmPtr->namePtr, &newEntry);
-                Tcl_SetHashValue(hPtr, idmPtr);
-	    }
+            clookupPtr = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
+            (void) AddVirtualCmd(iclsPtr,
+                    (Tcl_Obj *)Tcl_GetHashKey(&iclsPtr2->resolveCmds, hPtr),
+                    clookupPtr->imPtr);
             hPtr = Tcl_NextHashEntry(&place);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
+
+    /*
+     *  Same for the delegated member functions: the most-specific
+     *  definition of each of them is in the table of the first base
+     *  class that has one.
+     */
+    for (elem = Itcl_FirstListElem(&iclsPtr->bases); elem != NULL;
+            elem = Itcl_NextListElem(elem)) {
+        iclsPtr2 = (ItclClass *)Itcl_GetListValue(elem);
+        FOREACH_HASH_VALUE(idmPtr, &iclsPtr2->delegatedFunctions) {
+	    hPtr2 = Tcl_CreateHashEntry(&iclsPtr->delegatedFunctions,
+		    (char *)idmPtr->namePtr, &newEntry);
+	    if (newEntry) {
+                Tcl_SetHashValue(hPtr2, idmPtr);
+	    }
+        }
+    }
+
+    /*
+     *  Number the variables of this class after those of its first
+     *  base class, so that objects of any class on a single
+     *  inheritance chain agree on the slot of each variable.
+     */
+    elem = Itcl_FirstListElem(&iclsPtr->bases);
+    if (elem != NULL) {
+        iclsPtr->numVarSlots = ((ItclClass *)
+                Itcl_GetListValue(elem))->numVarSlots;
+    } else {
+        iclsPtr->numVarSlots = 0;
+    }
+    FOREACH_HASH_VALUE(ivPtr, &iclsPtr->variables) {
+        ivPtr->slot = iclsPtr->numVarSlots++;
+    }
+
+    /*
+     *  The member functions are numbered within their own class.  An
+     *  object keeps the call context of a function in the slot at that
+     *  number plus the start of the range its class has in the heritage
+     *  of the object's class.  The ranges of all classes in the
+     *  heritage are disjoint, so no two member functions share a slot.
+     */
+    slot = 0;
+    FOREACH_HASH_VALUE(imPtr, &iclsPtr->functions) {
+        imPtr->slot = slot++;
+    }
+    iclsPtr->numMethodSlots = 0;
+    hPtr = Tcl_FirstHashEntry(&iclsPtr->heritage, &place);
+    while (hPtr) {
+        iclsPtr2 = (ItclClass *)Tcl_GetHashKey(&iclsPtr->heritage, hPtr);
+        Tcl_SetHashValue(hPtr, INT2PTR(iclsPtr->numMethodSlots));
+        iclsPtr->numMethodSlots += iclsPtr2->functions.numEntries;
+        hPtr = Tcl_NextHashEntry(&place);
+    }
 
     Tcl_DStringFree(&buffer);
     Tcl_DStringFree(&buffer2);
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclResetResolveCmdCache()
+ *
+ *  Forgets all names that Itcl_ClassCmdResolver() resolved through the
+ *  delegated functions of an extendedclass.  Must be called whenever
+ *  resolveCmds or delegatedFunctions of the class change.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclResetResolveCmdCache(
+    ItclClass *iclsPtr)       /* class definition being updated */
+{
+    if (iclsPtr->resolveCmdCache.numEntries > 0) {
+        Tcl_DeleteHashTable(&iclsPtr->resolveCmdCache);
+        Tcl_InitHashTable(&iclsPtr->resolveCmdCache, TCL_STRING_KEYS);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFindPublicVar()
+ *
+ *  Returns the public variable that the "-name" option of "configure"
+ *  and "cget" refers to in the given class scope, or NULL if there is
+ *  none.  Each option is resolved once; later lookups are a single
+ *  probe of the configOptions table of the class.
+ * ------------------------------------------------------------------------
+ */
+ItclVariable *
+ItclFindPublicVar(
+    ItclClass *iclsPtr,       /* most-specific class of the object */
+    Tcl_Obj *optionPtr)       /* option name, including the "-" */
+{
+    Tcl_HashEntry *hPtr;
+    ItclVarLookup *vlookup;
+    const char *token;
+    int isNew;
+
+    hPtr = Tcl_FindHashEntry(&iclsPtr->configOptions, (char *)optionPtr);
+    if (hPtr != NULL) {
+        return (ItclVariable *)Tcl_GetHashValue(hPtr);
+    }
+    token = Tcl_GetString(optionPtr);
+    if (*token != '-') {
+        return NULL;
+    }
+    hPtr = ItclResolveVarEntry(iclsPtr, token+1);
+    if (hPtr == NULL) {
+        return NULL;
+    }
+    vlookup = (ItclVarLookup *)Tcl_GetHashValue(hPtr);
+    if (vlookup->ivPtr->protection != ITCL_PUBLIC) {
+        return NULL;
+    }
+    hPtr = Tcl_CreateHashEntry(&iclsPtr->configOptions, (char *)optionPtr,
+            &isNew);
+    Tcl_SetHashValue(hPtr, vlookup->ivPtr);
+    return vlookup->ivPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetObjectProto()
+ *
+ *  Returns the prototype of the objects of the given class, building
+ *  it first if the class has none yet or if any class definition has
+ *  changed since it was built.  New objects are initialized from this
+ *  record instead of walking the class hierarchy on every construction.
+ * ------------------------------------------------------------------------
+ */
+ItclObjectProto *
+ItclGetObjectProto(
+    ItclClass *iclsPtr)       /* class of the new object */
+{
+    Tcl_HashTable seen;
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch search;
+    Tcl_Obj *destructorPtr;
+    ItclObjectProto *protoPtr;
+    ItclClass *iclsPtr2;
+    ItclHierIter hier;
+    ItclOption *ioptPtr;
+    ItclDelegatedOption *idoPtr;
+    ItclMethodVariable *imvPtr;
+    int numClasses;
+    int numOptions;
+    int numDelegatedOptions;
+    int numMethodVariables;
+    int isNew;
+
+    protoPtr = iclsPtr->protoPtr;
+    if ((protoPtr != NULL) && (protoPtr->epoch == iclsPtr->infoPtr->protoEpoch)) {
+        return protoPtr;
+    }
+    ItclFreeObjectProto(iclsPtr);
+
+    /*
+     *  Size the arrays generously: entries hidden by a more specific
+     *  class are counted, but not stored.
+     */
+    numClasses = 0;
+    numOptions = 0;
+    numDelegatedOptions = 0;
+    numMethodVariables = 0;
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+        numClasses++;
+        numOptions += iclsPtr2->options.numEntries;
+        numDelegatedOptions += iclsPtr2->delegatedOptions.numEntries;
+        numMethodVariables += iclsPtr2->methodVariables.numEntries;
+    }
+    Itcl_DeleteHierIter(&hier);
+
+    protoPtr = (ItclObjectProto *)ckalloc(sizeof(ItclObjectProto));
+    memset(protoPtr, 0, sizeof(ItclObjectProto));
+    protoPtr->epoch = iclsPtr->infoPtr->protoEpoch;
+    protoPtr->classes = (ItclClass **)ckalloc(
+            numClasses * sizeof(ItclClass *));
+    protoPtr->options = (ItclOption **)ckalloc(
+            (numOptions + 1) * sizeof(ItclOption *));
+    protoPtr->delegatedOptions = (ItclDelegatedOption **)ckalloc(
+            (numDelegatedOptions + 1) * sizeof(ItclDelegatedOption *));
+    protoPtr->methodVariables = (ItclMethodVariable **)ckalloc(
+            (numMethodVariables + 1) * sizeof(ItclMethodVariable *));
+    protoPtr->destructors = (ItclClass **)ckalloc(
+            numClasses * sizeof(ItclClass *));
+
+    /*
+     *  The hierarchy order is the one destructors run in, so the first
+     *  occurrence of a class with a destructor decides its place.
+     */
+    destructorPtr = Tcl_NewStringObj("destructor", -1);
+    Tcl_IncrRefCount(destructorPtr);
+    Tcl_InitHashTable(&seen, TCL_ONE_WORD_KEYS);
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+        protoPtr->classes[protoPtr->numClasses++] = iclsPtr2;
+        (void) Tcl_CreateHashEntry(&seen, (char *)iclsPtr2, &isNew);
+        if (isNew && (Tcl_FindHashEntry(&iclsPtr2->functions,
+                (char *)destructorPtr) != NULL)) {
+            protoPtr->destructors[protoPtr->numDestructors++] = iclsPtr2;
+        }
+    }
+    Itcl_DeleteHierIter(&hier);
+    Tcl_DeleteHashTable(&seen);
+    Tcl_DecrRefCount(destructorPtr);
+
+    /*
+     *  The object tables are keyed by name, so the first (most
+     *  specific) definition of each name wins, exactly as if the
+     *  entries were inserted one class after the other.
+     */
+
+    Tcl_InitObjHashTable(&seen);
+    for (numClasses = 0; numClasses < protoPtr->numClasses; numClasses++) {
+        iclsPtr2 = protoPtr->classes[numClasses];
+        FOREACH_HASH_VALUE(ioptPtr, &iclsPtr2->options) {
+            (void) Tcl_CreateHashEntry(&seen, (char *)ioptPtr->namePtr,
+                    &isNew);
+            if (isNew) {
+                protoPtr->options[protoPtr->numOptions++] = ioptPtr;
+            }
+        }
+    }
+    Tcl_DeleteHashTable(&seen);
+
+    Tcl_InitObjHashTable(&seen);
+    for (numClasses = 0; numClasses < protoPtr->numClasses; numClasses++) {
+        iclsPtr2 = protoPtr->classes[numClasses];
+        FOREACH_HASH_VALUE(idoPtr, &iclsPtr2->delegatedOptions) {
+            (void) Tcl_CreateHashEntry(&seen, (char *)idoPtr->namePtr,
+                    &isNew);
+            if (isNew) {
+                protoPtr->delegatedOptions[protoPtr->numDelegatedOptions++]
+                        = idoPtr;
+            }
+        }
+    }
+    Tcl_DeleteHashTable(&seen);
+
+    Tcl_InitObjHashTable(&seen);
+    for (numClasses = 0; numClasses < protoPtr->numClasses; numClasses++) {
+        iclsPtr2 = protoPtr->classes[numClasses];
+        FOREACH_HASH_VALUE(imvPtr, &iclsPtr2->methodVariables) {
+            (void) Tcl_CreateHashEntry(&seen, (char *)imvPtr->namePtr,
+                    &isNew);
+            if (isNew) {
+                protoPtr->methodVariables[protoPtr->numMethodVariables++]
+                        = imvPtr;
+            }
+        }
+    }
+    Tcl_DeleteHashTable(&seen);
+
+    iclsPtr->protoPtr = protoPtr;
+    return protoPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeObjectProto()
+ *
+ *  Discards the object prototype of a class, if it has one.  The next
+ *  construction builds a fresh one.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeObjectProto(
+    ItclClass *iclsPtr)       /* class definition being updated */
+{
+    ItclObjectProto *protoPtr;
+
+    protoPtr = iclsPtr->protoPtr;
+    if (protoPtr == NULL) {
+        return;
+    }
+    iclsPtr->protoPtr = NULL;
+    ckfree((char *)protoPtr->classes);
+    ckfree((char *)protoPtr->options);
+    ckfree((char *)protoPtr->delegatedOptions);
+    ckfree((char *)protoPtr->methodVariables);
+    ckfree((char *)protoPtr->destructors);
+    ckfree((char *)protoPtr);
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_CreateVariable()
@@ -2026,6 +2348,7 @@ Itcl_CreateVariable(
      *  If everything looks good, create the variable definition.
      */
     ivPtr = (ItclVariable*)Itcl_Alloc(sizeof(ItclVariable));
+    ivPtr->slot         = -1;
     ivPtr->iclsPtr      = iclsPtr;
     ivPtr->infoPtr      = iclsPtr->infoPtr;
     ivPtr->protection   = Itcl_Protection(interp, 0);
@@ -2096,6 +2419,7 @@ Itcl_CreateOption(
     }
 
     iclsPtr->numOptions++;
+    iclsPtr->infoPtr->protoEpoch++;
     ioptPtr->iclsPtr = iclsPtr;
     ioptPtr->codePtr = NULL;
     ioptPtr->fullNamePtr = Tcl_NewStringObj(
@@ -2148,6 +2472,7 @@ ItclCreateMethodVariable(
             NULL);
         return TCL_ERROR;
     }
+    ivPtr->iclsPtr->infoPtr->protoEpoch++;
 
     /*
      *  If everything looks good, create the option definition.
@@ -2491,9 +2816,15 @@ ItclDeleteFunction(
     if (imPtr->bodyPtr != NULL) {
         Tcl_DecrRefCount(imPtr->bodyPtr);
     }
+    if (imPtr->callNamePtr != NULL) {
+        Tcl_DecrRefCount(imPtr->callNamePtr);
+    }
     if (imPtr->argListPtr != NULL) {
         ItclDeleteArgList(imPtr->argListPtr);
     }
+    if (imPtr->profilePtr != NULL) {
+        ckfree((char *)imPtr->profilePtr);
+    }
     Itcl_Free(imPtr);
 }
 
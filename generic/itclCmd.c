@@ -288,6 +288,59 @@ Itcl_FindClassesCmd(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  AppendClassInstances()
+ *
+ *  Helper for Itcl_FindObjectsCmd().  Appends the names of all live
+ *  objects whose most-specific class is iclsPtr and which match the
+ *  pattern to listPtr.  Objects with their access command in the
+ *  active namespace are reported by their simple name, all others by
+ *  their full name, just like the namespace scan does.
+ * ------------------------------------------------------------------------
+ */
+static void
+AppendClassInstances(
+    Tcl_Interp *interp,          /* current interpreter */
+    ItclClass *iclsPtr,          /* class whose instances are wanted */
+    const char *pattern,         /* pattern for names or NULL */
+    int forceFullNames,          /* always report the full name */
+    Tcl_Namespace *activeNs,     /* namespace find was called from */
+    Tcl_Obj *listPtr)            /* returns: names of the objects */
+{
+    ItclObject *ioPtr;
+    Tcl_Obj *objPtr;
+    const char *cmdName;
+    const char *nsName;
+    size_t nsLen;
+
+    nsName = activeNs->fullName;
+    nsLen = strlen(nsName);
+    if (nsLen == 2) {
+        nsLen = 0;   /* the global namespace is "::" */
+    }
+    for (ioPtr = iclsPtr->firstInstancePtr; ioPtr != NULL;
+            ioPtr = ioPtr->nextInstancePtr) {
+        if (ioPtr->accessCmd == NULL) {
+            continue;
+        }
+        objPtr = Tcl_NewStringObj(NULL, 0);
+        Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
+        cmdName = Tcl_GetString(objPtr);
+        if (!forceFullNames && (strncmp(cmdName, nsName, nsLen) == 0)
+                && (cmdName[nsLen] == ':') && (cmdName[nsLen+1] == ':')
+                && (strstr(cmdName + nsLen + 2, "::") == NULL)) {
+            Tcl_SetStringObj(objPtr, cmdName + nsLen + 2, -1);
+            cmdName = Tcl_GetString(objPtr);
+        }
+        if (!pattern || Tcl_StringCaseMatch(cmdName, pattern, 0)) {
+            Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
+        } else {
+            Tcl_DecrRefCount(objPtr);
+        }
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_FindObjectsCmd()
@@ -387,6 +440,45 @@ Itcl_FindObjectsCmd(
         return TCL_ERROR;
     }
 
+    /*
+     *  With -class or -isa, only the instance lists of the classes
+     *  in question have to be looked at:  the class itself for -class,
+     *  the class and everything derived from it for -isa.
+     */
+    if ((iclsPtr != NULL) || (isaDefn != NULL)) {
+        ItclClass *clsPtr;
+        Itcl_ListElem *elem;
+
+        Tcl_InitHashTable(&unique, TCL_ONE_WORD_KEYS);
+        Itcl_InitStack(&search);
+        if (iclsPtr != NULL) {
+            if ((isaDefn == NULL) || (Tcl_FindHashEntry(&iclsPtr->heritage,
+                    (char *)isaDefn) != NULL)) {
+                Itcl_PushStack(iclsPtr, &search);
+            }
+        } else {
+            Itcl_PushStack(isaDefn, &search);
+        }
+        while (Itcl_GetStackSize(&search) > 0) {
+            clsPtr = (ItclClass *)Itcl_PopStack(&search);
+            Tcl_CreateHashEntry(&unique, (char *)clsPtr, &newEntry);
+            if (!newEntry) {
+                continue;
+            }
+            AppendClassInstances(interp, clsPtr, pattern, forceFullNames,
+                    activeNs, Tcl_GetObjResult(interp));
+            if (iclsPtr == NULL) {
+                for (elem = Itcl_LastListElem(&clsPtr->derived); elem;
+                        elem = Itcl_PrevListElem(elem)) {
+                    Itcl_PushStack(Itcl_GetListValue(elem), &search);
+                }
+            }
+        }
+        Itcl_DeleteStack(&search);
+        Tcl_DeleteHashTable(&unique);
+        return TCL_OK;
+    }
+
     /*
      *  Search through all commands in the current namespace first,
      *  in the global namespace next, then in all child namespaces
@@ -816,17 +908,28 @@ Itcl_ScopeCmd(
 
         objPtr2 = Tcl_NewStringObj(NULL, 0);
         Tcl_IncrRefCount(objPtr2);
-	Tcl_AppendToObj(objPtr2, ITCL_VARIABLES_NAMESPACE, -1);
-	Tcl_AppendToObj(objPtr2,
-		(Tcl_GetObjectNamespace(contextIoPtr->oPtr))->fullName, -1);
-
-        if (doAppend) {
-            Tcl_AppendToObj(objPtr2,
-	            Tcl_GetString(vlookup->ivPtr->fullNamePtr), -1);
+        if ((vlookup->ivPtr->flags & ITCL_THIS_VAR)
+                && (contextIoPtr->thisVarPtr != NULL)
+                && (strcmp(token, "this") == 0)) {
+            /*
+             *  Base classes share the "this" of the most specific
+             *  class and may not have a namespace of their own.
+             */
+            Itcl_GetVariableFullName(interp, contextIoPtr->thisVarPtr,
+                    objPtr2);
         } else {
-            Tcl_AppendToObj(objPtr2, "::", -1);
-            Tcl_AppendToObj(objPtr2,
-	            Tcl_GetString(vlookup->ivPtr->namePtr), -1);
+	    Tcl_AppendToObj(objPtr2, ITCL_VARIABLES_NAMESPACE, -1);
+	    Tcl_AppendToObj(objPtr2,
+		    (Tcl_GetObjectNamespace(contextIoPtr->oPtr))->fullName, -1);
+
+            if (doAppend) {
+                Tcl_AppendToObj(objPtr2,
+	                Tcl_GetString(vlookup->ivPtr->fullNamePtr), -1);
+            } else {
+                Tcl_AppendToObj(objPtr2, "::", -1);
+                Tcl_AppendToObj(objPtr2,
+	                Tcl_GetString(vlookup->ivPtr->namePtr), -1);
+	    }
 	}
 
         if (openParen) {
@@ -908,6 +1011,9 @@ Itcl_CodeCmd(
 {
     Tcl_Namespace *contextNs = Tcl_GetCurrentNamespace(interp);
 
+    Tcl_HashEntry *hPtr;
+    ItclObjectInfo *infoPtr;
+    ItclClass *iclsPtr;
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
     const char *token;
@@ -963,14 +1069,25 @@ Itcl_CodeCmd(
      *  current namespace context, and appending the remaining
      *  arguments AS A LIST...
      */
-    listPtr = Tcl_NewListObj(0, NULL);
+    infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
+            ITCL_INTERP_DATA, NULL);
+    listPtr = Tcl_NewListObj(2, infoPtr->codeWords);
 
-    Tcl_ListObjAppendElement(interp, listPtr,
-        Tcl_NewStringObj("namespace", -1));
-    Tcl_ListObjAppendElement(interp, listPtr,
-        Tcl_NewStringObj("inscope", -1));
-
-    if (contextNs == Tcl_GetGlobalNamespace(interp)) {
+    /*
+     *  All results made in a class namespace share one name object.
+     *  Once "namespace inscope" has looked it up, the namespace is
+     *  cached in it, so calling a callback needs no namespace lookup.
+     */
+    objPtr = NULL;
+    hPtr = Tcl_FindHashEntry(&infoPtr->namespaceClasses, (char *)contextNs);
+    if (hPtr != NULL) {
+        iclsPtr = (ItclClass *)Tcl_GetHashValue(hPtr);
+	if (iclsPtr->codeNsNamePtr == NULL) {
+	    iclsPtr->codeNsNamePtr = Tcl_NewStringObj(contextNs->fullName, -1);
+	    Tcl_IncrRefCount(iclsPtr->codeNsNamePtr);
+	}
+	objPtr = iclsPtr->codeNsNamePtr;
+    } else if (contextNs == Tcl_GetGlobalNamespace(interp)) {
         objPtr = Tcl_NewStringObj("::", -1);
     } else {
         objPtr = Tcl_NewStringObj(contextNs->fullName, -1);
@@ -1003,7 +1120,7 @@ Itcl_CodeCmd(
  */
 int
 Itcl_IsObjectCmd(
-    ClientData dummy,   /* class/object info */
+    ClientData clientData,   /* class/object info */
     Tcl_Interp *interp,      /* current interpreter */
     int objc,                /* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
@@ -1015,10 +1132,13 @@ Itcl_IsObjectCmd(
     char            *cname;
     char            *cmdName;
     char            *token;
+    Tcl_Obj         *nameObj = NULL;
     Tcl_Command     cmd;
+    Tcl_HashEntry   *hPtr;
     Tcl_Namespace   *contextNs = NULL;
+    ItclObjectInfo  *infoPtr = (ItclObjectInfo *)clientData;
+    ItclObject      *contextIoPtr;
     ItclClass       *iclsPtr = NULL;
-    (void)dummy;
 
     /*
      *    Handle the arguments.
@@ -1049,7 +1169,8 @@ Itcl_IsObjectCmd(
             idx++;
             classFlag = 1;
         } else {
-            name = Tcl_GetString(objv[idx]);
+            nameObj = objv[idx];
+            name = token;
         }
 
     } /* end for objc loop */
@@ -1058,55 +1179,122 @@ Itcl_IsObjectCmd(
     /*
      *  The object name may be a scoped value of the form
      *  "namespace inscope <namesp> <command>".  If it is,
-     *  decode it.
+     *  decode it.  Plain names are resolved through the command
+     *  cached in the argument, and the object is then taken from
+     *  the table of access commands without asking for the command
+     *  info or resolving the name a second time.
      */
-    if (Itcl_DecodeScopedCommand(interp, name, &contextNs, &cmdName)
-            != TCL_OK) {
-        return TCL_ERROR;
+    cmdName = NULL;
+    if ((*name == 'n') && (strncmp(name, "namespace", 9) == 0)) {
+        if (Itcl_DecodeScopedCommand(interp, name, &contextNs, &cmdName)
+                != TCL_OK) {
+            return TCL_ERROR;
+        }
+        cmd = Tcl_FindCommand(interp, cmdName, contextNs, /* flags */ 0);
+        ckfree(cmdName);
+    } else {
+        cmd = Tcl_GetCommandFromObj(interp, nameObj);
     }
 
-    cmd = Tcl_FindCommand(interp, cmdName, contextNs, /* flags */ 0);
+    contextIoPtr = NULL;
+    if (cmd != NULL) {
+        hPtr = Tcl_FindHashEntry(&infoPtr->objectCmds, (char *)cmd);
+        if (hPtr == NULL) {
+            /*
+             *  This may be an imported command.  Try the real one.
+             */
+            cmd = Tcl_GetOriginalCommand(cmd);
+            if (cmd != NULL) {
+                hPtr = Tcl_FindHashEntry(&infoPtr->objectCmds, (char *)cmd);
+            }
+        }
+        if (hPtr != NULL) {
+            contextIoPtr = (ItclObject *)Tcl_GetHashValue(hPtr);
+        }
+    }
 
     /*
-     *    Need the NULL test, or the test will fail if cmd is NULL
+     *    Handle the case when the -class flag is given
      */
-    if (cmd == NULL || ! Itcl_IsObject(cmd)) {
+    if ((contextIoPtr == NULL) || (classFlag
+            && !Itcl_ObjectIsa(contextIoPtr, iclsPtr))) {
         Tcl_SetObjResult(interp, Tcl_NewWideIntObj(0));
-	ckfree((char *)cmdName);
         return TCL_OK;
     }
 
     /*
-     *    Handle the case when the -class flag is given
+     *    Got this far, so assume that it is a valid object
      */
-    if (classFlag) {
-	ItclObject *contextIoPtr;
-        if (Itcl_FindObject(interp, cmdName, &contextIoPtr) != TCL_OK) {
+    Tcl_SetObjResult(interp, Tcl_NewWideIntObj(1));
+    return TCL_OK;
+}
+
+
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_NewCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::new" command to
+ *  create one or more objects with generated names in a single call.
+ *  syntax:
+ *
+ *    itcl::new ?-count n? className ?arg arg ...?
+ *
+ *  All objects receive the same constructor arguments.  Returns the
+ *  list of the names of the new objects.  If any constructor fails,
+ *  no objects are left behind and the error is returned.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_NewCmd(
+    ClientData dummy,        /* class/object info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    Tcl_Obj *namesPtr;
+    ItclClass *iclsPtr;
+    int count;
+    int idx;
+    (void)dummy;
+
+    count = 1;
+    idx = 1;
+    if ((objc > 2) && (strcmp(Tcl_GetString(objv[1]), "-count") == 0)) {
+        if (Tcl_GetIntFromObj(interp, objv[2], &count) != TCL_OK) {
             return TCL_ERROR;
         }
-	if (contextIoPtr == NULL) {
-	   /* seems that we are in constructor, so look for currIoPtr in info structure */
-	   contextIoPtr = iclsPtr->infoPtr->currIoPtr;
-	}
-        if (! Itcl_ObjectIsa(contextIoPtr, iclsPtr)) {
-            Tcl_SetObjResult(interp, Tcl_NewWideIntObj(0));
-	    ckfree((char *)cmdName);
-            return TCL_OK;
+        if (count < 0) {
+            Tcl_AppendResult(interp, "bad count \"",
+                    Tcl_GetString(objv[2]),
+                    "\": must be a non-negative integer", NULL);
+            return TCL_ERROR;
         }
-
+        idx = 3;
+    }
+    if (idx >= objc) {
+        Tcl_WrongNumArgs(interp, 1, objv, "?-count n? className ?arg ...?");
+        return TCL_ERROR;
+    }
+    iclsPtr = Itcl_FindClass(interp, Tcl_GetString(objv[idx]),
+            /* autoload */ 1);
+    if (iclsPtr == NULL) {
+        return TCL_ERROR;
     }
 
-    /*
-     *    Got this far, so assume that it is a valid object
-     */
-    Tcl_SetObjResult(interp, Tcl_NewWideIntObj(1));
-    ckfree(cmdName);
-
+    namesPtr = Tcl_NewListObj(0, NULL);
+    Tcl_IncrRefCount(namesPtr);
+    if (Itcl_CreateObjects(interp, iclsPtr, count, objc - idx - 1,
+            objv + idx + 1, namesPtr) != TCL_OK) {
+        Tcl_DecrRefCount(namesPtr);
+        return TCL_ERROR;
+    }
+    Tcl_SetObjResult(interp, namesPtr);
+    Tcl_DecrRefCount(namesPtr);
     return TCL_OK;
 }
 
-
-
 /*
  * ------------------------------------------------------------------------
  *  Itcl_IsClassCmd()
@@ -1572,9 +1760,10 @@ Itcl_AddObjectOptionCmd(
     Tcl_AppendToObj(ioptPtr->fullNamePtr, "::", 2);
     Tcl_AppendToObj(ioptPtr->fullNamePtr, Tcl_GetString(ioptPtr->namePtr), -1);
     Tcl_IncrRefCount(ioptPtr->fullNamePtr);
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectOptions,
+    hPtr = Tcl_CreateHashEntry(&ItclCreateObjectTables(ioPtr)->objectOptions,
             (char *)ioptPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, ioptPtr);
+    ItclResetDelegateTargets(ioPtr);
     ItclSetInstanceVar(interp, "itcl_options",
             Tcl_GetString(ioptPtr->namePtr),
             Tcl_GetString(ioptPtr->defaultValuePtr), ioPtr, NULL);
@@ -1635,9 +1824,11 @@ Itcl_AddDelegatedOptionCmd(
     if (result != TCL_OK) {
         return result;
     }
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+    hPtr = Tcl_CreateHashEntry(
+            &ItclCreateObjectTables(ioPtr)->objectDelegatedOptions,
             (char *)idoPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, idoPtr);
+    ItclResetDelegateTargets(ioPtr);
     return result;
 }
 
@@ -1714,7 +1905,8 @@ Itcl_AddDelegatedFunctionCmd(
     componentNamePtr = Tcl_NewStringObj(val, -1);
     Tcl_IncrRefCount(componentNamePtr);
     DelegateFunction(interp, ioPtr, ioPtr->iclsPtr, componentNamePtr, idmPtr);
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectDelegatedFunctions,
+    hPtr = Tcl_CreateHashEntry(
+            &ItclCreateObjectTables(ioPtr)->objectDelegatedFunctions,
             (char *)idmPtr->namePtr, &isNew);
     Tcl_DecrRefCount(componentNamePtr);
     Tcl_SetHashValue(hPtr, idmPtr);
@@ -1773,7 +1965,9 @@ Itcl_AddComponentCmd(
         return TCL_ERROR;
     }
     contextIclsPtr = contextIoPtr->iclsPtr;
-    hPtr = Tcl_CreateHashEntry(&contextIoPtr->objectComponents, (char *)objv[2],
+    hPtr = Tcl_CreateHashEntry(
+            &ItclCreateObjectTables(contextIoPtr)->objectComponents,
+            (char *)objv[2],
             &isNew);
     if (!isNew) {
 	Tcl_AppendResult(interp, "Itcl_AddComponentCmd component \"",
@@ -2191,3 +2385,623 @@ Itcl_ClassWidgetClassCmd(
     Tcl_AppendResult(interp, "invalid command name \"widgetclass\"", NULL);
     return TCL_ERROR;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  ProfileNow()
+ *
+ *  Returns the current time in microseconds for the profiler.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_WideInt
+ProfileNow(void)
+{
+    Tcl_Time now;
+
+    Tcl_GetTime(&now);
+    return ((Tcl_WideInt)now.sec * 1000000) + now.usec;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclProfileFunctionRecord()
+ *
+ *  Returns the profiler counters of a member function, creating them
+ *  on its first profiled call.  The builtin "configure" and "cget"
+ *  methods of all classes share the counters in the ItclObjectInfo.
+ * ------------------------------------------------------------------------
+ */
+ItclProfileRecord *
+ItclProfileFunctionRecord(
+    ItclMemberFunc *imPtr)
+{
+    const char *body;
+
+    if ((imPtr->codePtr != NULL) && (imPtr->codePtr->flags & ITCL_BUILTIN)) {
+        body = Tcl_GetString(imPtr->codePtr->bodyPtr);
+	if (strcmp(body, "@itcl-builtin-configure") == 0) {
+	    return &imPtr->infoPtr->profileConfigure;
+	}
+	if (strcmp(body, "@itcl-builtin-cget") == 0) {
+	    return &imPtr->infoPtr->profileCget;
+	}
+    }
+    if (imPtr->profilePtr == NULL) {
+        imPtr->profilePtr = (ItclProfileRecord *)ckalloc(
+	        sizeof(ItclProfileRecord));
+	memset(imPtr->profilePtr, 0, sizeof(ItclProfileRecord));
+    }
+    return imPtr->profilePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclProfileEnter()
+ *
+ *  Starts timing a call that is counted on recPtr.  Only called while
+ *  infoPtr->profiling is set, each call is ended by ItclProfileLeave().
+ * ------------------------------------------------------------------------
+ */
+void
+ItclProfileEnter(
+    ItclObjectInfo *infoPtr,
+    ItclProfileRecord *recPtr)
+{
+    ItclProfileFrame *framePtr;
+
+    if (infoPtr->numProfileFrames == infoPtr->maxProfileFrames) {
+	if (infoPtr->profileFrames == NULL) {
+	    infoPtr->maxProfileFrames = 32;
+	    infoPtr->profileFrames = (ItclProfileFrame *)ckalloc(
+	            infoPtr->maxProfileFrames * sizeof(ItclProfileFrame));
+	} else {
+	    infoPtr->maxProfileFrames *= 2;
+	    infoPtr->profileFrames = (ItclProfileFrame *)ckrealloc(
+	            (char *)infoPtr->profileFrames,
+	            infoPtr->maxProfileFrames * sizeof(ItclProfileFrame));
+	}
+    }
+    framePtr = infoPtr->profileFrames + infoPtr->numProfileFrames++;
+    framePtr->recPtr = recPtr;
+    framePtr->nested = 0;
+    framePtr->start = ProfileNow();
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclProfileLeave()
+ *
+ *  Ends the innermost active call counted on recPtr and adds it to the
+ *  counters.  Calls do not always end in the order they started
+ *  (coroutines), so the frame is searched for.  Calls that started
+ *  before profiling was switched on are not found and not counted.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclProfileLeave(
+    ItclObjectInfo *infoPtr,
+    ItclProfileRecord *recPtr,
+    int result)
+{
+    ItclProfileFrame *framePtr;
+    Tcl_WideInt elapsed;
+    int i;
+
+    for (i = infoPtr->numProfileFrames - 1; i >= 0; i--) {
+        if (infoPtr->profileFrames[i].recPtr == recPtr) {
+	    break;
+	}
+    }
+    if (i < 0) {
+        return;
+    }
+    framePtr = infoPtr->profileFrames + i;
+    elapsed = ProfileNow() - framePtr->start;
+    recPtr->calls++;
+    if (result == TCL_ERROR) {
+        recPtr->errors++;
+    }
+    recPtr->inclusive += elapsed;
+    recPtr->exclusive += elapsed - framePtr->nested;
+    if (i > 0) {
+        framePtr[-1].nested += elapsed;
+    }
+    infoPtr->numProfileFrames--;
+    memmove(framePtr, framePtr + 1,
+            (infoPtr->numProfileFrames - i) * sizeof(ItclProfileFrame));
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFinishProfile()
+ *
+ *  Frees the profiler data of an interpreter.  The counters of the
+ *  member functions go away with the functions.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFinishProfile(
+    ItclObjectInfo *infoPtr)
+{
+    if (infoPtr->profileFrames != NULL) {
+        ckfree((char *)infoPtr->profileFrames);
+	infoPtr->profileFrames = NULL;
+    }
+    infoPtr->numProfileFrames = 0;
+    infoPtr->maxProfileFrames = 0;
+    infoPtr->profiling = 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_ProfileOnCmd()
+ *  Itcl_ProfileOffCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::profile on" or
+ *  "itcl::profile off" command to start or stop counting the calls
+ *  of member functions.  The counters collected so far are kept.
+ *  syntax:
+ *
+ *    itcl::profile on
+ *    itcl::profile off
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_ProfileOnCmd(
+    ClientData clientData,   /* class/object info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+
+    if (objc != 1) {
+        Tcl_WrongNumArgs(interp, 1, objv, NULL);
+        return TCL_ERROR;
+    }
+    infoPtr->profiling = 1;
+    return TCL_OK;
+}
+
+int
+Itcl_ProfileOffCmd(
+    ClientData clientData,   /* class/object info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+
+    if (objc != 1) {
+        Tcl_WrongNumArgs(interp, 1, objv, NULL);
+        return TCL_ERROR;
+    }
+    /* the calls active now are not counted, they may never end */
+    infoPtr->profiling = 0;
+    infoPtr->numProfileFrames = 0;
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_ProfileResetCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::profile reset"
+ *  command.  Sets all counters back to zero.
+ *  syntax:
+ *
+ *    itcl::profile reset
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_ProfileResetCmd(
+    ClientData clientData,   /* class/object info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    FOREACH_HASH_DECLS;
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+    ItclClass *iclsPtr;
+    ItclMemberFunc *imPtr;
+    Tcl_HashEntry *hPtr2;
+    Tcl_HashSearch place2;
+
+    if (objc != 1) {
+        Tcl_WrongNumArgs(interp, 1, objv, NULL);
+        return TCL_ERROR;
+    }
+    FOREACH_HASH_VALUE(iclsPtr, &infoPtr->classes) {
+	for (hPtr2 = Tcl_FirstHashEntry(&iclsPtr->functions, &place2);
+	        hPtr2 != NULL; hPtr2 = Tcl_NextHashEntry(&place2)) {
+	    imPtr = (ItclMemberFunc *)Tcl_GetHashValue(hPtr2);
+	    if (imPtr->profilePtr != NULL) {
+		/* still referenced by the frames of active calls */
+		memset(imPtr->profilePtr, 0, sizeof(ItclProfileRecord));
+	    }
+	}
+    }
+    memset(&infoPtr->profileConfigure, 0, sizeof(ItclProfileRecord));
+    memset(&infoPtr->profileCget, 0, sizeof(ItclProfileRecord));
+    memset(&infoPtr->profileCreate, 0, sizeof(ItclProfileRecord));
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ProfileRecordObj()
+ *
+ *  Returns the counters of one record as a dict.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj *
+ProfileRecordObj(
+    ItclProfileRecord *recPtr)
+{
+    Tcl_Obj *dictPtr;
+
+    dictPtr = Tcl_NewDictObj();
+    Tcl_DictObjPut(NULL, dictPtr, Tcl_NewStringObj("calls", -1),
+            Tcl_NewWideIntObj(recPtr->calls));
+    Tcl_DictObjPut(NULL, dictPtr, Tcl_NewStringObj("errors", -1),
+            Tcl_NewWideIntObj(recPtr->errors));
+    Tcl_DictObjPut(NULL, dictPtr, Tcl_NewStringObj("inclusive", -1),
+            Tcl_NewWideIntObj(recPtr->inclusive));
+    Tcl_DictObjPut(NULL, dictPtr, Tcl_NewStringObj("exclusive", -1),
+            Tcl_NewWideIntObj(recPtr->exclusive));
+    return dictPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_ProfileReportCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::profile report"
+ *  command.  Returns a dict with the keys "functions", which maps the
+ *  full name of each member function called while profiling to its
+ *  counters, and "builtins", which has the counters of "configure",
+ *  "cget" and object creation ("create").  The counters are a dict
+ *  with the keys "calls", "errors", "inclusive" and "exclusive", the
+ *  times are in microseconds.
+ *  syntax:
+ *
+ *    itcl::profile report
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_ProfileReportCmd(
+    ClientData clientData,   /* class/object info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    FOREACH_HASH_DECLS;
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+    ItclClass *iclsPtr;
+    ItclMemberFunc *imPtr;
+    Tcl_HashEntry *hPtr2;
+    Tcl_HashSearch place2;
+    Tcl_Obj *functionsPtr;
+    Tcl_Obj *builtinsPtr;
+    Tcl_Obj *resultPtr;
+
+    if (objc != 1) {
+        Tcl_WrongNumArgs(interp, 1, objv, NULL);
+        return TCL_ERROR;
+    }
+    functionsPtr = Tcl_NewDictObj();
+    FOREACH_HASH_VALUE(iclsPtr, &infoPtr->classes) {
+	for (hPtr2 = Tcl_FirstHashEntry(&iclsPtr->functions, &place2);
+	        hPtr2 != NULL; hPtr2 = Tcl_NextHashEntry(&place2)) {
+	    imPtr = (ItclMemberFunc *)Tcl_GetHashValue(hPtr2);
+	    if ((imPtr->profilePtr != NULL) && (imPtr->profilePtr->calls > 0)) {
+		Tcl_DictObjPut(NULL, functionsPtr, imPtr->fullNamePtr,
+		        ProfileRecordObj(imPtr->profilePtr));
+	    }
+	}
+    }
+    builtinsPtr = Tcl_NewDictObj();
+    Tcl_DictObjPut(NULL, builtinsPtr, Tcl_NewStringObj("configure", -1),
+            ProfileRecordObj(&infoPtr->profileConfigure));
+    Tcl_DictObjPut(NULL, builtinsPtr, Tcl_NewStringObj("cget", -1),
+            ProfileRecordObj(&infoPtr->profileCget));
+    Tcl_DictObjPut(NULL, builtinsPtr, Tcl_NewStringObj("create", -1),
+            ProfileRecordObj(&infoPtr->profileCreate));
+    resultPtr = Tcl_NewDictObj();
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("functions", -1),
+            functionsPtr);
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("builtins", -1),
+            builtinsPtr);
+    Tcl_SetObjResult(interp, resultPtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  HashTableBytes()
+ *
+ *  Returns about how many bytes the entries and the bucket array of a
+ *  hash table take, not counting the table itself or string keys.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_WideInt
+HashTableBytes(
+    Tcl_HashTable *tablePtr,  /* table to measure */
+    size_t entrySize)         /* bytes of one entry */
+{
+    Tcl_WideInt bytes;
+
+    bytes = (Tcl_WideInt)tablePtr->numEntries * entrySize;
+    if (tablePtr->buckets != tablePtr->staticBuckets) {
+        bytes += (Tcl_WideInt)tablePtr->numBuckets * sizeof(Tcl_HashEntry *);
+    }
+    return bytes;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  VarNamespaceBytes()
+ *
+ *  Returns about how many bytes a variable namespace of an object takes,
+ *  including the scalar values with their string representation.  The
+ *  elements of arrays are counted, but not their values.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_WideInt
+VarNamespaceBytes(
+    Tcl_Namespace *nsPtr)     /* namespace to measure, or NULL */
+{
+    Tcl_HashTable *tablePtr;
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch place;
+    Tcl_Obj *objPtr;
+    Var *varPtr;
+    Tcl_WideInt bytes;
+
+    if (nsPtr == NULL) {
+        return 0;
+    }
+    bytes = sizeof(Namespace) + strlen(nsPtr->fullName) + 1;
+    tablePtr = &((Namespace *)nsPtr)->varTable.table;
+    bytes += HashTableBytes(tablePtr, sizeof(VarInHash));
+    for (hPtr = Tcl_FirstHashEntry(tablePtr, &place); hPtr != NULL;
+            hPtr = Tcl_NextHashEntry(&place)) {
+        varPtr = (Var *)((char *)hPtr - offsetof(VarInHash, entry));
+        if (TclIsVarArray(varPtr)) {
+            bytes += sizeof(TclVarHashTable) + HashTableBytes(
+                    &varPtr->value.tablePtr->table, sizeof(VarInHash));
+        } else if (TclIsVarScalar(varPtr) && !TclIsVarLink(varPtr)
+                && !TclIsVarUndefined(varPtr)) {
+            objPtr = varPtr->value.objPtr;
+            bytes += sizeof(Tcl_Obj);
+            if (objPtr->bytes != NULL) {
+                bytes += objPtr->length + 1;
+            }
+        }
+    }
+    return bytes;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddMemStat()
+ *
+ *  Puts one counter into a dict of "itcl::memstats".
+ * ------------------------------------------------------------------------
+ */
+static void
+AddMemStat(
+    Tcl_Obj *dictPtr,         /* dict to add to */
+    const char *name,         /* name of the counter */
+    Tcl_WideInt value)        /* its value */
+{
+    Tcl_DictObjPut(NULL, dictPtr, Tcl_NewStringObj(name, -1),
+            Tcl_NewWideIntObj(value));
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ClassMemStatsObj()
+ *
+ *  Returns the memory counters of one class as a dict:
+ *
+ *    instances   live objects of exactly this class
+ *    peak        highest number of these objects at any one time
+ *    class       bytes of the class record, its tables and members
+ *    objects     bytes of the object records and their variable tables
+ *    varns       bytes of the variable namespaces of the objects
+ *    options     bytes of the option, component, methodvariable and
+ *                delegation tables
+ *    contexts    bytes of the call contexts the objects keep for reuse
+ *    total       the sum of the byte counters
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj *
+ClassMemStatsObj(
+    Tcl_Interp *interp,       /* current interpreter */
+    ItclClass *iclsPtr)       /* class to measure */
+{
+    ItclObject *ioPtr;
+    ItclObjectTables *tablesPtr;
+    ItclClass *iclsPtr2;
+    ItclHierIter hier;
+    Tcl_DString buffer;
+    Tcl_Obj *dictPtr;
+    Tcl_WideInt classBytes;
+    Tcl_WideInt objectBytes;
+    Tcl_WideInt varNsBytes;
+    Tcl_WideInt optionBytes;
+    Tcl_WideInt contextBytes;
+    int prefixLen;
+    int i;
+
+    classBytes = sizeof(ItclClass)
+            + HashTableBytes(&iclsPtr->heritage, sizeof(Tcl_HashEntry))
+            + HashTableBytes(&iclsPtr->variables,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclVariable))
+            + HashTableBytes(&iclsPtr->options,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclOption))
+            + HashTableBytes(&iclsPtr->components,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclComponent))
+            + HashTableBytes(&iclsPtr->functions,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclMemberFunc))
+            + HashTableBytes(&iclsPtr->delegatedOptions,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclDelegatedOption))
+            + HashTableBytes(&iclsPtr->delegatedFunctions,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclDelegatedFunction))
+            + HashTableBytes(&iclsPtr->methodVariables,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclMethodVariable))
+            + HashTableBytes(&iclsPtr->classCommons, sizeof(Tcl_HashEntry))
+            + HashTableBytes(&iclsPtr->resolveVars,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclVarLookup))
+            + HashTableBytes(&iclsPtr->resolveCmds,
+                    sizeof(Tcl_HashEntry) + sizeof(ItclCmdLookup))
+            + HashTableBytes(&iclsPtr->contextCache, sizeof(Tcl_HashEntry))
+            + HashTableBytes(&iclsPtr->resolveCmdNames, sizeof(Tcl_HashEntry))
+            + HashTableBytes(&iclsPtr->resolveCmdCache, sizeof(Tcl_HashEntry))
+            + HashTableBytes(&iclsPtr->configOptions, sizeof(Tcl_HashEntry))
+            + HashTableBytes(&iclsPtr->qualifierClasses,
+                    sizeof(Tcl_HashEntry));
+
+    objectBytes = 0;
+    varNsBytes = 0;
+    optionBytes = 0;
+    contextBytes = 0;
+    Tcl_DStringInit(&buffer);
+    for (ioPtr = iclsPtr->firstInstancePtr; ioPtr != NULL;
+            ioPtr = ioPtr->nextInstancePtr) {
+        objectBytes += sizeof(ItclObject)
+                + ioPtr->numVarSlots * sizeof(ItclVarSlot)
+                + HashTableBytes(&ioPtr->objectVariables,
+                        sizeof(Tcl_HashEntry));
+        tablesPtr = ioPtr->tablesPtr;
+        if (tablesPtr != NULL) {
+            optionBytes += sizeof(ItclObjectTables)
+                    + HashTableBytes(&tablesPtr->objectOptions,
+                            sizeof(Tcl_HashEntry))
+                    + HashTableBytes(&tablesPtr->objectComponents,
+                            sizeof(Tcl_HashEntry))
+                    + HashTableBytes(&tablesPtr->objectMethodVariables,
+                            sizeof(Tcl_HashEntry))
+                    + HashTableBytes(&tablesPtr->objectDelegatedOptions,
+                            sizeof(Tcl_HashEntry))
+                    + HashTableBytes(&tablesPtr->objectDelegatedFunctions,
+                            sizeof(Tcl_HashEntry))
+                    + HashTableBytes(&tablesPtr->delegateTargets,
+                            sizeof(Tcl_HashEntry)
+                            + sizeof(ItclDelegateTarget));
+        }
+        contextBytes += ioPtr->numCallContexts * sizeof(ItclCallContext *);
+        for (i = 0; i < ioPtr->numCallContexts; i++) {
+            if (ioPtr->callContexts[i] != NULL) {
+                contextBytes += sizeof(ItclCallContext);
+            }
+        }
+
+        /*
+         *  The variables of each class in the hierarchy of the object
+         *  live in a namespace of their own below the object's one.
+         */
+        Tcl_DStringSetLength(&buffer, 0);
+        Tcl_DStringAppend(&buffer, Tcl_GetString(ioPtr->varNsNamePtr), -1);
+        varNsBytes += VarNamespaceBytes(Tcl_FindNamespace(interp,
+                Tcl_DStringValue(&buffer), NULL, 0));
+        prefixLen = Tcl_DStringLength(&buffer);
+        Itcl_InitHierIter(&hier, ioPtr->iclsPtr);
+        while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+            Tcl_DStringSetLength(&buffer, prefixLen);
+            Tcl_DStringAppend(&buffer, iclsPtr2->nsPtr->fullName, -1);
+            varNsBytes += VarNamespaceBytes(Tcl_FindNamespace(interp,
+                    Tcl_DStringValue(&buffer), NULL, 0));
+        }
+        Itcl_DeleteHierIter(&hier);
+    }
+    Tcl_DStringFree(&buffer);
+
+    dictPtr = Tcl_NewDictObj();
+    AddMemStat(dictPtr, "instances", iclsPtr->numInstances);
+    AddMemStat(dictPtr, "peak", iclsPtr->peakInstances);
+    AddMemStat(dictPtr, "class", classBytes);
+    AddMemStat(dictPtr, "objects", objectBytes);
+    AddMemStat(dictPtr, "varns", varNsBytes);
+    AddMemStat(dictPtr, "options", optionBytes);
+    AddMemStat(dictPtr, "contexts", contextBytes);
+    AddMemStat(dictPtr, "total", classBytes + objectBytes + varNsBytes
+            + optionBytes + contextBytes);
+    return dictPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_MemStatsCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::memstats" command
+ *  to find out where the memory of classes and objects goes.  The byte
+ *  counts are estimates from the sizes of the records and tables
+ *  involved.  With a class name, returns the counters of that class
+ *  (see ClassMemStatsObj).  Otherwise returns a dict with the keys
+ *  "classes", which maps the full name of each class to its counters,
+ *  "lists", with the list elements in use ("used"), kept for reuse
+ *  ("pooled") and their "bytes", and "alloc", with the blocks from
+ *  Itcl_Alloc() in use ("used", "bytes") and kept for reuse ("pooled",
+ *  "pooledBytes").  The last two are counted for the current thread.
+ *  syntax:
+ *
+ *    itcl::memstats ?className?
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_MemStatsCmd(
+    ClientData clientData,   /* class/object info */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    FOREACH_HASH_DECLS;
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
+    ItclClass *iclsPtr;
+    ItclMemStats stats;
+    Tcl_Obj *classesPtr;
+    Tcl_Obj *dictPtr;
+    Tcl_Obj *resultPtr;
+
+    if (objc > 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "?className?");
+        return TCL_ERROR;
+    }
+    if (objc == 2) {
+        iclsPtr = Itcl_FindClass(interp, Tcl_GetString(objv[1]),
+                /* autoload */ 1);
+        if (iclsPtr == NULL) {
+            return TCL_ERROR;
+        }
+        Tcl_SetObjResult(interp, ClassMemStatsObj(interp, iclsPtr));
+        return TCL_OK;
+    }
+
+    classesPtr = Tcl_NewDictObj();
+    FOREACH_HASH_VALUE(iclsPtr, &infoPtr->nameClasses) {
+        Tcl_DictObjPut(NULL, classesPtr, iclsPtr->fullNamePtr,
+                ClassMemStatsObj(interp, iclsPtr));
+    }
+
+    ItclGetMemStats(&stats);
+    resultPtr = Tcl_NewDictObj();
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("classes", -1),
+            classesPtr);
+    dictPtr = Tcl_NewDictObj();
+    AddMemStat(dictPtr, "used", stats.listElemsUsed);
+    AddMemStat(dictPtr, "pooled", stats.listElemsPooled);
+    AddMemStat(dictPtr, "bytes",
+            (stats.listElemsUsed + stats.listElemsPooled)
+            * stats.listElemSize);
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("lists", -1), dictPtr);
+    dictPtr = Tcl_NewDictObj();
+    AddMemStat(dictPtr, "used", stats.blocksUsed);
+    AddMemStat(dictPtr, "bytes", stats.blockBytesUsed);
+    AddMemStat(dictPtr, "pooled", stats.blocksPooled);
+    AddMemStat(dictPtr, "pooledBytes", stats.blockBytesPooled);
+    Tcl_DictObjPut(NULL, resultPtr, Tcl_NewStringObj("alloc", -1), dictPtr);
+    Tcl_SetObjResult(interp, resultPtr);
+    return TCL_OK;
+}
@@ -19,7 +19,7 @@ ITCLAPI const char *Itcl_InitStubs(
 /* !BEGIN!: Do not edit below this line. */
 
 #define ITCL_STUBS_EPOCH 0
-#define ITCL_STUBS_REVISION 152
+#define ITCL_STUBS_REVISION 157
 
 #ifdef __cplusplus
 extern "C" {
@@ -96,6 +96,22 @@ ITCLAPI void		Itcl_DiscardInterpState(Itcl_InterpState state);
 ITCLAPI void *		Itcl_Alloc(size_t size);
 /* 27 */
 ITCLAPI void		Itcl_Free(void *ptr);
+/* 28 */
+ITCLAPI Itcl_Method	Itcl_GetMethod(Tcl_Interp *interp,
+				const char *className,
+				const char *methodName);
+/* 29 */
+ITCLAPI int		Itcl_InvokeMethod(Tcl_Interp *interp,
+				Itcl_Method method, Tcl_Object object,
+				int objc, Tcl_Obj *const objv[]);
+/* 30 */
+ITCLAPI void		Itcl_ReleaseMethod(Itcl_Method method);
+/* 31 */
+ITCLAPI int		Itcl_RegisterMethodC(Tcl_Interp *interp,
+				const char *name, Itcl_MethodCProc *proc,
+				int minArgs, int maxArgs,
+				ClientData clientData,
+				Tcl_CmdDeleteProc *deleteProc);
 
 typedef struct {
     const struct ItclIntStubs *itclIntStubs;
@@ -135,6 +151,10 @@ typedef struct ItclStubs {
     void (*itcl_DiscardInterpState) (Itcl_InterpState state); /* 25 */
     void * (*itcl_Alloc) (size_t size); /* 26 */
     void (*itcl_Free) (void *ptr); /* 27 */
+    Itcl_Method (*itcl_GetMethod) (Tcl_Interp *interp, const char *className, const char *methodName); /* 28 */
+    int (*itcl_InvokeMethod) (Tcl_Interp *interp, Itcl_Method method, Tcl_Object object, int objc, Tcl_Obj *const objv[]); /* 29 */
+    void (*itcl_ReleaseMethod) (Itcl_Method method); /* 30 */
+    int (*itcl_RegisterMethodC) (Tcl_Interp *interp, const char *name, Itcl_MethodCProc *proc, int minArgs, int maxArgs, ClientData clientData, Tcl_CmdDeleteProc *deleteProc); /* 31 */
 } ItclStubs;
 
 extern const ItclStubs *itclStubsPtr;
@@ -203,6 +223,14 @@ extern const ItclStubs *itclStubsPtr;
 	(itclStubsPtr->itcl_Alloc) /* 26 */
 #define Itcl_Free \
 	(itclStubsPtr->itcl_Free) /* 27 */
+#define Itcl_GetMethod \
+	(itclStubsPtr->itcl_GetMethod) /* 28 */
+#define Itcl_InvokeMethod \
+	(itclStubsPtr->itcl_InvokeMethod) /* 29 */
+#define Itcl_ReleaseMethod \
+	(itclStubsPtr->itcl_ReleaseMethod) /* 30 */
+#define Itcl_RegisterMethodC \
+	(itclStubsPtr->itcl_RegisterMethodC) /* 31 */
 
 #endif /* defined(USE_ITCL_STUBS) */
 
@@ -76,6 +76,8 @@ typedef struct Ensemble {
     Tcl_Namespace *nsPtr;       /* namespace for ensemble part commands */
     int flags;
     Tcl_Obj *namePtr;
+    Tcl_HashTable partTable;    /* the parts again, looked up by their
+                                 * full name */
 } Ensemble;
 
 /*
@@ -784,6 +786,7 @@ CreateEnsemble(
         (unsigned)(ensData->maxParts*sizeof(EnsemblePart*))
     );
     memset(ensData->parts, 0, ensData->maxParts*sizeof(EnsemblePart*));
+    Tcl_InitHashTable(&ensData->partTable, TCL_STRING_KEYS);
     Tcl_DStringInit(&buffer);
     Tcl_DStringAppend(&buffer, ITCL_COMMANDS_NAMESPACE "::ensembles::", -1);
     sprintf(buf, "%d", ensData->ensembleId);
@@ -1017,6 +1020,7 @@ DeleteEnsemble(
     ckfree((char*)ensData->parts);
     ensData->parts = NULL;
     ensData->numParts = 0;
+    Tcl_DeleteHashTable(&ensData->partTable);
     infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(ensData->interp, ITCL_INTERP_DATA, NULL);
     FOREACH_HASH_VALUE(ensData2, &infoPtr->ensembleInfo->ensembles) {
         if (ensData2 == ensData) {
@@ -1163,21 +1167,25 @@ CreateEnsemblePart(
     const char* partName,        /* name of the new part */
     EnsemblePart **ensPartPtr)   /* returns: new ensemble part */
 {
+    Tcl_HashEntry *hPtr;
     int i;
     int pos;
     int size;
+    int isNew;
     EnsemblePart** partList;
     EnsemblePart* ensPart;
 
     /*
      *  If a matching entry was found, then return an error.
      */
-    if (FindEnsemblePartIndex(ensData, partName, &pos)) {
+    hPtr = Tcl_CreateHashEntry(&ensData->partTable, partName, &isNew);
+    if (!isNew) {
         Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
             "part \"", partName, "\" already exists in ensemble",
             NULL);
         return TCL_ERROR;
     }
+    FindEnsemblePartIndex(ensData, partName, &pos);
 
     /*
      *  Otherwise, make room for a new entry.  Keep the parts in
@@ -1208,6 +1216,7 @@ CreateEnsemblePart(
     ensPart->interp = interp;
 
     ensData->parts[pos] = ensPart;
+    Tcl_SetHashValue(hPtr, ensPart);
 
     /*
      *  Compare the new part against the one on either side of
@@ -1309,6 +1318,17 @@ DeleteEnsemblePart(
             ensData->parts[i] = ensData->parts[i+1];
         }
         ensData->numParts--;
+        hPtr = Tcl_FindHashEntry(&ensData->partTable, ensPart->name);
+        if (hPtr != NULL) {
+            Tcl_DeleteHashEntry(hPtr);
+        }
+
+        /*
+         *  The parts around the gap may now be identified with
+         *  fewer letters.
+         */
+        ComputeMinChars(ensData, pos-1);
+        ComputeMinChars(ensData, pos);
     }
 
     /*
@@ -1366,10 +1386,20 @@ FindEnsemblePart(
     const char* partName,     /* name of the desired part */
     EnsemblePart **rensPart)  /* returns:  pointer to the desired part */
 {
+    Tcl_HashEntry *hPtr;
     int pos = 0;
     int first, last, nlen;
     int i, cmp;
 
+    /*
+     *  An exact match always wins, even over longer parts starting
+     *  with the same letters, so try that first.
+     */
+    hPtr = Tcl_FindHashEntry(&ensData->partTable, partName);
+    if (hPtr != NULL) {
+        *rensPart = (EnsemblePart *)Tcl_GetHashValue(hPtr);
+        return TCL_OK;
+    }
     *rensPart = NULL;
 
     /*
@@ -1959,9 +1989,10 @@ Itcl_EnsPartCmd(
      */
     partName = Tcl_GetString(objv[1]);
 
-    if (ItclCreateArgList(interp, Tcl_GetString(objv[2]), &argc, &maxArgc,
-            &usagePtr, &arglistPtr, NULL, partName) != TCL_OK) {
-	result = TCL_ERROR;
+    result = ItclCreateArgList(interp, Tcl_GetString(objv[2]), &argc,
+            &maxArgc, &usagePtr, &arglistPtr, NULL, partName);
+    Tcl_IncrRefCount(usagePtr);
+    if (result != TCL_OK) {
 	goto errorOut;
     }
     if (Tcl_GetCommandInfoFromToken(ensData->cmdPtr, &cmdInfo) != 1) {
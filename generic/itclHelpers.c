@@ -13,6 +13,7 @@
 #include "itclInt.h"
 
 void ItclDeleteArgList(ItclArgList *arglistPtr);
+static void DropDictInfo(ItclClass *iclsPtr);
 #ifdef ITCL_DEBUG
 int _itcl_debug_level = 0;
 
@@ -70,6 +71,11 @@ Itcl_ProtectionStr(
 /*
  * ------------------------------------------------------------------------
  *  ItclCreateArgList()
+ *
+ *  Parses an argument list string.  The parsed list is shared by all
+ *  functions of the interpreter with the same argument list string;
+ *  it is released with ItclDeleteArgList.  The usage message is shared
+ *  as well, the caller has to manage a reference to it.
  * ------------------------------------------------------------------------
  */
 
@@ -89,10 +95,13 @@ ItclCreateArgList(
     int defaultArgc;
     const char **argv;
     const char **defaultArgv;
+    ItclObjectInfo *infoPtr;
+    ItclSharedArgList *sharedPtr;
     ItclArgList *arglistPtr;
     ItclArgList *lastArglistPtr;
     int i;
     int hadArgsArgument;
+    int isNew;
     int result;
     (void)dummy;
 
@@ -103,6 +112,23 @@ ItclCreateArgList(
     result = TCL_OK;
     *maxArgcPtr = 0;
     *argcPtr = 0;
+    infoPtr = NULL;
+    if (str) {
+	infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
+	        ITCL_INTERP_DATA, NULL);
+	if (infoPtr != NULL) {
+	    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->argLists, str);
+	    if (hPtr != NULL) {
+	        sharedPtr = (ItclSharedArgList *)Tcl_GetHashValue(hPtr);
+		sharedPtr->refCount++;
+		*argcPtr = sharedPtr->argc;
+		*maxArgcPtr = sharedPtr->maxArgc;
+		*usagePtr = sharedPtr->usagePtr;
+		*arglistPtrPtr = &sharedPtr->first;
+		return TCL_OK;
+	    }
+	}
+    }
     *usagePtr = Tcl_NewStringObj("", -1);
     if (str) {
         if (Tcl_SplitList(interp, (const char *)str, &argc, &argv)
@@ -112,8 +138,8 @@ ItclCreateArgList(
 	i = 0;
 	if (argc == 0) {
 	   /* signal there are 0 arguments */
-            arglistPtr = (ItclArgList *)ckalloc(sizeof(ItclArgList));
-	    memset(arglistPtr, 0, sizeof(ItclArgList));
+            arglistPtr = (ItclArgList *)ckalloc(sizeof(ItclSharedArgList));
+	    memset(arglistPtr, 0, sizeof(ItclSharedArgList));
 	    *arglistPtrPtr = arglistPtr;
 	}
         while (i < argc) {
@@ -155,11 +181,13 @@ ItclCreateArgList(
 		result = TCL_ERROR;
 		break;
 	    }
-            arglistPtr = (ItclArgList *)ckalloc(sizeof(ItclArgList));
-	    memset(arglistPtr, 0, sizeof(ItclArgList));
             if (*arglistPtrPtr == NULL) {
-	         *arglistPtrPtr = arglistPtr;
+                arglistPtr = (ItclArgList *)ckalloc(sizeof(ItclSharedArgList));
+	        memset(arglistPtr, 0, sizeof(ItclSharedArgList));
+	        *arglistPtrPtr = arglistPtr;
 	    } else {
+                arglistPtr = (ItclArgList *)ckalloc(sizeof(ItclArgList));
+	        memset(arglistPtr, 0, sizeof(ItclArgList));
 	        lastArglistPtr->nextPtr = arglistPtr;
 	        Tcl_AppendToObj(*usagePtr, " ", 1);
 	    }
@@ -202,12 +230,32 @@ ItclCreateArgList(
     if (hadArgsArgument) {
         *maxArgcPtr = -1;
     }
+    if ((result == TCL_OK) && (*arglistPtrPtr != NULL)) {
+	/*
+	 *  Remember the list for the next function with the same
+	 *  argument list string.
+	 */
+        sharedPtr = (ItclSharedArgList *)*arglistPtrPtr;
+	sharedPtr->refCount = 1;
+	sharedPtr->argc = *argcPtr;
+	sharedPtr->maxArgc = *maxArgcPtr;
+	sharedPtr->usagePtr = *usagePtr;
+	Tcl_IncrRefCount(sharedPtr->usagePtr);
+	if (infoPtr != NULL) {
+	    sharedPtr->hPtr = Tcl_CreateHashEntry(&infoPtr->argLists, str,
+	            &isNew);
+	    Tcl_SetHashValue(sharedPtr->hPtr, sharedPtr);
+	}
+    }
     return result;
 }
 
 /*
  * ------------------------------------------------------------------------
  *  ItclDeleteArgList()
+ *
+ *  Releases an argument list from ItclCreateArgList.  The list is
+ *  freed when its last user releases it.
  * ------------------------------------------------------------------------
  */
 
@@ -215,9 +263,23 @@ void
 ItclDeleteArgList(
     ItclArgList *arglistPtr)	/* first argument in arg list chain */
 {
+    ItclSharedArgList *sharedPtr;
     ItclArgList *currPtr;
     ItclArgList *nextPtr;
 
+    if (arglistPtr == NULL) {
+        return;
+    }
+    sharedPtr = (ItclSharedArgList *)arglistPtr;
+    if (sharedPtr->refCount > 0) {
+        if (--sharedPtr->refCount > 0) {
+	    return;
+	}
+	if (sharedPtr->hPtr != NULL) {
+	    Tcl_DeleteHashEntry(sharedPtr->hPtr);
+	}
+	Tcl_DecrRefCount(sharedPtr->usagePtr);
+    }
     for (currPtr=arglistPtr; currPtr; currPtr=nextPtr) {
 	if (currPtr->defaultValuePtr != NULL) {
 	    Tcl_DecrRefCount(currPtr->defaultValuePtr);
@@ -230,6 +292,32 @@ ItclDeleteArgList(
     }
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFinishArgLists()
+ *
+ *  Called when the interpreter is deleted.  Argument lists that are
+ *  still in use are no longer shared, their users free them.
+ * ------------------------------------------------------------------------
+ */
+
+void
+ItclFinishArgLists(
+    ItclObjectInfo *infoPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch place;
+    ItclSharedArgList *sharedPtr;
+
+    hPtr = Tcl_FirstHashEntry(&infoPtr->argLists, &place);
+    while (hPtr != NULL) {
+        sharedPtr = (ItclSharedArgList *)Tcl_GetHashValue(hPtr);
+	sharedPtr->hPtr = NULL;
+        hPtr = Tcl_NextHashEntry(&place);
+    }
+    Tcl_DeleteHashTable(&infoPtr->argLists);
+}
+
 
 /*
  * ------------------------------------------------------------------------
@@ -428,11 +516,11 @@ AddDictEntry(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassesDictInfo()
+ *  AddClassesDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassesDictInfo(
+static int
+AddClassesDictInfo(
     Tcl_Interp *interp,
     ItclClass *iclsPtr)
 {
@@ -571,6 +659,11 @@ ItclDeleteClassesDictInfo(
 	    break;
 	}
     }
+    DropDictInfo(iclsPtr);
+    if (!(iclsPtr->infoPtr->dictInfoFlags & ITCL_DICTS_READ)) {
+	/* the dicts were never generated, so the class is not in there */
+        return TCL_OK;
+    }
     if (! found) {
 	Tcl_AppendResult(interp, "ItclDeleteClassesDictInfo bad class ",
 	        "type for class \"", Tcl_GetString(iclsPtr->fullNamePtr),
@@ -617,158 +710,66 @@ ItclDeleteClassesDictInfo(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddObjectsDictInfo()
+ *  AddObjectDictInfo()
+ *
+ *  Adds the entry for one object to the "instances" dict of
+ *  ::itcl::internal::dicts::objects.
  * ------------------------------------------------------------------------
  */
-int
-ItclAddObjectsDictInfo(
+static int
+AddObjectDictInfo(
     Tcl_Interp *interp,
+    Tcl_Obj *instancesPtr,
     ItclObject *ioPtr)
 {
-    Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *keyPtr1;
-    Tcl_Obj *valuePtr1;
     Tcl_Obj *valuePtr2;
     Tcl_Obj *objPtr;
-    int newValue1;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::objects", NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::objects", NULL);
-	return TCL_ERROR;
-    }
-    keyPtr1 = Tcl_NewStringObj("instances", -1);
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr1, &valuePtr1) != TCL_OK) {
-        return TCL_ERROR;
-    }
-    newValue1 = 0;
-    if (valuePtr1 == NULL) {
-        newValue1 = 1;
-        valuePtr1 = Tcl_NewDictObj();
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
-        return TCL_ERROR;
-    }
-    if (valuePtr2 == NULL) {
-        if (Tcl_DictObjRemove(interp, valuePtr1, keyPtr) != TCL_OK) {
-            return TCL_ERROR;
-        }
-    }
     valuePtr2 = Tcl_NewDictObj();
     if (AddDictEntry(interp, valuePtr2, "-name", ioPtr->namePtr) != TCL_OK) {
-        return TCL_ERROR;
+        goto error;
     }
     if (AddDictEntry(interp, valuePtr2, "-origname", ioPtr->namePtr)
             != TCL_OK) {
-        return TCL_ERROR;
+        goto error;
     }
     if (AddDictEntry(interp, valuePtr2, "-class", ioPtr->iclsPtr->fullNamePtr)
             != TCL_OK) {
-        return TCL_ERROR;
+        goto error;
     }
     if (ioPtr->hullWindowNamePtr != NULL) {
         if (AddDictEntry(interp, valuePtr2, "-hullwindow",
 	        ioPtr->hullWindowNamePtr) != TCL_OK) {
-            return TCL_ERROR;
+            goto error;
         }
     }
     if (AddDictEntry(interp, valuePtr2, "-varns", ioPtr->varNsNamePtr)
             != TCL_OK) {
-        return TCL_ERROR;
+        goto error;
     }
     objPtr = Tcl_NewObj();
     Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
     if (AddDictEntry(interp, valuePtr2, "-command", objPtr) != TCL_OK) {
 	Tcl_DecrRefCount(objPtr);
-        return TCL_ERROR;
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjPut(interp, valuePtr1, keyPtr, valuePtr2) != TCL_OK) {
-        return TCL_ERROR;
+        goto error;
     }
-    if (newValue1) {
-	/* Cannot fail. Screened non-dicts earlier. */
-        Tcl_DictObjPut(interp, dictPtr, keyPtr1, valuePtr1);
-    } else {
-	/* Don't leak the key val... */
-	Tcl_DecrRefCount(keyPtr1);
+    if (Tcl_DictObjPut(interp, instancesPtr, ioPtr->namePtr, valuePtr2)
+            != TCL_OK) {
+        goto error;
     }
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects",
-            NULL, dictPtr, 0);
     return TCL_OK;
+error:
+    Tcl_DecrRefCount(valuePtr2);
+    return TCL_ERROR;
 }
-
-/*
- * ------------------------------------------------------------------------
- *  ItclDeleteObjectsDictInfo()
- * ------------------------------------------------------------------------
- */
-int
-ItclDeleteObjectsDictInfo(
-    Tcl_Interp *interp,
-    ItclObject *ioPtr)
-{
-    Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *keyPtr1;
-    Tcl_Obj *valuePtr;
-    Tcl_Obj *valuePtr1;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-             ITCL_NAMESPACE"::internal::dicts::objects", NULL, 0);
-    if (dictPtr == NULL) {
-        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-	        "::internal::dicts::objects", NULL);
-	return TCL_ERROR;
-    }
-    keyPtr1 = Tcl_NewStringObj("instances", -1);
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr1, &valuePtr) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
-    }
-    if (valuePtr == NULL) {
-	/* looks like no object has been registered yet
-	 * so ignore and return OK */
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_OK;
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr, keyPtr, &valuePtr1) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
-    }
-    if (valuePtr1 == NULL) {
-	/* looks like the object has not been constructed successfully
-	 * so ignore and return OK */
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_OK;
-    }
-    if (Tcl_DictObjRemove(interp, valuePtr, keyPtr) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
-    }
-    if (Tcl_DictObjPut(interp, dictPtr, keyPtr1, valuePtr) != TCL_OK) {
-	/* This is very likely impossible. non-dict already screened. */
-	Tcl_DecrRefCount(keyPtr1);
-        return TCL_ERROR;
-    }
-    Tcl_DecrRefCount(keyPtr1);
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects",
-            NULL, dictPtr, 0);
-    return TCL_OK;
-}
-
 /*
  * ------------------------------------------------------------------------
- *  ItclAddOptionDictInfo()
+ *  AddOptionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddOptionDictInfo(
+static int
+AddOptionDictInfo(
     Tcl_Interp *interp,
     ItclClass *iclsPtr,
     ItclOption *ioptPtr)
@@ -884,11 +885,11 @@ ItclAddOptionDictInfo(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddDelegatedOptionDictInfo()
+ *  AddDelegatedOptionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddDelegatedOptionDictInfo(
+static int
+AddDelegatedOptionDictInfo(
     Tcl_Interp *interp,
     ItclClass *iclsPtr,
     ItclDelegatedOption *idoPtr)
@@ -988,11 +989,11 @@ ItclAddDelegatedOptionDictInfo(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassComponentDictInfo()
+ *  AddClassComponentDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassComponentDictInfo(
+static int
+AddClassComponentDictInfo(
     Tcl_Interp *interp,
     ItclClass *iclsPtr,
     ItclComponent *icPtr)
@@ -1080,11 +1081,11 @@ ItclAddClassComponentDictInfo(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassVariableDictInfo()
+ *  AddClassVariableDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassVariableDictInfo(
+static int
+AddClassVariableDictInfo(
     Tcl_Interp *interp,
     ItclClass *iclsPtr,
     ItclVariable *ivPtr)
@@ -1232,11 +1233,11 @@ ItclAddClassVariableDictInfo(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassFunctionDictInfo()
+ *  AddClassFunctionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassFunctionDictInfo(
+static int
+AddClassFunctionDictInfo(
     Tcl_Interp *interp,
     ItclClass *iclsPtr,
     ItclMemberFunc *imPtr)
@@ -1392,11 +1393,11 @@ ItclAddClassFunctionDictInfo(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddClassDelegatedFunctionDictInfo()
+ *  AddClassDelegatedFunctionDictInfo()
  * ------------------------------------------------------------------------
  */
-int
-ItclAddClassDelegatedFunctionDictInfo(
+static int
+AddClassDelegatedFunctionDictInfo(
     Tcl_Interp *interp,
     ItclClass *iclsPtr,
     ItclDelegatedFunction *idmPtr)
@@ -1490,3 +1491,389 @@ ItclAddClassDelegatedFunctionDictInfo(
             NULL, dictPtr, 0);
     return TCL_OK;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  The dicts in ::itcl::internal::dicts mirror the class and object
+ *  definitions for the Tcl coded parts of itcl (itclWidget.tcl and
+ *  itclHullCmds.tcl); the C code never reads them.  So the entries are
+ *  not written when a class, member or object is defined.  The class
+ *  and member entries are queued in infoPtr->dictInfo and the objects
+ *  dict is only marked out of date.  A read trace on the dict variables
+ *  then brings them up to date the first time they are read.
+ * ------------------------------------------------------------------------
+ */
+
+typedef struct ItclDictInfo {
+    int type;                   /* ITCL_DICT_* value below */
+    ItclClass *iclsPtr;         /* class the entry is for */
+    void *memberPtr;            /* member the entry is for, NULL for
+                                 * ITCL_DICT_CLASS */
+} ItclDictInfo;
+
+#define ITCL_DICT_CLASS               1
+#define ITCL_DICT_OPTION              2
+#define ITCL_DICT_DELEGATED_OPTION    3
+#define ITCL_DICT_COMPONENT           4
+#define ITCL_DICT_VARIABLE            5
+#define ITCL_DICT_FUNCTION            6
+#define ITCL_DICT_DELEGATED_FUNCTION  7
+
+static const char *dictVarNames[] = {
+    ITCL_NAMESPACE"::internal::dicts::classes",
+    ITCL_NAMESPACE"::internal::dicts::objects",
+    ITCL_NAMESPACE"::internal::dicts::classOptions",
+    ITCL_NAMESPACE"::internal::dicts::classDelegatedOptions",
+    ITCL_NAMESPACE"::internal::dicts::classComponents",
+    ITCL_NAMESPACE"::internal::dicts::classVariables",
+    ITCL_NAMESPACE"::internal::dicts::classFunctions",
+    ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions",
+    NULL
+};
+
+/*
+ * ------------------------------------------------------------------------
+ *  QueueDictInfo()
+ * ------------------------------------------------------------------------
+ */
+static int
+QueueDictInfo(
+    ItclClass *iclsPtr,
+    int type,
+    void *memberPtr)
+{
+    ItclObjectInfo *infoPtr = iclsPtr->infoPtr;
+    ItclDictInfo *recPtr;
+
+    if (infoPtr->numDictInfo == infoPtr->maxDictInfo) {
+	if (infoPtr->dictInfo == NULL) {
+	    infoPtr->maxDictInfo = 64;
+	    infoPtr->dictInfo = (ItclDictInfo *)ckalloc(
+	            infoPtr->maxDictInfo * sizeof(ItclDictInfo));
+	} else {
+	    infoPtr->maxDictInfo *= 2;
+	    infoPtr->dictInfo = (ItclDictInfo *)ckrealloc(
+	            (char *)infoPtr->dictInfo,
+	            infoPtr->maxDictInfo * sizeof(ItclDictInfo));
+	}
+    }
+    recPtr = infoPtr->dictInfo + infoPtr->numDictInfo++;
+    recPtr->type = type;
+    recPtr->iclsPtr = iclsPtr;
+    recPtr->memberPtr = memberPtr;
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  DropDictInfo()
+ *
+ *  Forgets the queued entries of a class that is going away.
+ * ------------------------------------------------------------------------
+ */
+static void
+DropDictInfo(
+    ItclClass *iclsPtr)
+{
+    ItclObjectInfo *infoPtr = iclsPtr->infoPtr;
+    int i;
+    int j;
+
+    j = 0;
+    for (i = 0; i < infoPtr->numDictInfo; i++) {
+	if (infoPtr->dictInfo[i].iclsPtr != iclsPtr) {
+	    infoPtr->dictInfo[j++] = infoPtr->dictInfo[i];
+	}
+    }
+    infoPtr->numDictInfo = j;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  RebuildObjectsDictInfo()
+ *
+ *  Regenerates the "instances" entry of ::itcl::internal::dicts::objects
+ *  from the objects that are currently fully constructed.
+ * ------------------------------------------------------------------------
+ */
+static int
+RebuildObjectsDictInfo(
+    Tcl_Interp *interp,
+    ItclObjectInfo *infoPtr)
+{
+    FOREACH_HASH_DECLS;
+    Tcl_Obj *dictPtr;
+    Tcl_Obj *keyPtr;
+    Tcl_Obj *instancesPtr;
+    ItclObject *ioPtr;
+
+    dictPtr = Tcl_GetVar2Ex(interp,
+             ITCL_NAMESPACE"::internal::dicts::objects", NULL, 0);
+    if (dictPtr == NULL) {
+        Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
+	        "::internal::dicts::objects", NULL);
+	return TCL_ERROR;
+    }
+    if (Tcl_IsShared(dictPtr)) {
+        dictPtr = Tcl_DuplicateObj(dictPtr);
+    }
+    instancesPtr = Tcl_NewDictObj();
+    FOREACH_HASH_VALUE(ioPtr, &infoPtr->objects) {
+	if ((ioPtr->constructed != NULL) || (ioPtr->accessCmd == NULL)) {
+	    /* not (or no longer) a complete object */
+	    continue;
+	}
+	if (AddObjectDictInfo(interp, instancesPtr, ioPtr) != TCL_OK) {
+	    Tcl_DecrRefCount(instancesPtr);
+	    return TCL_ERROR;
+	}
+    }
+    keyPtr = Tcl_NewStringObj("instances", -1);
+    Tcl_IncrRefCount(keyPtr);
+    if (Tcl_DictObjPut(interp, dictPtr, keyPtr, instancesPtr) != TCL_OK) {
+	Tcl_DecrRefCount(keyPtr);
+	Tcl_DecrRefCount(instancesPtr);
+        return TCL_ERROR;
+    }
+    Tcl_DecrRefCount(keyPtr);
+    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects",
+            NULL, dictPtr, 0);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFlushDictInfo()
+ *
+ *  Writes all queued entries to the dicts in ::itcl::internal::dicts,
+ *  in the order they were queued.  Errors are ignored as they were
+ *  when the entries were written right away.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFlushDictInfo(
+    Tcl_Interp *interp,
+    ItclObjectInfo *infoPtr)
+{
+    Tcl_InterpState state;
+    ItclDictInfo *recPtr;
+    int i;
+
+    if (infoPtr->dictInfoFlags & ITCL_DICTS_FLUSHING) {
+	/* the read traces fire for the variables we update ourselves */
+        return;
+    }
+    infoPtr->dictInfoFlags |= ITCL_DICTS_READ;
+    if ((infoPtr->numDictInfo == 0)
+            && !(infoPtr->dictInfoFlags & ITCL_DICTS_OBJECTS_CHANGED)) {
+        return;
+    }
+    infoPtr->dictInfoFlags |= ITCL_DICTS_FLUSHING;
+    state = Tcl_SaveInterpState(interp, TCL_OK);
+    for (i = 0; i < infoPtr->numDictInfo; i++) {
+	recPtr = infoPtr->dictInfo + i;
+	switch (recPtr->type) {
+	case ITCL_DICT_CLASS:
+	    AddClassesDictInfo(interp, recPtr->iclsPtr);
+	    break;
+	case ITCL_DICT_OPTION:
+	    AddOptionDictInfo(interp, recPtr->iclsPtr,
+	            (ItclOption *)recPtr->memberPtr);
+	    break;
+	case ITCL_DICT_DELEGATED_OPTION:
+	    AddDelegatedOptionDictInfo(interp, recPtr->iclsPtr,
+	            (ItclDelegatedOption *)recPtr->memberPtr);
+	    break;
+	case ITCL_DICT_COMPONENT:
+	    AddClassComponentDictInfo(interp, recPtr->iclsPtr,
+	            (ItclComponent *)recPtr->memberPtr);
+	    break;
+	case ITCL_DICT_VARIABLE:
+	    AddClassVariableDictInfo(interp, recPtr->iclsPtr,
+	            (ItclVariable *)recPtr->memberPtr);
+	    break;
+	case ITCL_DICT_FUNCTION:
+	    AddClassFunctionDictInfo(interp, recPtr->iclsPtr,
+	            (ItclMemberFunc *)recPtr->memberPtr);
+	    break;
+	case ITCL_DICT_DELEGATED_FUNCTION:
+	    AddClassDelegatedFunctionDictInfo(interp, recPtr->iclsPtr,
+	            (ItclDelegatedFunction *)recPtr->memberPtr);
+	    break;
+	}
+    }
+    infoPtr->numDictInfo = 0;
+    if (infoPtr->dictInfoFlags & ITCL_DICTS_OBJECTS_CHANGED) {
+	infoPtr->dictInfoFlags &= ~ITCL_DICTS_OBJECTS_CHANGED;
+        RebuildObjectsDictInfo(interp, infoPtr);
+    }
+    Tcl_RestoreInterpState(interp, state);
+    infoPtr->dictInfoFlags &= ~ITCL_DICTS_FLUSHING;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  DictInfoReadTrace()
+ * ------------------------------------------------------------------------
+ */
+static char *
+DictInfoReadTrace(
+    ClientData clientData,
+    Tcl_Interp *interp,
+    const char *name1,
+    const char *name2,
+    int flags)
+{
+    if (!(flags & TCL_INTERP_DESTROYED)) {
+        ItclFlushDictInfo(interp, (ItclObjectInfo *)clientData);
+    }
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInitDictInfo()
+ *
+ *  Creates the (empty) dicts in ::itcl::internal::dicts and the traces
+ *  that fill them in on demand.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclInitDictInfo(
+    Tcl_Interp *interp,
+    ItclObjectInfo *infoPtr)
+{
+    const char **namePtr;
+
+    for (namePtr = dictVarNames; *namePtr != NULL; namePtr++) {
+	Tcl_SetVar2(interp, *namePtr, NULL, "", 0);
+	Tcl_TraceVar2(interp, *namePtr, NULL,
+	        TCL_GLOBAL_ONLY|TCL_TRACE_READS, DictInfoReadTrace, infoPtr);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFinishDictInfo()
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFinishDictInfo(
+    Tcl_Interp *interp,
+    ItclObjectInfo *infoPtr)
+{
+    const char **namePtr;
+
+    for (namePtr = dictVarNames; *namePtr != NULL; namePtr++) {
+	Tcl_UntraceVar2(interp, *namePtr, NULL,
+	        TCL_GLOBAL_ONLY|TCL_TRACE_READS, DictInfoReadTrace, infoPtr);
+    }
+    if (infoPtr->dictInfo != NULL) {
+	ckfree((char *)infoPtr->dictInfo);
+	infoPtr->dictInfo = NULL;
+    }
+    infoPtr->numDictInfo = 0;
+    infoPtr->maxDictInfo = 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclAddClassesDictInfo()
+ *  ItclAddOptionDictInfo()
+ *  ItclAddDelegatedOptionDictInfo()
+ *  ItclAddClassComponentDictInfo()
+ *  ItclAddClassVariableDictInfo()
+ *  ItclAddClassFunctionDictInfo()
+ *  ItclAddClassDelegatedFunctionDictInfo()
+ *
+ *  Queue the entry for a class or member, see ItclFlushDictInfo().
+ * ------------------------------------------------------------------------
+ */
+int
+ItclAddClassesDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_CLASS, NULL);
+}
+
+int
+ItclAddOptionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclOption *ioptPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_OPTION, ioptPtr);
+}
+
+int
+ItclAddDelegatedOptionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclDelegatedOption *idoPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_DELEGATED_OPTION, idoPtr);
+}
+
+int
+ItclAddClassComponentDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclComponent *icPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_COMPONENT, icPtr);
+}
+
+int
+ItclAddClassVariableDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclVariable *ivPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_VARIABLE, ivPtr);
+}
+
+int
+ItclAddClassFunctionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclMemberFunc *imPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_FUNCTION, imPtr);
+}
+
+int
+ItclAddClassDelegatedFunctionDictInfo(
+    Tcl_Interp *interp,
+    ItclClass *iclsPtr,
+    ItclDelegatedFunction *idmPtr)
+{
+    return QueueDictInfo(iclsPtr, ITCL_DICT_DELEGATED_FUNCTION, idmPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclAddObjectsDictInfo()
+ *  ItclDeleteObjectsDictInfo()
+ *
+ *  Mark ::itcl::internal::dicts::objects as out of date, it is rebuilt
+ *  when it is read next.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclAddObjectsDictInfo(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr)
+{
+    ioPtr->infoPtr->dictInfoFlags |= ITCL_DICTS_OBJECTS_CHANGED;
+    return TCL_OK;
+}
+
+int
+ItclDeleteObjectsDictInfo(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr)
+{
+    ioPtr->infoPtr->dictInfoFlags |= ITCL_DICTS_OBJECTS_CHANGED;
+    return TCL_OK;
+}
@@ -319,25 +319,8 @@ InfoGutsFinish(
     Tcl_CallFrame *framePtr = (Tcl_CallFrame *) data[0];
     ItclObjectInfo *infoPtr = (ItclObjectInfo *) data[1];
     ItclCallContext *cPtr = (ItclCallContext *) data[2];
-    ItclCallContext *popped;
 
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *) framePtr);
-
-    Itcl_Stack *stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-
-    popped = (ItclCallContext *)Itcl_PopStack(stackPtr);
-
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	ckfree((char *)stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
-
-    if (cPtr != popped) {
-	Tcl_Panic("Context stack mismatch!");
-    }
-    ckfree((char *) cPtr);
+    ItclPopFrameContext(infoPtr, framePtr, cPtr);
 
     return result;
 }
@@ -353,9 +336,6 @@ ItclInfoGuts(
     Tcl_CmdInfo info;
     ItclCallContext *cPtr;
     Tcl_CallFrame *framePtr;
-    Tcl_HashEntry *hPtr;
-    Itcl_Stack *stackPtr;
-    int isNew;
 
     if (objc == 2) {
 	/*
@@ -372,23 +352,9 @@ ItclInfoGuts(
 
     framePtr = Itcl_GetUplevelCallFrame(interp, 0);
 
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext, (char *)framePtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *) ckalloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-	Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-    }
-
-    cPtr = (ItclCallContext *) ckalloc(sizeof(ItclCallContext));
+    cPtr = ItclPushFrameContext(infoPtr, framePtr);
     cPtr->objectFlags = ITCL_OBJECT_ROOT_METHOD;
-    cPtr->nsPtr = NULL;
     cPtr->ioPtr = ioPtr;
-    cPtr->imPtr = NULL;
-    cPtr->refCount = 1;
-
-    Itcl_PushStack(cPtr, stackPtr);
 
     Tcl_NRAddCallback(interp, InfoGutsFinish, framePtr, infoPtr, cPtr, NULL);
     Tcl_GetCommandInfoFromToken(infoPtr->infoCmd, &info);
@@ -1003,6 +969,137 @@ Itcl_BiInfoHeritageCmd(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  FunctionInfoFields()
+ *
+ *  Returns the fields iflist[0..objc-1] of "info function" for the
+ *  member function imPtr: the field itself if only one is asked for,
+ *  a list of them otherwise.
+ * ------------------------------------------------------------------------
+ */
+static const char *functionInfoOptions[] = {
+    "-args", "-body", "-name", "-protection", "-type",
+    NULL
+};
+enum BIfIdx {
+    BIfArgsIdx, BIfBodyIdx, BIfNameIdx, BIfProtectIdx, BIfTypeIdx
+};
+
+static Tcl_Obj *
+FunctionInfoFields(
+    ItclMemberFunc *imPtr,   /* member function to report */
+    int objc,                /* number of fields */
+    enum BIfIdx *iflist)     /* fields to report */
+{
+    Tcl_Obj *resultPtr = NULL;
+    Tcl_Obj *objPtr = NULL;
+    ItclMemberCode *mcode;
+    const char *val;
+    int i;
+
+    mcode = imPtr->codePtr;
+    if (objc > 1) {
+        resultPtr = Tcl_NewListObj(0, NULL);
+    }
+
+    for (i=0 ; i < objc; i++) {
+        switch (iflist[i]) {
+            case BIfArgsIdx:
+                if (mcode && mcode->argListPtr) {
+                    if (imPtr->usagePtr == NULL) {
+                        objPtr = Tcl_NewStringObj(
+                                Tcl_GetString(mcode->usagePtr), -1);
+                    } else {
+                        objPtr = Tcl_NewStringObj(
+                                Tcl_GetString(imPtr->usagePtr), -1);
+                    }
+                } else {
+                    if ((imPtr->flags & ITCL_ARG_SPEC) != 0) {
+                        if (imPtr->usagePtr == NULL) {
+                            objPtr = Tcl_NewStringObj(
+                                    Tcl_GetString(mcode->usagePtr), -1);
+                        } else {
+                            objPtr = Tcl_NewStringObj(
+                                    Tcl_GetString(imPtr->usagePtr), -1);
+                        }
+                    } else {
+                        objPtr = Tcl_NewStringObj("<undefined>", -1);
+                    }
+                }
+                break;
+
+            case BIfBodyIdx:
+                if (mcode && Itcl_IsMemberCodeImplemented(mcode)) {
+                    objPtr = Tcl_NewStringObj(
+                            Tcl_GetString(mcode->bodyPtr), -1);
+                } else {
+                    objPtr = Tcl_NewStringObj("<undefined>", -1);
+                }
+                break;
+
+            case BIfNameIdx:
+                objPtr = Tcl_NewStringObj(
+                        Tcl_GetString(imPtr->fullNamePtr), -1);
+                break;
+
+            case BIfProtectIdx:
+                val = Itcl_ProtectionStr(imPtr->protection);
+                objPtr = Tcl_NewStringObj(val, -1);
+                break;
+
+            case BIfTypeIdx:
+                val = ((imPtr->flags & ITCL_COMMON) != 0)
+                    ? "proc" : "method";
+                objPtr = Tcl_NewStringObj(val, -1);
+                break;
+        }
+
+        if (objc == 1) {
+            resultPtr = objPtr;
+        } else {
+            Tcl_ListObjAppendElement(NULL, resultPtr, objPtr);
+        }
+    }
+    return resultPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FunctionIsListed()
+ *
+ *  Returns non-zero if "info function" without a name reports the
+ *  member function imPtr.  Some of the built-in methods are known
+ *  only to some kinds of classes.
+ * ------------------------------------------------------------------------
+ */
+static int
+FunctionIsListed(
+    ItclMemberFunc *imPtr)   /* member function to check */
+{
+    const char *name;
+
+    if ((imPtr->codePtr == NULL)
+            || !(imPtr->codePtr->flags & ITCL_BUILTIN)) {
+        return 1;
+    }
+    name = Tcl_GetString(imPtr->namePtr);
+    if (strcmp(name, "info") == 0) {
+        return 0;
+    }
+    if (strcmp(name, "setget") == 0) {
+        if (!(imPtr->iclsPtr->flags & ITCL_ECLASS)) {
+            return 0;
+        }
+    }
+    if (strcmp(name, "installcomponent") == 0) {
+        if (!(imPtr->iclsPtr->flags & (ITCL_WIDGET|ITCL_WIDGETADAPTOR))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BiInfoFunctionCmd()
@@ -1013,8 +1110,10 @@ Itcl_BiInfoHeritageCmd(
  *    info function ?cmdName? ?-protection? ?-type? ?-name? ?-args? ?-body?
  *
  *  If the ?cmdName? is not specified, then a list of all known
- *  command members is returned.  Otherwise, the information for
- *  a specific command is returned.  Returns a status TCL_OK/TCL_ERROR
+ *  command members is returned.  With flags but no ?cmdName?, the
+ *  requested information is returned for each of them, so that a
+ *  whole class can be queried in one call.  Otherwise, the information
+ *  for a specific command is returned.  Returns a status TCL_OK/TCL_ERROR
  *  to indicate success/failure.
  * ------------------------------------------------------------------------
  */
@@ -1030,13 +1129,7 @@ Itcl_BiInfoFunctionCmd(
     Tcl_Obj *resultPtr = NULL;
     Tcl_Obj *objPtr = NULL;
 
-    static const char *options[] = {
-        "-args", "-body", "-name", "-protection", "-type",
-        NULL
-    };
-    enum BIfIdx {
-        BIfArgsIdx, BIfBodyIdx, BIfNameIdx, BIfProtectIdx, BIfTypeIdx
-    } *iflist, iflistStorage[5];
+    enum BIfIdx *iflist, iflistStorage[5];
 
     static enum BIfIdx DefInfoFunction[5] = {
         BIfProtectIdx,
@@ -1051,12 +1144,11 @@ Itcl_BiInfoFunctionCmd(
 
     ItclClass *iclsPtr;
     int i;
+    int idx;
     int result;
-    const char *val;
     Tcl_HashSearch place;
     Tcl_HashEntry *entry;
     ItclMemberFunc *imPtr;
-    ItclMemberCode *mcode;
     ItclHierIter hier;
 
     ItclShowArgs(2, "Itcl_InfoFunctionCmd", objc, objv);
@@ -1084,7 +1176,32 @@ Itcl_BiInfoFunctionCmd(
 
     if (objc > 0) {
         cmdName = Tcl_GetString(*objv);
-        objc--; objv++;
+        if ((*cmdName == '-') && (Tcl_GetIndexFromObjStruct(NULL, *objv,
+                functionInfoOptions, sizeof(char *), "option", 0,
+		&idx) == TCL_OK)) {
+            cmdName = NULL;
+        } else {
+            objc--; objv++;
+        }
+    }
+
+    /*
+     *  Scan through all remaining flags and figure out what to return.
+     */
+    iflist = &iflistStorage[0];
+    if (objc > 5) {
+        iflist = (enum BIfIdx *)ckalloc(objc * sizeof(enum BIfIdx));
+    }
+    for (i=0 ; i < objc; i++) {
+        result = Tcl_GetIndexFromObjStruct(interp, objv[i],
+            functionInfoOptions, sizeof(char *), "option", 0, &idx);
+        if (result != TCL_OK) {
+            if (iflist != &iflistStorage[0]) {
+                ckfree((char *)iflist);
+            }
+            return TCL_ERROR;
+        }
+        iflist[i] = (enum BIfIdx)idx;
     }
 
     /*
@@ -1101,102 +1218,29 @@ Itcl_BiInfoFunctionCmd(
                 "\"", cmdName, "\" isn't a member function in class \"",
                 contextIclsPtr->nsPtr->fullName, "\"",
                 NULL);
+            if (iflist != &iflistStorage[0]) {
+                ckfree((char *)iflist);
+            }
             return TCL_ERROR;
         }
 
 	clookup = (ItclCmdLookup *)Tcl_GetHashValue(entry);
 	imPtr = clookup->imPtr;
-        mcode = imPtr->codePtr;
 
         /*
          *  By default, return everything.
          */
         if (objc == 0) {
-            objc = 5;
-            iflist = DefInfoFunction;
+            resultPtr = FunctionInfoFields(imPtr, 5, DefInfoFunction);
         } else {
-
-            /*
-             *  Otherwise, scan through all remaining flags and
-             *  figure out what to return.
-             */
-            iflist = &iflistStorage[0];
-            for (i=0 ; i < objc; i++) {
-                result = Tcl_GetIndexFromObjStruct(interp, objv[i],
-                    options, sizeof(char *), "option", 0, (int*)(&iflist[i]));
-                if (result != TCL_OK) {
-                    return TCL_ERROR;
-                }
-            }
-        }
-
-        if (objc > 1) {
-            resultPtr = Tcl_NewListObj(0, NULL);
-        }
-
-        for (i=0 ; i < objc; i++) {
-            switch (iflist[i]) {
-                case BIfArgsIdx:
-                    if (mcode && mcode->argListPtr) {
-			if (imPtr->usagePtr == NULL) {
-                            objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(mcode->usagePtr), -1);
-			} else {
-                            objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(imPtr->usagePtr), -1);
-		        }
-                    } else {
-		        if ((imPtr->flags & ITCL_ARG_SPEC) != 0) {
-			    if (imPtr->usagePtr == NULL) {
-                                objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(mcode->usagePtr), -1);
-			    } else {
-			        objPtr = Tcl_NewStringObj(
-				        Tcl_GetString(imPtr->usagePtr), -1);
-			    }
-                        } else {
-                            objPtr = Tcl_NewStringObj("<undefined>", -1);
-                        }
-		    }
-                    break;
-
-                case BIfBodyIdx:
-                    if (mcode && Itcl_IsMemberCodeImplemented(mcode)) {
-                        objPtr = Tcl_NewStringObj(
-			        Tcl_GetString(mcode->bodyPtr), -1);
-                    } else {
-                        objPtr = Tcl_NewStringObj("<undefined>", -1);
-                    }
-                    break;
-
-                case BIfNameIdx:
-                    objPtr = Tcl_NewStringObj(
-		            Tcl_GetString(imPtr->fullNamePtr), -1);
-                    break;
-
-                case BIfProtectIdx:
-                    val = Itcl_ProtectionStr(imPtr->protection);
-                    objPtr = Tcl_NewStringObj(val, -1);
-                    break;
-
-                case BIfTypeIdx:
-                    val = ((imPtr->flags & ITCL_COMMON) != 0)
-                        ? "proc" : "method";
-                    objPtr = Tcl_NewStringObj(val, -1);
-                    break;
-            }
-
-            if (objc == 1) {
-                resultPtr = objPtr;
-            } else {
-                Tcl_ListObjAppendElement(NULL, resultPtr, objPtr);
-            }
+            resultPtr = FunctionInfoFields(imPtr, objc, iflist);
         }
         Tcl_SetObjResult(interp, resultPtr);
     } else {
 
         /*
-         *  Return the list of available commands.
+         *  Return the list of available commands, or the requested
+         *  information for each of them.
          */
         resultPtr = Tcl_NewListObj(0, NULL);
 
@@ -1204,31 +1248,14 @@ Itcl_BiInfoFunctionCmd(
         while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
             entry = Tcl_FirstHashEntry(&iclsPtr->functions, &place);
             while (entry) {
-	        int useIt = 1;
-
                 imPtr = (ItclMemberFunc*)Tcl_GetHashValue(entry);
-		if (imPtr->codePtr && (imPtr->codePtr->flags & ITCL_BUILTIN)) {
-		    if (strcmp(Tcl_GetString(imPtr->namePtr), "info") == 0) {
-		        useIt = 0;
-		    }
-		    if (strcmp(Tcl_GetString(imPtr->namePtr), "setget") == 0) {
-			if (!(imPtr->iclsPtr->flags & ITCL_ECLASS)) {
-		            useIt = 0;
-		        }
-		    }
-		    if (strcmp(Tcl_GetString(imPtr->namePtr),
-		            "installcomponent") == 0) {
-			if (!(imPtr->iclsPtr->flags &
-			        (ITCL_WIDGET|ITCL_WIDGETADAPTOR))) {
-		            useIt = 0;
-		        }
+		if (FunctionIsListed(imPtr)) {
+		    if (objc == 0) {
+			objPtr = imPtr->fullNamePtr;
+		    } else {
+			objPtr = FunctionInfoFields(imPtr, objc, iflist);
 		    }
-		}
-		if (useIt) {
-                    objPtr = Tcl_NewStringObj(
-		            Tcl_GetString(imPtr->fullNamePtr), -1);
-                    Tcl_ListObjAppendElement(NULL,
-		            resultPtr, objPtr);
+                    Tcl_ListObjAppendElement(NULL, resultPtr, objPtr);
                 }
 
                 entry = Tcl_NextHashEntry(&place);
@@ -1238,9 +1265,239 @@ Itcl_BiInfoFunctionCmd(
 
         Tcl_SetObjResult(interp, resultPtr);
     }
+    if (iflist != &iflistStorage[0]) {
+        ckfree((char *)iflist);
+    }
     return TCL_OK;
 }
-
+
+/*
+ * ------------------------------------------------------------------------
+ *  VariableInfoFields()
+ *
+ *  Returns the fields ivlist[0..objc-1] of "info variable" for the
+ *  data member ivPtr: the field itself if only one is asked for, a
+ *  list of them otherwise.  varName is the name the member was asked
+ *  for by, or NULL when all members are reported.  Returns NULL along
+ *  with an error message in the interpreter if a field cannot be
+ *  reported.
+ * ------------------------------------------------------------------------
+ */
+static const char *variableInfoOptions[] = {
+    "-config", "-init", "-name", "-protection", "-type",
+    "-value", "-scope", NULL
+};
+enum BIvIdx {
+    BIvConfigIdx, BIvInitIdx, BIvNameIdx, BIvProtectIdx,
+    BIvTypeIdx, BIvValueIdx, BIvScopeIdx
+};
+
+static Tcl_Obj *
+VariableInfoFields(
+    Tcl_Interp *interp,           /* current interpreter */
+    ItclClass *contextIclsPtr,    /* class the query is made for */
+    ItclObject **contextIoPtrPtr, /* object context, or NULL; may be
+                                   * filled in by -scope */
+    ItclVariable *ivPtr,          /* data member to report */
+    const char *varName,          /* name asked for, or NULL */
+    int objc,                     /* number of fields */
+    enum BIvIdx *ivlist)          /* fields to report */
+{
+    Tcl_Obj *resultPtr;
+    Tcl_Obj *objPtr;
+    Tcl_HashEntry *entry;
+    ItclObject *contextIoPtr = *contextIoPtrPtr;
+    ItclVarLookup *vlookup;
+    ItclVariable *scopeIvPtr;
+    const char *scopeName;
+    const char *val;
+    int i;
+
+    ClientData cfClientData;
+    ItclObjectInfo *infoPtr;
+    Tcl_Object oPtr;
+    int doAppend;
+
+    resultPtr = NULL;
+    objPtr = NULL;
+    if (objc > 1) {
+        resultPtr = Tcl_NewListObj(0, NULL);
+    }
+
+    for (i=0 ; i < objc; i++) {
+        switch (ivlist[i]) {
+            case BIvConfigIdx:
+                if (ivPtr->codePtr &&
+                        Itcl_IsMemberCodeImplemented(ivPtr->codePtr)) {
+                    objPtr = Tcl_NewStringObj(
+                            Tcl_GetString(ivPtr->codePtr->bodyPtr), -1);
+                } else {
+                    objPtr = Tcl_NewStringObj("", -1);
+                }
+                break;
+
+            case BIvInitIdx:
+                /*
+                 *  If this is the built-in "this" variable, then
+                 *  report the object name as its initialization string.
+                 */
+                if ((ivPtr->flags & ITCL_THIS_VAR) != 0) {
+                    if ((contextIoPtr != NULL) &&
+                            (contextIoPtr->accessCmd != NULL)) {
+                        objPtr = Tcl_NewStringObj(NULL, 0);
+                        Tcl_GetCommandFullName(
+                            contextIoPtr->iclsPtr->interp,
+                            contextIoPtr->accessCmd, objPtr);
+                    } else {
+                        objPtr = Tcl_NewStringObj("<objectName>", -1);
+                    }
+                } else {
+                    if (ivPtr->init) {
+                        objPtr = Tcl_NewStringObj(
+                                Tcl_GetString(ivPtr->init), -1);
+                    } else {
+                        objPtr = Tcl_NewStringObj("<undefined>", -1);
+                    }
+                }
+                break;
+
+            case BIvNameIdx:
+                objPtr = Tcl_NewStringObj(
+                        Tcl_GetString(ivPtr->fullNamePtr), -1);
+                break;
+
+            case BIvProtectIdx:
+                val = Itcl_ProtectionStr(ivPtr->protection);
+                objPtr = Tcl_NewStringObj((const char *)val, -1);
+                break;
+
+            case BIvTypeIdx:
+                val = ((ivPtr->flags & ITCL_COMMON) != 0)
+                    ? "common" : "variable";
+                objPtr = Tcl_NewStringObj((const char *)val, -1);
+                break;
+
+            case BIvValueIdx:
+                if ((ivPtr->flags & ITCL_COMMON) != 0) {
+                    val = Itcl_GetCommonVar(interp,
+                            Tcl_GetString(ivPtr->fullNamePtr),
+                            ivPtr->iclsPtr);
+                } else {
+                    if (contextIoPtr == NULL) {
+                        Tcl_ResetResult(interp);
+                        Tcl_AppendResult(interp,
+                                "cannot access object-specific info ",
+                                "without an object context",
+                                NULL);
+                        goto errorReturn;
+                    } else {
+                        val = Itcl_GetInstanceVar(interp,
+                                Tcl_GetString(ivPtr->namePtr),
+                                contextIoPtr, ivPtr->iclsPtr);
+                    }
+                }
+                if (val == NULL) {
+                    val = "<undefined>";
+                }
+                objPtr = Tcl_NewStringObj((const char *)val, -1);
+                break;
+
+            case BIvScopeIdx:
+                scopeIvPtr = ivPtr;
+                scopeName = varName;
+                if (varName != NULL) {
+                    entry = Tcl_FindHashEntry(&contextIclsPtr->resolveVars,
+                            varName);
+                    if (!entry) {
+                        Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
+                              "variable \"", varName, "\" not found in class \"",
+                              Tcl_GetString(contextIclsPtr->fullNamePtr), "\"",
+                              (char*)NULL);
+                        goto errorReturn;
+                    }
+                    vlookup = (ItclVarLookup*)Tcl_GetHashValue(entry);
+                    scopeIvPtr = vlookup->ivPtr;
+                } else {
+                    scopeName = Tcl_GetString(ivPtr->namePtr);
+                }
+
+                if (scopeIvPtr->flags & ITCL_COMMON) {
+                    objPtr = Tcl_NewStringObj("", -1);
+
+                    if (scopeIvPtr->protection != ITCL_PUBLIC) {
+                        Tcl_AppendToObj(objPtr, ITCL_VARIABLES_NAMESPACE, -1);
+                    }
+                    Tcl_AppendToObj(objPtr,
+                            Tcl_GetString(scopeIvPtr->fullNamePtr), -1);
+                } else {
+                    /*
+                     *  If this is not a common variable, then we better have
+                     *  an object context.  Return the name as a fully qualified name.
+                     */
+                    infoPtr = contextIclsPtr->infoPtr;
+                    cfClientData = Itcl_GetCallFrameClientData(interp);
+                    if (cfClientData != NULL) {
+                        oPtr = Tcl_ObjectContextObject((Tcl_ObjectContext)cfClientData);
+                        if (oPtr != NULL) {
+                            contextIoPtr = (ItclObject*)Tcl_ObjectGetMetadata(
+                                    oPtr, infoPtr->object_meta_type);
+                        }
+                    }
+
+                    if (contextIoPtr == NULL) {
+                        if (infoPtr->currIoPtr != NULL) {
+                            contextIoPtr = infoPtr->currIoPtr;
+                        }
+                    }
+                    *contextIoPtrPtr = contextIoPtr;
+
+                    if (contextIoPtr == NULL) {
+                        Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
+                            "can't scope variable \"", scopeName,
+                            "\": missing object context",
+                            (char*)NULL);
+                        goto errorReturn;
+                    }
+
+                    doAppend = 1;
+                    if (contextIclsPtr->flags & ITCL_ECLASS) {
+                        if (strcmp(scopeName, "itcl_options") == 0) {
+                            doAppend = 0;
+                        }
+                    }
+
+                    objPtr = Tcl_NewStringObj((char*)NULL, 0);
+                    Tcl_AppendToObj(objPtr, ITCL_VARIABLES_NAMESPACE, -1);
+                    Tcl_AppendToObj(objPtr,
+                            (Tcl_GetObjectNamespace(contextIoPtr->oPtr))->fullName, -1);
+
+                    if (doAppend) {
+                        Tcl_AppendToObj(objPtr,
+                                Tcl_GetString(scopeIvPtr->fullNamePtr), -1);
+                    } else {
+                        Tcl_AppendToObj(objPtr, "::", -1);
+                        Tcl_AppendToObj(objPtr,
+                                Tcl_GetString(scopeIvPtr->namePtr), -1);
+                    }
+                }
+                break;
+        }
+
+        if (objc == 1) {
+            resultPtr = objPtr;
+        } else {
+            Tcl_ListObjAppendElement(NULL, resultPtr, objPtr);
+        }
+    }
+    return resultPtr;
+
+errorReturn:
+    if (resultPtr != NULL) {
+        Tcl_DecrRefCount(resultPtr);
+    }
+    return NULL;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BiInfoVariableCmd()
@@ -1252,9 +1509,10 @@ Itcl_BiInfoFunctionCmd(
  *        ?-init? ?-config? ?-value?
  *
  *  If the ?varName? is not specified, then a list of all known
- *  data members is returned.  Otherwise, the information for a
- *  specific member is returned.  Returns a status TCL_OK/TCL_ERROR
- *  to indicate success/failure.
+ *  data members is returned.  With flags but no ?varName?, the
+ *  requested information is returned for each of them.  Otherwise,
+ *  the information for a specific member is returned.  Returns a
+ *  status TCL_OK/TCL_ERROR to indicate success/failure.
  * ------------------------------------------------------------------------
  */
 /*&&&1*/
@@ -1277,23 +1535,11 @@ Itcl_BiInfoVariableCmd(
     ItclVarLookup *vlookup;
     ItclHierIter hier;
     char *varName;
-    const char *val;
     int i;
+    int idx;
     int result;
 
-    ClientData cfClientData;
-    ItclObjectInfo *infoPtr;
-    Tcl_Object oPtr;
-    int doAppend;
-
-    static const char *options[] = {
-        "-config", "-init", "-name", "-protection", "-type",
-        "-value", "-scope", NULL
-    };
-    enum BIvIdx {
-        BIvConfigIdx, BIvInitIdx, BIvNameIdx, BIvProtectIdx,
-        BIvTypeIdx, BIvValueIdx, BIvScopeIdx
-    } *ivlist, ivlistStorage[7];
+    enum BIvIdx *ivlist, ivlistStorage[7];
 
     static enum BIvIdx DefInfoVariable[5] = {
         BIvProtectIdx,
@@ -1340,7 +1586,29 @@ Itcl_BiInfoVariableCmd(
 
     if (objc > 0) {
         varName = Tcl_GetString(*objv);
-        objc--; objv++;
+        if ((*varName == '-') && (Tcl_GetIndexFromObjStruct(NULL, *objv,
+                variableInfoOptions, sizeof(char *), "option", 0,
+		&idx) == TCL_OK)) {
+            varName = NULL;
+        } else {
+            objc--; objv++;
+        }
+    }
+
+    /*
+     *  Scan through all remaining flags and figure out what to return.
+     */
+    ivlist = &ivlistStorage[0];
+    if (objc > 7) {
+        ivlist = (enum BIvIdx *)ckalloc(objc * sizeof(enum BIvIdx));
+    }
+    for (i=0 ; i < objc; i++) {
+        result = Tcl_GetIndexFromObjStruct(interp, objv[i],
+            variableInfoOptions, sizeof(char *), "option", 0, &idx);
+        if (result != TCL_OK) {
+            goto errorReturn;
+        }
+        ivlist[i] = (enum BIvIdx)idx;
     }
 
     /*
@@ -1353,7 +1621,7 @@ Itcl_BiInfoVariableCmd(
                 "\"", varName, "\" isn't a variable in class \"",
                 contextIclsPtr->nsPtr->fullName, "\"",
                 NULL);
-            return TCL_ERROR;
+            goto errorReturn;
         }
 
         vlookup = (ItclVarLookup*)Tcl_GetHashValue(entry);
@@ -1365,191 +1633,18 @@ Itcl_BiInfoVariableCmd(
         if (objc == 0) {
             if (ivPtr->protection == ITCL_PUBLIC &&
                     ((ivPtr->flags & ITCL_COMMON) == 0)) {
-                ivlist = DefInfoPubVariable;
-                objc = 6;
+                resultPtr = VariableInfoFields(interp, contextIclsPtr,
+                        &contextIoPtr, ivPtr, varName, 6, DefInfoPubVariable);
             } else {
-                ivlist = DefInfoVariable;
-                objc = 5;
+                resultPtr = VariableInfoFields(interp, contextIclsPtr,
+                        &contextIoPtr, ivPtr, varName, 5, DefInfoVariable);
             }
         } else {
-
-            /*
-             *  Otherwise, scan through all remaining flags and
-             *  figure out what to return.
-             */
-            ivlist = &ivlistStorage[0];
-            for (i=0 ; i < objc; i++) {
-                result = Tcl_GetIndexFromObjStruct(interp, objv[i],
-                    options, sizeof(char *), "option", 0, (int*)(&ivlist[i]));
-                if (result != TCL_OK) {
-                    return TCL_ERROR;
-                }
-            }
+            resultPtr = VariableInfoFields(interp, contextIclsPtr,
+                    &contextIoPtr, ivPtr, varName, objc, ivlist);
         }
-
-        if (objc > 1) {
-            resultPtr = Tcl_NewListObj(0, NULL);
-        }
-
-        for (i=0 ; i < objc; i++) {
-            switch (ivlist[i]) {
-                case BIvConfigIdx:
-                    if (ivPtr->codePtr &&
-		            Itcl_IsMemberCodeImplemented(ivPtr->codePtr)) {
-                        objPtr = Tcl_NewStringObj(
-			        Tcl_GetString(ivPtr->codePtr->bodyPtr), -1);
-                    } else {
-                        objPtr = Tcl_NewStringObj("", -1);
-                    }
-                    break;
-
-                case BIvInitIdx:
-                    /*
-                     *  If this is the built-in "this" variable, then
-                     *  report the object name as its initialization string.
-                     */
-                    if ((ivPtr->flags & ITCL_THIS_VAR) != 0) {
-                        if ((contextIoPtr != NULL) &&
-			        (contextIoPtr->accessCmd != NULL)) {
-                            objPtr = Tcl_NewStringObj(NULL, 0);
-                            Tcl_GetCommandFullName(
-                                contextIoPtr->iclsPtr->interp,
-                                contextIoPtr->accessCmd, objPtr);
-                        } else {
-                            objPtr = Tcl_NewStringObj("<objectName>", -1);
-                        }
-                    } else {
-		        if (vlookup->ivPtr->init) {
-			    objPtr = Tcl_NewStringObj(
-			            Tcl_GetString(vlookup->ivPtr->init), -1);
-                        } else {
-                            objPtr = Tcl_NewStringObj("<undefined>", -1);
-		        }
-                    }
-                    break;
-
-                case BIvNameIdx:
-                    objPtr = Tcl_NewStringObj(
-		            Tcl_GetString(ivPtr->fullNamePtr), -1);
-                    break;
-
-                case BIvProtectIdx:
-                    val = Itcl_ProtectionStr(ivPtr->protection);
-                    objPtr = Tcl_NewStringObj((const char *)val, -1);
-                    break;
-
-                case BIvTypeIdx:
-                    val = ((ivPtr->flags & ITCL_COMMON) != 0)
-                        ? "common" : "variable";
-                    objPtr = Tcl_NewStringObj((const char *)val, -1);
-                    break;
-
-                case BIvValueIdx:
-                    if ((ivPtr->flags & ITCL_COMMON) != 0) {
-                        val = Itcl_GetCommonVar(interp,
-			        Tcl_GetString(ivPtr->fullNamePtr),
-                                ivPtr->iclsPtr);
-                    } else {
-		        if (contextIoPtr == NULL) {
-                            if (objc > 1) {
-			        Tcl_DecrRefCount(resultPtr);
-			    }
-                            Tcl_ResetResult(interp);
-                            Tcl_AppendResult(interp,
-                                    "cannot access object-specific info ",
-                                    "without an object context",
-                                    NULL);
-                            return TCL_ERROR;
-                        } else {
-                            val = Itcl_GetInstanceVar(interp,
-			            Tcl_GetString(ivPtr->namePtr),
-                                    contextIoPtr, ivPtr->iclsPtr);
-                        }
-                    }
-                    if (val == NULL) {
-                        val = "<undefined>";
-                    }
-                    objPtr = Tcl_NewStringObj((const char *)val, -1);
-                    break;
-
-                case BIvScopeIdx:
-                    entry = Tcl_FindHashEntry(&contextIclsPtr->resolveVars, varName);
-                    if (!entry) {
-                        Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
-                              "variable \"", varName, "\" not found in class \"",
-                              Tcl_GetString(contextIclsPtr->fullNamePtr), "\"",
-                              (char*)NULL);
-                        return TCL_ERROR;
-                    }
-                    vlookup = (ItclVarLookup*)Tcl_GetHashValue(entry);
-
-                    if (vlookup->ivPtr->flags & ITCL_COMMON) {
-                        objPtr = Tcl_NewStringObj("", -1);
-
-                        if (vlookup->ivPtr->protection != ITCL_PUBLIC) {
-                            Tcl_AppendToObj(objPtr, ITCL_VARIABLES_NAMESPACE, -1);
-                        }
-                        Tcl_AppendToObj(objPtr,
-                                Tcl_GetString(vlookup->ivPtr->fullNamePtr), -1);
-                    } else {
-                        /*
-                         *  If this is not a common variable, then we better have
-                         *  an object context.  Return the name as a fully qualified name.
-                         */
-                        infoPtr = contextIclsPtr->infoPtr;
-                        cfClientData = Itcl_GetCallFrameClientData(interp);
-                        if (cfClientData != NULL) {
-                            oPtr = Tcl_ObjectContextObject((Tcl_ObjectContext)cfClientData);
-                            if (oPtr != NULL) {
-                                contextIoPtr = (ItclObject*)Tcl_ObjectGetMetadata(
-                                        oPtr, infoPtr->object_meta_type);
-                            }
-                        }
-
-                        if (contextIoPtr == NULL) {
-                            if (infoPtr->currIoPtr != NULL) {
-                                contextIoPtr = infoPtr->currIoPtr;
-                            }
-                        }
-
-                        if (contextIoPtr == NULL) {
-                            Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
-                                "can't scope variable \"", varName,
-                                "\": missing object context",
-                                (char*)NULL);
-                            return TCL_ERROR;
-                        }
-
-                        doAppend = 1;
-                        if (contextIclsPtr->flags & ITCL_ECLASS) {
-                            if (strcmp(varName, "itcl_options") == 0) {
-                                doAppend = 0;
-                            }
-                        }
-
-                        objPtr = Tcl_NewStringObj((char*)NULL, 0);
-                        Tcl_IncrRefCount(objPtr);
-                        Tcl_AppendToObj(objPtr, ITCL_VARIABLES_NAMESPACE, -1);
-                        Tcl_AppendToObj(objPtr,
-                                (Tcl_GetObjectNamespace(contextIoPtr->oPtr))->fullName, -1);
-
-                        if (doAppend) {
-                            Tcl_AppendToObj(objPtr,
-                                    Tcl_GetString(vlookup->ivPtr->fullNamePtr), -1);
-                        } else {
-                            Tcl_AppendToObj(objPtr, "::", -1);
-                            Tcl_AppendToObj(objPtr,
-                                    Tcl_GetString(vlookup->ivPtr->namePtr), -1);
-                        }
-                    }
-                    break;
-            }
-
-            if (objc == 1) {
-                resultPtr = objPtr;
-            } else {
-                Tcl_ListObjAppendElement(NULL, resultPtr, objPtr);
-            }
+        if (resultPtr == NULL) {
+            goto errorReturn;
         }
 	Tcl_ResetResult(interp);
 	Tcl_AppendResult(interp, Tcl_GetString(resultPtr), NULL);
@@ -1557,7 +1652,8 @@ Itcl_BiInfoVariableCmd(
     } else {
 
         /*
-         *  Return the list of available variables.  Report the built-in
+         *  Return the list of available variables, or the requested
+         *  information for each of them.  Report the built-in
          *  "this" variable only once, for the most-specific class.
          */
         resultPtr = Tcl_NewListObj(0, NULL);
@@ -1566,29 +1662,41 @@ Itcl_BiInfoVariableCmd(
             entry = Tcl_FirstHashEntry(&iclsPtr->variables, &place);
             while (entry) {
                 ivPtr = (ItclVariable*)Tcl_GetHashValue(entry);
-                if ((ivPtr->flags & ITCL_THIS_VAR) != 0) {
-                    if (iclsPtr == contextIclsPtr) {
-                        objPtr = Tcl_NewStringObj(
-			        Tcl_GetString(ivPtr->fullNamePtr), -1);
-                        Tcl_ListObjAppendElement(NULL,
-                            resultPtr, objPtr);
-                    }
+                entry = Tcl_NextHashEntry(&place);
+                if (((ivPtr->flags & ITCL_THIS_VAR) != 0)
+                        && (iclsPtr != contextIclsPtr)) {
+                    continue;
+                }
+                if (objc == 0) {
+                    objPtr = ivPtr->fullNamePtr;
                 } else {
-                    objPtr = Tcl_NewStringObj(
-		            Tcl_GetString(ivPtr->fullNamePtr), -1);
-                    Tcl_ListObjAppendElement(NULL,
-                        resultPtr, objPtr);
+                    objPtr = VariableInfoFields(interp, contextIclsPtr,
+                            &contextIoPtr, ivPtr, NULL, objc, ivlist);
+                    if (objPtr == NULL) {
+                        Itcl_DeleteHierIter(&hier);
+                        Tcl_DecrRefCount(resultPtr);
+                        goto errorReturn;
+                    }
                 }
-                entry = Tcl_NextHashEntry(&place);
+                Tcl_ListObjAppendElement(NULL, resultPtr, objPtr);
             }
         }
         Itcl_DeleteHierIter(&hier);
 
         Tcl_SetObjResult(interp, resultPtr);
     }
+    if (ivlist != &ivlistStorage[0]) {
+        ckfree((char *)ivlist);
+    }
     return TCL_OK;
+
+errorReturn:
+    if (ivlist != &ivlistStorage[0]) {
+        ckfree((char *)ivlist);
+    }
+    return TCL_ERROR;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_BiInfoVarsCmd()
@@ -2143,7 +2251,8 @@ Itcl_BiInfoOptionCmd(
 	    return TCL_ERROR;
 	}
 	optionNamePtr = Tcl_NewStringObj(optionName, -1);
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(contextIoPtr)->objectOptions,
 	        (char *)optionNamePtr);
         Tcl_DecrRefCount(optionNamePtr);
         if (hPtr == NULL) {
@@ -3448,7 +3557,7 @@ Itcl_BiInfoOptionsCmd(
     if (ioPtr == NULL) {
         tablePtr = &iclsPtr->options;
     } else {
-        tablePtr = &ioPtr->objectOptions;
+        tablePtr = &ItclObjectTablesOf(ioPtr)->objectOptions;
     }
     FOREACH_HASH_VALUE(ioptPtr, tablePtr) {
 	name = Tcl_GetString(ioptPtr->namePtr);
@@ -3461,7 +3570,7 @@ Itcl_BiInfoOptionsCmd(
     if (ioPtr == NULL) {
         tablePtr = &iclsPtr->delegatedOptions;
     } else {
-        tablePtr = &ioPtr->objectDelegatedOptions;
+        tablePtr = &ItclObjectTablesOf(ioPtr)->objectDelegatedOptions;
     }
     FOREACH_HASH_VALUE(idoPtr, tablePtr) {
         name = Tcl_GetString(idoPtr->namePtr);
@@ -4404,13 +4513,12 @@ Itcl_BiInfoInstancesCmd(
     int objc,              /* number of arguments */
     Tcl_Obj *const objv[]) /* argument objects */
 {
-    FOREACH_HASH_DECLS;
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
-    ItclObjectInfo *infoPtr;
     ItclObject *ioPtr;
     ItclClass *iclsPtr;
     const char *pattern;
+    (void)clientData;
 
     ItclShowArgs(1, "Itcl_BiInfoInstancesCmd", objc, objv);
     if (objc > 2) {
@@ -4430,25 +4538,26 @@ Itcl_BiInfoInstancesCmd(
     if (objc == 2) {
         pattern = Tcl_GetString(objv[1]);
     }
-    infoPtr = (ItclObjectInfo *)clientData;
     listPtr = Tcl_NewListObj(0, NULL);
-    FOREACH_HASH_VALUE(ioPtr, &infoPtr->objects) {
-	/* FIXME need to scan the inheritance too */
-        if (ioPtr->iclsPtr == iclsPtr) {
-	    if (ioPtr->iclsPtr->flags & ITCL_WIDGETADAPTOR) {
-	        objPtr = Tcl_NewStringObj(Tcl_GetCommandName(interp,
-		        ioPtr->accessCmd), -1);
-	    } else {
-	        objPtr = Tcl_NewObj();
-	        Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
-            }
-	    if ((pattern == NULL) ||
-                     Tcl_StringCaseMatch(Tcl_GetString(objPtr), pattern, 0)) {
-	        Tcl_ListObjAppendElement(interp, listPtr, objPtr);
-	    } else {
-	        Tcl_DecrRefCount(objPtr);
-	    }
+    /* FIXME need to scan the inheritance too */
+    for (ioPtr = iclsPtr->firstInstancePtr; ioPtr != NULL;
+            ioPtr = ioPtr->nextInstancePtr) {
+        if (ioPtr->accessCmd == NULL) {
+            continue;
+        }
+	if (iclsPtr->flags & ITCL_WIDGETADAPTOR) {
+	    objPtr = Tcl_NewStringObj(Tcl_GetCommandName(interp,
+		    ioPtr->accessCmd), -1);
+	} else {
+	    objPtr = Tcl_NewObj();
+	    Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
         }
+	if ((pattern == NULL) ||
+                Tcl_StringCaseMatch(Tcl_GetString(objPtr), pattern, 0)) {
+	    Tcl_ListObjAppendElement(interp, listPtr, objPtr);
+	} else {
+	    Tcl_DecrRefCount(objPtr);
+	}
     }
     Tcl_SetObjResult(interp, listPtr);
     return TCL_OK;
@@ -4808,7 +4917,8 @@ Itcl_BiInfoDelegatedOptionCmd(
 	    return TCL_ERROR;
 	}
 	optionNamePtr = Tcl_NewStringObj(optionName, -1);
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(contextIoPtr)->objectDelegatedOptions,
 	        (char *)optionNamePtr);
         Tcl_DecrRefCount(optionNamePtr);
         if (hPtr == NULL) {
@@ -5028,7 +5138,8 @@ Itcl_BiInfoDelegatedMethodCmd(
     if (cmdName) {
 	cmdNamePtr = Tcl_NewStringObj(cmdName, -1);
 	if (contextIoPtr != NULL) {
-            hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedFunctions,
+            hPtr = Tcl_FindHashEntry(
+                    &ItclObjectTablesOf(contextIoPtr)->objectDelegatedFunctions,
 	            (char *)cmdNamePtr);
 	} else {
             hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions,
@@ -5253,7 +5364,8 @@ Itcl_BiInfoDelegatedTypeMethodCmd(
     if (cmdName) {
 	cmdNamePtr = Tcl_NewStringObj(cmdName, -1);
 	if (contextIoPtr != NULL) {
-            hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedFunctions,
+            hPtr = Tcl_FindHashEntry(
+                    &ItclObjectTablesOf(contextIoPtr)->objectDelegatedFunctions,
 	            (char *)cmdNamePtr);
 	} else {
             hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions,
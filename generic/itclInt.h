@@ -128,6 +128,21 @@ typedef struct ItclArgList {
     Tcl_Obj *defaultValuePtr;   /* default value or NULL if none */
 } ItclArgList;
 
+/*
+ *  Argument lists parsed by ItclCreateArgList are shared by all
+ *  functions with the same argument list string.  The first element of
+ *  such a list is the head of one of these records.
+ */
+typedef struct ItclSharedArgList {
+    ItclArgList first;          /* first argument, must come first */
+    int refCount;               /* number of users of the list */
+    Tcl_HashEntry *hPtr;        /* entry in ItclObjectInfo argLists, or
+                                 * NULL if the list is not shared */
+    int argc;                   /* number of mandatory arguments */
+    int maxArgc;                /* number of arguments, -1 for "args" */
+    Tcl_Obj *usagePtr;          /* usage message for the arguments */
+} ItclSharedArgList;
+
 /*
  *  Common info for managing all known objects.
  *  Each interpreter has one of these data structures stored as
@@ -141,20 +156,83 @@ struct EnsembleInfo;
 struct ItclDelegatedOption;
 struct ItclDelegatedFunction;
 
+/*
+ *  Counters of the "itcl::profile" command, kept per member function
+ *  and for a few builtins.  Times are in microseconds, the exclusive
+ *  time leaves out the profiled calls made from within the call.
+ */
+typedef struct ItclProfileRecord {
+    Tcl_WideInt calls;              /* number of completed calls */
+    Tcl_WideInt errors;             /* calls that returned TCL_ERROR */
+    Tcl_WideInt inclusive;          /* time spent in the calls */
+    Tcl_WideInt exclusive;          /* same, less nested profiled calls */
+} ItclProfileRecord;
+
+typedef struct ItclProfileFrame {
+    ItclProfileRecord *recPtr;      /* what the active call is counted on */
+    Tcl_WideInt start;              /* when the call started */
+    Tcl_WideInt nested;             /* time of the profiled calls it made */
+} ItclProfileFrame;
+
+/*
+ * Memory in use and kept in the pools of itclUtil.c, as reported by
+ * "itcl::memstats".
+ */
+typedef struct ItclMemStats {
+    Tcl_WideInt listElemsUsed;      /* Itcl_ListElem in lists */
+    Tcl_WideInt listElemsPooled;    /* Itcl_ListElem kept for reuse */
+    Tcl_WideInt listElemSize;       /* bytes of one Itcl_ListElem */
+    Tcl_WideInt blocksUsed;         /* blocks from Itcl_Alloc() */
+    Tcl_WideInt blockBytesUsed;     /* their size in bytes */
+    Tcl_WideInt blocksPooled;       /* freed blocks kept for reuse */
+    Tcl_WideInt blockBytesPooled;   /* their size in bytes */
+} ItclMemStats;
+
+/*
+ * The tables of an object that only objects of an ::itcl::extendedclass,
+ * ::itcl::type or ::itcl::widget fill.  An object gets them allocated
+ * when the first entry goes in; see ItclObjectTablesOf().
+ */
+typedef struct ItclObjectTables {
+    Tcl_HashTable objectOptions; /* definitions for all option members
+                                     in this object. Look up option namePtr
+                                     names and get back ItclOption* ptrs */
+    Tcl_HashTable objectComponents; /* definitions for all component members
+                                     in this object. Look up component namePtr
+                                     names and get back ItclComponent* ptrs */
+    Tcl_HashTable objectMethodVariables;
+                                 /* definitions for all methodvariable members
+                                     in this object. Look up methodvariable
+				     namePtr names and get back
+				     ItclMethodVariable* ptrs */
+    Tcl_HashTable objectDelegatedOptions;
+                                  /* definitions for all delegated option
+				     members in this object. Look up option
+				     namePtr names and get back
+				     ItclOption* ptrs */
+    Tcl_HashTable objectDelegatedFunctions;
+                                  /* definitions for all delegated function
+				     members in this object. Look up function
+				     namePtr names and get back
+				     ItclMemberFunc * ptrs */
+    Tcl_HashTable delegateTargets; /* delegated options already resolved
+                                   * by cget/configure, key is the option
+				   * name, value is ItclDelegateTarget* */
+} ItclObjectTables;
+
 typedef struct ItclObjectInfo {
     Tcl_Interp *interp;             /* interpreter that manages this info */
     Tcl_HashTable objects;          /* list of all known objects key is
                                      * ioPtr */
     Tcl_HashTable objectCmds;       /* list of known objects using accessCmd */
-    Tcl_HashTable unused5;          /* list of known objects using namePtr */
     Tcl_HashTable classes;          /* list of all known classes,
                                      * key is iclsPtr */
     Tcl_HashTable nameClasses;      /* maps from fullNamePtr to iclsPtr */
     Tcl_HashTable namespaceClasses; /* maps from nsPtr to iclsPtr */
     Tcl_HashTable procMethods;      /* maps from procPtr to mFunc */
     Tcl_HashTable instances;        /* maps from instanceNumber to ioPtr */
-    Tcl_HashTable unused8;          /* maps from ioPtr to instanceNumber */
-    Tcl_HashTable frameContext;     /* maps frame to context stack */
+    Tcl_HashTable frameContext;     /* maps frame to its ItclFrameContext
+                                     * when the ring slot is taken */
     Tcl_HashTable classTypes;       /* maps from class type i.e. "widget"
                                      * to define value i.e. ITCL_WIDGET */
     int protection;                 /* protection level currently in effect */
@@ -209,8 +287,42 @@ typedef struct ItclObjectInfo {
     Tcl_Obj *typeDestructorArgumentPtr;
     struct ItclObject *lastIoPtr;   /* last object constructed */
     Tcl_Command infoCmd;
+    struct ItclFrameContext *frameRing;
+                                    /* per-depth call frame context slots,
+                                     * see ItclFrameContext below */
+    int protoEpoch;                 /* incremented whenever any class
+                                     * definition changes, outdates all
+                                     * ItclObjectProto records */
+    struct ItclDictInfo *dictInfo;  /* queued ::itcl::internal::dicts
+                                     * entries, see itclHelpers.c */
+    int numDictInfo;                /* number of queued entries */
+    int maxDictInfo;                /* allocated size of dictInfo */
+    int dictInfoFlags;              /* ITCL_DICTS_* flags below */
+    int profiling;                  /* set by "itcl::profile on" */
+    int numProfileFrames;           /* profiled calls currently active */
+    int maxProfileFrames;           /* allocated size of profileFrames */
+    ItclProfileFrame *profileFrames;
+    ItclProfileRecord profileConfigure;
+                                    /* builtin "configure" methods */
+    ItclProfileRecord profileCget;  /* builtin "cget" methods */
+    ItclProfileRecord profileCreate;
+                                    /* time in ItclCreateObject */
+    ItclObjectTables noObjectTables;
+                                    /* always empty, the tables of objects
+                                     * that have none of their own */
+    struct ItclMemberFunc *directImPtr;
+                                    /* method of an Itcl_InvokeMethod call
+                                     * whose name needs no mapping */
+    Tcl_HashTable argLists;         /* parsed argument lists, keyed by the
+                                     * argument list string */
+    Tcl_Obj *codeWords[2];          /* "namespace" and "inscope", shared
+                                     * by all "itcl::code" results */
 } ItclObjectInfo;
 
+#define ITCL_DICTS_READ             0x01 /* the dicts have been generated */
+#define ITCL_DICTS_OBJECTS_CHANGED  0x02 /* objects dict is out of date */
+#define ITCL_DICTS_FLUSHING         0x04 /* ItclFlushDictInfo is active */
+
 typedef struct EnsembleInfo {
     Tcl_HashTable ensembles;        /* list of all known ensembles */
     Tcl_HashTable subEnsembles;     /* list of all known subensembles */
@@ -260,7 +372,9 @@ typedef struct ItclClass {
     Tcl_HashTable heritage;       /* table of all base classes.  Look up
                                    * by pointer to class definition.  This
                                    * provides fast lookup for inheritance
-                                   * tests. */
+                                   * tests.  The value is the first
+                                   * member function slot of that class
+                                   * in objects of this class. */
     Tcl_Obj *initCode;            /* initialization code for new objs */
     Tcl_HashTable variables;      /* definitions for all data members
                                      in this class.  Look up simple string
@@ -316,6 +430,38 @@ typedef struct ItclClass {
     Tcl_Obj *typeConstructorPtr;  /* initialization for types */
     int destructorHasBeenCalled;  /* prevent multiple invocations of destrcutor */
     int refCount;
+    Tcl_HashTable resolveCmdNames;
+                                  /* same as resolveCmds, but keyed by
+                                   * C string for Itcl_ClassCmdResolver */
+    Tcl_HashTable resolveCmdCache;
+                                  /* extendedclass only: name resolved
+                                   * through delegatedFunctions, maps to
+                                   * ItclCmdLookup or NULL if no member */
+    int numVarSlots;              /* instance variable slots used by this
+                                   * class and its first-base chain */
+    struct ItclObjectProto *protoPtr;
+                                  /* what a new object of this class
+                                   * gets, built on first use, or NULL */
+    Tcl_HashTable configOptions;  /* "-name" options of configure/cget
+                                   * already resolved, maps to the public
+                                   * ItclVariable */
+    Tcl_HashTable qualifierClasses;
+                                  /* "Class" qualifiers of "Class::method"
+                                   * calls on objects of this class already
+				   * resolved, maps to the ItclClass within
+				   * this hierarchy */
+    struct ItclObject *firstInstancePtr;
+    struct ItclObject *lastInstancePtr;
+                                  /* live objects of exactly this class,
+                                   * in order of creation, linked through
+				   * their prev/nextInstancePtr */
+    int numInstances;             /* number of objects in that list */
+    int peakInstances;            /* highest numInstances seen so far */
+    int numMethodSlots;           /* member function slots used by this
+                                   * class and all of its base classes */
+    Tcl_Obj *codeNsNamePtr;       /* name of the class namespace shared
+                                   * by all "itcl::code" results made in
+				   * it, NULL until the first one */
 } ItclClass;
 
 typedef struct ItclHierIter {
@@ -340,34 +486,14 @@ typedef struct ItclObject {
     ItclClass *iclsPtr;          /* most-specific class */
     Tcl_Command accessCmd;       /* object access command */
 
-    Tcl_HashTable* constructed;  /* temp storage used during construction */
-    Tcl_HashTable* destructed;   /* temp storage used during destruction */
+    Itcl_Stack* constructed;     /* temp storage used during construction,
+                                  * classes whose constructor has run */
+    Itcl_Stack* destructed;      /* temp storage used during destruction,
+                                  * classes whose destructor has run */
     Tcl_HashTable objectVariables;
                                  /* used for storing Tcl_Var entries for
 				  * variable resolving, key is ivPtr of
 				  * variable, value is varPtr */
-    Tcl_HashTable objectOptions; /* definitions for all option members
-                                     in this object. Look up option namePtr
-                                     names and get back ItclOption* ptrs */
-    Tcl_HashTable objectComponents; /* definitions for all component members
-                                     in this object. Look up component namePtr
-                                     names and get back ItclComponent* ptrs */
-    Tcl_HashTable objectMethodVariables;
-                                 /* definitions for all methodvariable members
-                                     in this object. Look up methodvariable
-				     namePtr names and get back
-				     ItclMethodVariable* ptrs */
-    Tcl_HashTable objectDelegatedOptions;
-                                  /* definitions for all delegated option
-				     members in this object. Look up option
-				     namePtr names and get back
-				     ItclOption* ptrs */
-    Tcl_HashTable objectDelegatedFunctions;
-                                  /* definitions for all delegated function
-				     members in this object. Look up function
-				     namePtr names and get back
-				     ItclMemberFunc * ptrs */
-    Tcl_HashTable contextCache;   /* cache for function contexts */
     Tcl_Obj *namePtr;
     Tcl_Obj *origNamePtr;         /* the original name before any rename */
     Tcl_Obj *createNamePtr;       /* the temp name before any rename
@@ -388,8 +514,74 @@ typedef struct ItclObject {
     int noComponentTrace;         /* don't call component traces if
                                    * setting components in DelegationInstall */
     int hadConstructorError;      /* needed for multiple calls of CallItclObjectCmd */
+    int numVarSlots;              /* size of varSlots */
+    struct ItclVarSlot *varSlots; /* instance variables indexed by
+                                   * ItclVariable slot, see below */
+    Tcl_Var thisVarPtr;           /* the "this" variable of the most
+                                   * specific class, which is what "this"
+                                   * resolves to in every class scope */
+    struct ItclObject *prevInstancePtr;
+    struct ItclObject *nextInstancePtr;
+                                  /* neighbours in the instance list of
+                                   * iclsPtr, both NULL while the object
+				   * is not in that list */
+    int numCallContexts;          /* size of callContexts */
+    struct ItclCallContext **callContexts;
+                                  /* reusable call context of each
+                                   * method, indexed by ItclMemberFunc
+                                   * slot, NULL if not called yet */
+    ItclObjectTables *tablesPtr;  /* option, component and delegation
+                                   * tables, NULL while all are empty */
+    Tcl_Var optionsVarPtr;        /* the "itcl_options" array of the
+                                   * object, NULL until it is first
+                                   * looked up, see ItclObjectOptionsVar */
 } ItclObject;
 
+/*
+ * The tables of an object for looking up and iterating.  An object
+ * without tables of its own shares the empty ones of the interpreter,
+ * so nothing must be added through this; use ItclCreateObjectTables().
+ */
+#define ItclObjectTablesOf(ioPtr) \
+    (((ioPtr)->tablesPtr != NULL) ? (ioPtr)->tablesPtr \
+            : &(ioPtr)->infoPtr->noObjectTables)
+
+/*
+ * Instance variables along the first-base chain of a class get a dense
+ * slot number in Itcl_BuildVirtualTables(), so an object can find their
+ * Tcl_Var without probing objectVariables.  The ItclVariable is kept
+ * next to the variable, so that a slot shared by variables of unrelated
+ * classes (multiple inheritance) is detected and the hash table used.
+ */
+typedef struct ItclVarSlot {
+    struct ItclVariable *ivPtr; /* variable owning this slot, or NULL */
+    Tcl_Var varPtr;             /* the object's instance of ivPtr */
+} ItclVarSlot;
+
+/*
+ * Everything a new object collects from its class hierarchy, already in
+ * hierarchy order and with the definitions hidden by more specific
+ * classes left out.  Built by ItclGetObjectProto() on the first
+ * construction and rebuilt once protoEpoch of the ItclObjectInfo has
+ * moved on.
+ */
+typedef struct ItclObjectProto {
+    int epoch;                  /* protoEpoch this record was built for */
+    int numClasses;
+    ItclClass **classes;        /* the hierarchy, most specific first */
+    int numOptions;
+    struct ItclOption **options;
+    int numDelegatedOptions;
+    struct ItclDelegatedOption **delegatedOptions;
+    int numMethodVariables;
+    struct ItclMethodVariable **methodVariables;
+    int numDestructors;         /* classes of the hierarchy that have a
+                                 * destructor, 0 lets the objects be
+				 * destroyed without running any */
+    ItclClass **destructors;    /* those classes, each once, in the order
+                                 * their destructors are to be invoked */
+} ItclObjectProto;
+
 #define ITCL_IGNORE_ERRS  0x002  /* useful for construction/destruction */
 
 typedef struct ItclResolveInfo {
@@ -415,8 +607,12 @@ typedef struct ItclMemberCode {
     union {
         Tcl_CmdProc *argCmd;    /* (argc,argv) C implementation */
         Tcl_ObjCmdProc *objCmd; /* (objc,objv) C implementation */
+        Itcl_MethodCProc *methodCmd;
+                                /* Itcl_RegisterMethodC implementation */
     } cfunc;
     ClientData clientData;      /* client data for C implementations */
+    int minArgs;                /* argument counts of a method C */
+    int maxArgs;                /* implementation, maxArgs < 0: no limit */
 } ItclMemberCode;
 
 /*
@@ -427,6 +623,7 @@ typedef struct ItclMemberCode {
 #define ITCL_IMPLEMENT_ARGCMD  0x004  /* (argc,argv) C implementation */
 #define ITCL_IMPLEMENT_OBJCMD  0x008  /* (objc,objv) C implementation */
 #define ITCL_IMPLEMENT_C       0x00c  /* either kind of C implementation */
+#define ITCL_IMPLEMENT_METHODC 0x200  /* Itcl_RegisterMethodC implementation */
 
 #define Itcl_IsMemberCodeImplemented(mcode) \
     (((mcode)->flags & ITCL_IMPLEMENT_NONE) == 0)
@@ -518,6 +715,26 @@ typedef struct ItclMemberFunc {
     ClientData tmPtr;           /* TclOO methodPtr */
     ItclDelegatedFunction *idmPtr;
                                 /* if the function is delegated != NULL */
+    struct ItclMemberFunc *chainPtr;
+                                /* where "chain" in this function went to
+                                 * the last time, NULL for nowhere */
+    ItclClass *chainClassPtr;   /* object class chainPtr is valid for */
+    int chainEpoch;             /* protoEpoch chainPtr is valid for */
+    int slot;                   /* number within its class, which with
+                                 * the start kept in the heritage table
+                                 * indexes ItclObject callContexts,
+                                 * or -1 */
+    ItclProfileRecord *profilePtr;
+                                /* "itcl::profile" counters, NULL if the
+                                 * function was not called while profiling */
+    Tcl_Namespace *accessNsPtr; /* namespace of the last access check of
+                                 * a non-public function, or NULL */
+    int accessEpoch;            /* protoEpoch accessNsPtr is valid for */
+    int accessResult;           /* result of Itcl_CanAccessFunc() for
+                                 * accessNsPtr */
+    Tcl_Obj *callNamePtr;       /* private copy of the method name for
+                                 * calls bound in NRExecMethod, TclOO
+                                 * keeps the call chain cached in it */
 } ItclMemberFunc;
 
 /*
@@ -536,6 +753,7 @@ typedef struct ItclVariable {
     int initted;                /* is set when first time initted, to check
                                  * for example itcl_hull var, which can be only
 				 * initialized once */
+    int slot;                   /* index into ItclObject varSlots, or -1 */
 } ItclVariable;
 
 
@@ -552,6 +770,27 @@ typedef struct ItclDelegatedOption {
     Tcl_HashTable exceptions;    /* exceptions from delegation */
 } ItclDelegatedOption;
 
+/*
+ * Where cget/configure of a delegated option of one object goes to.  The
+ * entries are dropped whenever a component variable of the object is
+ * written (see ItclTraceComponentVar()) or its delegated options change,
+ * so componentPtr is always the current value of the component.  cget,
+ * configure of a single option and configure of option/value pairs do
+ * not resolve options by exactly the same rules, flags records which of
+ * them found this target.
+ */
+#define ITCL_DELEGATE_CGET           0x01
+#define ITCL_DELEGATE_CONFIGURE      0x02
+#define ITCL_DELEGATE_CONFIGURE_SET  0x04
+
+typedef struct ItclDelegateTarget {
+    ItclDelegatedOption *idoPtr; /* the delegation found */
+    ItclComponent *icPtr;        /* component the option is forwarded to */
+    Tcl_Obj *componentPtr;       /* value of the component variable */
+    Tcl_Obj *optionPtr;          /* option name given to the component */
+    int flags;                   /* ITCL_DELEGATE_* lookups that found it */
+} ItclDelegateTarget;
+
 /*
  *  Instance options.
  */
@@ -630,6 +869,16 @@ typedef struct ItclCmdLookup {
     Tcl_Command cmdPtr;
 } ItclCmdLookup;
 
+/*
+ *  Representation of an Itcl_Method token handed out by Itcl_GetMethod.
+ */
+typedef struct ItclMethodHandle {
+    ItclMemberFunc *imPtr;        /* method definition, kept preserved */
+    Tcl_Obj *namePtr;             /* private copy of the method name,
+                                   * TclOO keeps the call chain cached in
+                                   * it between invocations */
+} ItclMethodHandle;
+
 typedef struct ItclCallContext {
     int objectFlags;
     Tcl_Namespace *nsPtr;
@@ -638,6 +887,25 @@ typedef struct ItclCallContext {
     int refCount;
 } ItclCallContext;
 
+/*
+ * Call contexts are tracked per call frame.  Records for the frames
+ * of the active call chain live in a ring indexed by frame depth, so
+ * that the common case needs neither hashing nor allocation.  Only a
+ * frame whose slot is already taken by another live frame (coroutines,
+ * uplevel) falls back to a record in infoPtr->frameContext.
+ */
+#define ITCL_FRAME_RING_SIZE 64
+
+typedef struct ItclFrameContext {
+    Tcl_CallFrame *framePtr;    /* frame owning this record, NULL if free */
+    int level;                  /* call frame level of framePtr */
+    Itcl_Stack contexts;        /* stack of ItclCallContext */
+    Itcl_Stack ooContexts;      /* matching Tcl_ObjectContext entries,
+                                 * NULL unless pushed by a method call */
+    ItclCallContext spare;      /* context handed out by Itcl_SetContext
+                                 * and [info] when free */
+} ItclFrameContext;
+
 /*
  * The macro below is used to modify a "char" value (e.g. by casting
  * it to an unsigned character) so that it can be used safely with
@@ -684,6 +952,42 @@ MODULE_SCOPE Tcl_Command Itcl_CmdAliasProc(Tcl_Interp *interp,
 MODULE_SCOPE Tcl_Var Itcl_VarAliasProc(Tcl_Interp *interp,
         Tcl_Namespace *nsPtr, const char *VarName, ClientData clientData);
 MODULE_SCOPE int ItclIsClass(Tcl_Interp *interp, Tcl_Command cmd);
+MODULE_SCOPE Tcl_Var ItclGetObjectVar(ItclObject *ioPtr,
+        ItclVariable *ivPtr);
+MODULE_SCOPE Tcl_Var ItclObjectOptionsVar(Tcl_Interp *interp,
+        ItclObject *ioPtr);
+MODULE_SCOPE void ItclResetResolveCmdCache(ItclClass *iclsPtr);
+MODULE_SCOPE ItclObjectProto *ItclGetObjectProto(ItclClass *iclsPtr);
+MODULE_SCOPE int ItclObjectHasDestructors(ItclObject *ioPtr);
+MODULE_SCOPE Itcl_Stack *ItclNewClassSet(void);
+MODULE_SCOPE void ItclFreeClassSet(Itcl_Stack *setPtr);
+MODULE_SCOPE int ItclClassSetContains(Itcl_Stack *setPtr, ItclClass *iclsPtr);
+MODULE_SCOPE void ItclClassSetAdd(Itcl_Stack *setPtr, ItclClass *iclsPtr);
+MODULE_SCOPE void ItclFreeObjectProto(ItclClass *iclsPtr);
+MODULE_SCOPE ItclDelegateTarget *ItclFindDelegateTarget(ItclObject *ioPtr,
+        Tcl_Obj *optionPtr, int flags);
+MODULE_SCOPE ItclDelegateTarget *ItclCacheDelegateTarget(ItclObject *ioPtr,
+        Tcl_Obj *optionPtr, ItclDelegatedOption *idoPtr,
+	ItclComponent *icPtr, const char *componentName, int flags);
+MODULE_SCOPE void ItclResetDelegateTargets(ItclObject *ioPtr);
+MODULE_SCOPE ItclObjectTables *ItclCreateObjectTables(ItclObject *ioPtr);
+MODULE_SCOPE void ItclInitObjectTables(ItclObjectTables *tablesPtr);
+MODULE_SCOPE void ItclDeleteObjectTables(ItclObjectTables *tablesPtr);
+MODULE_SCOPE ItclVariable *ItclFindPublicVar(ItclClass *iclsPtr,
+        Tcl_Obj *optionPtr);
+MODULE_SCOPE void ItclInitFrameContexts(ItclObjectInfo *infoPtr);
+MODULE_SCOPE void ItclFinishFrameContexts(ItclObjectInfo *infoPtr);
+MODULE_SCOPE void ItclPushCallContext(ItclObjectInfo *infoPtr,
+        Tcl_CallFrame *framePtr, ItclCallContext *callContextPtr,
+        Tcl_ObjectContext contextPtr);
+MODULE_SCOPE ItclCallContext *ItclPopCallContext(ItclObjectInfo *infoPtr,
+        Tcl_Interp *interp, Tcl_ObjectContext contextPtr);
+MODULE_SCOPE ItclCallContext *ItclPushFrameContext(ItclObjectInfo *infoPtr,
+        Tcl_CallFrame *framePtr);
+MODULE_SCOPE void ItclPopFrameContext(ItclObjectInfo *infoPtr,
+        Tcl_CallFrame *framePtr, ItclCallContext *contextPtr);
+MODULE_SCOPE ItclCallContext *ItclPeekFrameContext(ItclObjectInfo *infoPtr,
+        Tcl_CallFrame *framePtr);
 MODULE_SCOPE int ItclCheckCallMethod(ClientData clientData, Tcl_Interp *interp,
         Tcl_ObjectContext contextPtr, Tcl_CallFrame *framePtr, int *isFinished);
 MODULE_SCOPE int ItclAfterCallMethod(ClientData clientData, Tcl_Interp *interp,
@@ -746,6 +1050,7 @@ MODULE_SCOPE int Itcl_WidgetParseInit(Tcl_Interp *interp,
 MODULE_SCOPE void ItclDeleteObjectMetadata(ClientData clientData);
 MODULE_SCOPE void ItclDeleteClassMetadata(ClientData clientData);
 MODULE_SCOPE void ItclDeleteArgList(ItclArgList *arglistPtr);
+MODULE_SCOPE void ItclFinishArgLists(ItclObjectInfo *infoPtr);
 MODULE_SCOPE int Itcl_ClassOptionCmd(ClientData clientData, Tcl_Interp *interp,
         int objc, Tcl_Obj *const objv[]);
 MODULE_SCOPE int DelegatedOptionsInstall(Tcl_Interp *interp,
@@ -780,6 +1085,7 @@ MODULE_SCOPE int ItclCreateDelegatedFunction(Tcl_Interp *interp,
 	ItclDelegatedFunction **idmPtrPtr);
 MODULE_SCOPE void ItclDeleteDelegatedOption(char *cdata);
 MODULE_SCOPE void Itcl_FinishList();
+MODULE_SCOPE void ItclGetMemStats(ItclMemStats *statsPtr);
 MODULE_SCOPE void ItclDeleteDelegatedFunction(ItclDelegatedFunction *idmPtr);
 MODULE_SCOPE void ItclFinishEnsemble(ItclObjectInfo *infoPtr);
 MODULE_SCOPE int Itcl_EnsembleDeleteCmd(ClientData clientData,
@@ -802,6 +1108,12 @@ MODULE_SCOPE int ItclAddClassFunctionDictInfo(Tcl_Interp *interp,
         ItclClass *iclsPtr, ItclMemberFunc *imPtr);
 MODULE_SCOPE int ItclAddClassDelegatedFunctionDictInfo(Tcl_Interp *interp,
         ItclClass *iclsPtr, ItclDelegatedFunction *idmPtr);
+MODULE_SCOPE void ItclFlushDictInfo(Tcl_Interp *interp,
+        ItclObjectInfo *infoPtr);
+MODULE_SCOPE void ItclInitDictInfo(Tcl_Interp *interp,
+        ItclObjectInfo *infoPtr);
+MODULE_SCOPE void ItclFinishDictInfo(Tcl_Interp *interp,
+        ItclObjectInfo *infoPtr);
 MODULE_SCOPE int ItclClassCreateObject(ClientData clientData, Tcl_Interp *interp,
         int objc, Tcl_Obj *const objv[]);
 
@@ -825,6 +1137,38 @@ MODULE_SCOPE Tcl_ObjCmdProc Itcl_AddDelegatedFunctionCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Itcl_SetComponentCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Itcl_ClassHullTypeCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Itcl_ClassWidgetClassCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_NewCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_ProfileOnCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_ProfileOffCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_ProfileResetCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_ProfileReportCmd;
+MODULE_SCOPE ItclProfileRecord *ItclProfileFunctionRecord(
+        ItclMemberFunc *imPtr);
+MODULE_SCOPE void ItclProfileEnter(ItclObjectInfo *infoPtr,
+        ItclProfileRecord *recPtr);
+MODULE_SCOPE void ItclProfileLeave(ItclObjectInfo *infoPtr,
+        ItclProfileRecord *recPtr, int result);
+MODULE_SCOPE void ItclFinishProfile(ItclObjectInfo *infoPtr);
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_MemStatsCmd;
+MODULE_SCOPE int ItclFindMethodC(Tcl_Interp *interp, const char *name,
+        Itcl_MethodCProc **procPtr, int *minArgsPtr, int *maxArgsPtr,
+	ClientData *cDataPtr);
+MODULE_SCOPE int ItclInvokeMethodC(Tcl_Interp *interp, ItclMemberFunc *imPtr,
+        ItclObject *ioPtr, int objc, Tcl_Obj *const objv[]);
+
+/*
+ *  Tag and format version at the start of an "itcl::snapshot save" image.
+ *  Version 2 added "configbody" member records.
+ */
+#define ITCL_SNAPSHOT_MAGIC "itcl-snapshot"
+#define ITCL_SNAPSHOT_VERSION 2
+
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_SnapshotSaveCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_SnapshotLoadCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_SnapshotShareCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_SnapshotAttachCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_SnapshotSharedCmd;
+MODULE_SCOPE Tcl_ObjCmdProc Itcl_SnapshotUnshareCmd;
 
 typedef int (ItclRootMethodProc)(ItclObject *ioPtr, Tcl_Interp *interp,
 	int objc, Tcl_Obj *const objv[]);
@@ -8,7 +8,7 @@
 /* !BEGIN!: Do not edit below this line. */
 
 #define ITCLINT_STUBS_EPOCH 0
-#define ITCLINT_STUBS_REVISION 152
+#define ITCLINT_STUBS_REVISION 157
 
 #ifdef __cplusplus
 extern "C" {
@@ -521,6 +521,10 @@ ITCLAPI void		Itcl_UnsetContext(Tcl_Interp *interp);
 ITCLAPI const char *	ItclGetInstanceVar(Tcl_Interp *interp,
 				const char *name, const char *name2,
 				ItclObject *ioPtr, ItclClass *iclsPtr);
+/* 185 */
+ITCLAPI int		Itcl_CreateObjects(Tcl_Interp *interp,
+				ItclClass *iclsPtr, int count, int objc,
+				Tcl_Obj *const objv[], Tcl_Obj *namesPtr);
 
 typedef struct ItclIntStubs {
     int magic;
@@ -713,6 +717,7 @@ typedef struct ItclIntStubs {
     void (*itcl_SetContext) (Tcl_Interp *interp, ItclObject *ioPtr); /* 182 */
     void (*itcl_UnsetContext) (Tcl_Interp *interp); /* 183 */
     const char * (*itclGetInstanceVar) (Tcl_Interp *interp, const char *name, const char *name2, ItclObject *ioPtr, ItclClass *iclsPtr); /* 184 */
+    int (*itcl_CreateObjects) (Tcl_Interp *interp, ItclClass *iclsPtr, int count, int objc, Tcl_Obj *const objv[], Tcl_Obj *namesPtr); /* 185 */
 } ItclIntStubs;
 
 extern const ItclIntStubs *itclIntStubsPtr;
@@ -1038,6 +1043,8 @@ extern const ItclIntStubs *itclIntStubsPtr;
 	(itclIntStubsPtr->itcl_UnsetContext) /* 183 */
 #define ItclGetInstanceVar \
 	(itclIntStubsPtr->itclGetInstanceVar) /* 184 */
+#define Itcl_CreateObjects \
+	(itclIntStubsPtr->itcl_CreateObjects) /* 185 */
 
 #endif /* defined(USE_ITCL_STUBS) */
 
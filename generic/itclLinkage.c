@@ -14,7 +14,8 @@
  *
  *  This part adds a mechanism for integrating C procedures into
  *  [incr Tcl] classes as methods and procs.  Each C procedure must
- *  either be declared via Itcl_RegisterC() or dynamically loaded.
+ *  either be declared via Itcl_RegisterC(), Itcl_RegisterObjC() or
+ *  Itcl_RegisterMethodC(), or dynamically loaded.
  *
  * ========================================================================
  *  AUTHOR:  Michael J. McLennan
@@ -39,6 +40,9 @@ typedef struct ItclCfunc {
     Tcl_ObjCmdProc *objCmdProc;     /* new (objc,objv) command handler */
     ClientData clientData;          /* client data passed into this function */
     Tcl_CmdDeleteProc *deleteProc;  /* proc called to free clientData */
+    Itcl_MethodCProc *methodCProc;  /* method handler with fixed signature */
+    int minArgs;                    /* argument counts for methodCProc */
+    int maxArgs;
 } ItclCfunc;
 
 static Tcl_HashTable* ItclGetRegisteredProcs(Tcl_Interp *interp);
@@ -118,6 +122,7 @@ Itcl_RegisterC(
     } else {
         cfunc = (ItclCfunc*)ckalloc(sizeof(ItclCfunc));
         cfunc->objCmdProc = NULL;
+        cfunc->methodCProc = NULL;
     }
 
     cfunc->argCmdProc = proc;
@@ -203,6 +208,7 @@ Itcl_RegisterObjC(
     else {
         cfunc = (ItclCfunc*)ckalloc(sizeof(ItclCfunc));
         cfunc->argCmdProc = NULL;
+        cfunc->methodCProc = NULL;
     }
 
     cfunc->objCmdProc = proc;
@@ -214,6 +220,93 @@ Itcl_RegisterObjC(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_RegisterMethodC()
+ *
+ *  Used to associate a symbolic name with a C procedure that implements
+ *  methods.  Unlike the procedures of Itcl_RegisterObjC, the handler
+ *  is called with the object and the class of the method, after the
+ *  number of arguments has been checked against minArgs and maxArgs
+ *  (no limit if maxArgs is negative).  It runs without a call frame
+ *  or an object context of its own, so it can't evaluate code that
+ *  refers to class members.  The objv array holds the method name,
+ *  followed by the arguments.
+ *
+ *  A name registered with this procedure can also have an arg-style
+ *  or obj-style handler; that one is used for procs.
+ *
+ *  Returns TCL_OK on success, or TCL_ERROR (along with an error message
+ *  in interp->result) if anything goes wrong.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_RegisterMethodC(
+    Tcl_Interp *interp,             /* interpreter handling this registration */
+    const char *name,               /* symbolic name for procedure */
+    Itcl_MethodCProc *proc,         /* procedure handling the method */
+    int minArgs,                    /* minimum number of arguments */
+    int maxArgs,                    /* maximum number of arguments or -1 */
+    ClientData clientData,          /* client data associated with proc */
+    Tcl_CmdDeleteProc *deleteProc)  /* proc called to free up client data */
+{
+    int newEntry;
+    Tcl_HashEntry *entry;
+    Tcl_HashTable *procTable;
+    ItclCfunc *cfunc;
+
+    /*
+     *  Make sure that a proc was specified.
+     */
+    if (!proc) {
+        Tcl_AppendResult(interp, "initialization error: null pointer for ",
+            "C procedure \"", name, "\"",
+            NULL);
+        return TCL_ERROR;
+    }
+    if ((minArgs < 0) || ((maxArgs >= 0) && (maxArgs < minArgs))) {
+        Tcl_AppendResult(interp, "initialization error: bad argument ",
+            "counts for C procedure \"", name, "\"",
+            NULL);
+        return TCL_ERROR;
+    }
+
+    /*
+     *  Add a new entry for the given procedure.  If an entry with
+     *  this name already exists, then make sure that it was defined
+     *  with the same proc.
+     */
+    procTable = ItclGetRegisteredProcs(interp);
+    entry = Tcl_CreateHashEntry(procTable, name, &newEntry);
+    if (!newEntry) {
+        cfunc = (ItclCfunc*)Tcl_GetHashValue(entry);
+        if (cfunc->methodCProc != NULL && cfunc->methodCProc != proc) {
+            Tcl_AppendResult(interp, "initialization error: C procedure ",
+                "with name \"", name, "\" already defined",
+                NULL);
+            return TCL_ERROR;
+        }
+
+        if (cfunc->deleteProc != NULL) {
+            (*cfunc->deleteProc)(cfunc->clientData);
+        }
+    } else {
+        cfunc = (ItclCfunc*)ckalloc(sizeof(ItclCfunc));
+        cfunc->argCmdProc = NULL;
+        cfunc->objCmdProc = NULL;
+    }
+
+    cfunc->methodCProc = proc;
+    cfunc->minArgs = minArgs;
+    cfunc->maxArgs = maxArgs;
+    cfunc->clientData = clientData;
+    cfunc->deleteProc = deleteProc;
+
+    Tcl_SetHashValue(entry, cfunc);
+    return TCL_OK;
+}
+
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_FindC()
@@ -259,6 +352,46 @@ Itcl_FindC(
     return (*argProcPtr != NULL || *objProcPtr != NULL);
 }
 
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFindMethodC()
+ *
+ *  Like Itcl_FindC, but for the method handlers registered by
+ *  Itcl_RegisterMethodC.  Returns non-zero if the name is recognized
+ *  and the handler and its argument counts are returned; returns zero
+ *  otherwise.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclFindMethodC(
+    Tcl_Interp *interp,           /* interpreter handling this registration */
+    const char *name,             /* symbolic name for procedure */
+    Itcl_MethodCProc **procPtr,   /* returns method handler */
+    int *minArgsPtr,              /* returns minimum number of arguments */
+    int *maxArgsPtr,              /* returns maximum number of arguments */
+    ClientData *cDataPtr)         /* returns client data */
+{
+    Tcl_HashEntry *entry;
+    Tcl_HashTable *procTable;
+    ItclCfunc *cfunc;
+
+    *procPtr = NULL;  /* assume info won't be found */
+
+    procTable = (Tcl_HashTable*)Tcl_GetAssocData(interp, "itcl_RegC", NULL);
+    if (procTable) {
+        entry = Tcl_FindHashEntry(procTable, name);
+        if (entry) {
+            cfunc = (ItclCfunc*)Tcl_GetHashValue(entry);
+            *procPtr    = cfunc->methodCProc;
+            *minArgsPtr = cfunc->minArgs;
+            *maxArgsPtr = cfunc->maxArgs;
+            *cDataPtr   = cfunc->clientData;
+        }
+    }
+    return (*procPtr != NULL);
+}
+
 
 /*
  * ------------------------------------------------------------------------
@@ -488,6 +488,7 @@ ItclCreateMemberFunc(
     imPtr->iclsPtr    = iclsPtr;
     imPtr->infoPtr    = iclsPtr->infoPtr;
     imPtr->protection = Itcl_Protection(interp, 0);
+    imPtr->slot       = -1;
     imPtr->namePtr    = Tcl_NewStringObj(Tcl_GetString(namePtr), -1);
     Tcl_IncrRefCount(imPtr->namePtr);
     imPtr->fullNamePtr = Tcl_NewStringObj(
@@ -910,7 +911,10 @@ ItclCreateMemberCode(
         if (*body == '@') {
             Tcl_CmdProc *argCmdProc;
             Tcl_ObjCmdProc *objCmdProc;
+            Itcl_MethodCProc *methodCProc;
             ClientData cdata;
+	    int minArgs;
+	    int maxArgs;
 	    int isDone;
 
 	    isDone = 0;
@@ -989,7 +993,14 @@ ItclCreateMemberCode(
 	    if (strcmp(body, "@itcl-builtin-classunknown") == 0) {
 	        isDone = 1;
 	    }
-	    if (!isDone) {
+	    if (!isDone && !(flags & ITCL_COMMON) && ItclFindMethodC(interp,
+	            body+1, &methodCProc, &minArgs, &maxArgs, &cdata)) {
+                mcode->flags |= ITCL_IMPLEMENT_METHODC;
+                mcode->cfunc.methodCmd = methodCProc;
+                mcode->clientData = cdata;
+                mcode->minArgs = minArgs;
+                mcode->maxArgs = maxArgs;
+	    } else if (!isDone) {
                 if (!Itcl_FindC(interp, body+1, &argCmdProc, &objCmdProc,
 		        &cdata)) {
 		    Tcl_AppendResult(interp,
@@ -1241,6 +1252,7 @@ Itcl_EvalMemberCode(
     Tcl_Obj *const objv[])    /* argument objects */
 {
     ItclMemberCode *mcode;
+    ItclProfileRecord *recPtr;
     void *callbackPtr;
     int result = TCL_OK;
     int i;
@@ -1272,6 +1284,15 @@ Itcl_EvalMemberCode(
     if (((mcode->flags & ITCL_IMPLEMENT_OBJCMD) != 0) ||
             ((mcode->flags & ITCL_IMPLEMENT_ARGCMD) != 0)) {
 
+	/*
+	 *  C code does not pass ItclCheckCallMethod, so it is
+	 *  profiled here.
+	 */
+	recPtr = NULL;
+	if (imPtr->infoPtr->profiling) {
+	    recPtr = ItclProfileFunctionRecord(imPtr);
+	    ItclProfileEnter(imPtr->infoPtr, recPtr);
+	}
         if ((mcode->flags & ITCL_IMPLEMENT_OBJCMD) != 0) {
             result = (*mcode->cfunc.objCmd)(mcode->clientData,
                     interp, objc, objv);
@@ -1289,6 +1310,11 @@ Itcl_EvalMemberCode(
                 ckfree((char*)argv);
 	    }
         }
+	if (recPtr != NULL) {
+	    ItclProfileLeave(imPtr->infoPtr, recPtr, result);
+	}
+    } else if ((mcode->flags & ITCL_IMPLEMENT_METHODC) != 0) {
+        result = ItclInvokeMethodC(interp, imPtr, contextIoPtr, objc, objv);
     } else {
         if ((mcode->flags & ITCL_IMPLEMENT_TCL) != 0) {
             callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
@@ -1302,6 +1328,88 @@ Itcl_EvalMemberCode(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInvokeMethodC()
+ *
+ *  Calls the handler of a method implemented by a procedure from
+ *  Itcl_RegisterMethodC.  The arguments (objc,objv) start with the
+ *  method name.  The number of arguments is checked here; the handler
+ *  is called directly, without a call frame or an object context.
+ *
+ *  Returns TCL_OK/TCL_ERROR along with the result of the handler, or
+ *  an error message in the interpreter.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclInvokeMethodC(
+    Tcl_Interp *interp,       /* current interpreter */
+    ItclMemberFunc *imPtr,    /* member function being called */
+    ItclObject *ioPtr,        /* object context */
+    int objc,                 /* number of arguments */
+    Tcl_Obj *const objv[])    /* method name followed by the arguments */
+{
+    ItclMemberCode *mcode = imPtr->codePtr;
+    ItclProfileRecord *recPtr;
+    int result;
+
+    if (ioPtr == NULL) {
+        Tcl_AppendResult(interp,
+	        "cannot access object-specific info without an object context",
+		NULL);
+        return TCL_ERROR;
+    }
+    if ((objc - 1 < mcode->minArgs)
+            || ((mcode->maxArgs >= 0) && (objc - 1 > mcode->maxArgs))) {
+	int i;
+
+        Tcl_AppendResult(interp, "wrong # args: should be \"",
+	        Tcl_GetString(ioPtr->namePtr), " ",
+		Tcl_GetString(imPtr->namePtr), NULL);
+
+	/*
+	 *  The declared arglist describes the arguments only if it
+	 *  takes as many as the handler was registered for.
+	 */
+	if ((imPtr->usagePtr != NULL) &&
+	        (imPtr->argcount == mcode->minArgs) &&
+		(imPtr->maxargcount == mcode->maxArgs)) {
+	    if (*Tcl_GetString(imPtr->usagePtr)) {
+		Tcl_AppendResult(interp, " ", Tcl_GetString(imPtr->usagePtr),
+		        NULL);
+	    }
+	} else {
+	    for (i = 0; i < mcode->minArgs; i++) {
+		Tcl_AppendResult(interp, " arg", NULL);
+	    }
+	    if (mcode->maxArgs < 0) {
+		Tcl_AppendResult(interp, " ?arg ...?", NULL);
+	    }
+	    for (i = mcode->minArgs; i < mcode->maxArgs; i++) {
+		Tcl_AppendResult(interp, " ?arg?", NULL);
+	    }
+	}
+	Tcl_AppendResult(interp, "\"", NULL);
+        return TCL_ERROR;
+    }
+
+    recPtr = NULL;
+    if (imPtr->infoPtr->profiling) {
+        recPtr = ItclProfileFunctionRecord(imPtr);
+        ItclProfileEnter(imPtr->infoPtr, recPtr);
+    }
+    Itcl_PreserveData(mcode);
+    Itcl_PreserveData(ioPtr);
+    result = (*mcode->cfunc.methodCmd)(mcode->clientData, interp, ioPtr,
+            imPtr->iclsPtr, objc, objv);
+    Itcl_ReleaseData(ioPtr);
+    Itcl_ReleaseData(mcode);
+    if (recPtr != NULL) {
+        ItclProfileLeave(imPtr->infoPtr, recPtr, result);
+    }
+    return result;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclEquivArgLists()
@@ -1380,6 +1488,325 @@ EquivArgLists(
     return 1;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInitFrameContexts()
+ *  ItclFinishFrameContexts()
+ *
+ *  Allocate and release the per-depth ring of call frame context
+ *  records, together with any overflow records still registered in
+ *  infoPtr->frameContext.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclInitFrameContexts(
+    ItclObjectInfo *infoPtr)
+{
+    ItclFrameContext *recPtr;
+    int i;
+
+    Tcl_InitHashTable(&infoPtr->frameContext, TCL_ONE_WORD_KEYS);
+    infoPtr->frameRing = (ItclFrameContext *)ckalloc(
+	    ITCL_FRAME_RING_SIZE * sizeof(ItclFrameContext));
+    memset(infoPtr->frameRing, 0,
+	    ITCL_FRAME_RING_SIZE * sizeof(ItclFrameContext));
+    for (i = 0; i < ITCL_FRAME_RING_SIZE; i++) {
+	recPtr = &infoPtr->frameRing[i];
+	Itcl_InitStack(&recPtr->contexts);
+	Itcl_InitStack(&recPtr->ooContexts);
+    }
+}
+
+void
+ItclFinishFrameContexts(
+    ItclObjectInfo *infoPtr)
+{
+    Tcl_HashSearch place;
+    Tcl_HashEntry *hPtr;
+    ItclFrameContext *recPtr;
+    int i;
+
+    hPtr = Tcl_FirstHashEntry(&infoPtr->frameContext, &place);
+    while (hPtr) {
+	recPtr = (ItclFrameContext *)Tcl_GetHashValue(hPtr);
+	Itcl_DeleteStack(&recPtr->contexts);
+	Itcl_DeleteStack(&recPtr->ooContexts);
+	Itcl_Free(recPtr);
+	hPtr = Tcl_NextHashEntry(&place);
+    }
+    Tcl_DeleteHashTable(&infoPtr->frameContext);
+
+    if (infoPtr->frameRing != NULL) {
+	for (i = 0; i < ITCL_FRAME_RING_SIZE; i++) {
+	    recPtr = &infoPtr->frameRing[i];
+	    Itcl_DeleteStack(&recPtr->contexts);
+	    Itcl_DeleteStack(&recPtr->ooContexts);
+	}
+	ckfree((char *)infoPtr->frameRing);
+	infoPtr->frameRing = NULL;
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FindFrameContext()
+ *
+ *  Returns the context record of the given call frame, or NULL if the
+ *  frame has no Itcl call context.  The ring slot for the frame depth
+ *  is checked first; the overflow table is probed only when it is not
+ *  empty.
+ * ------------------------------------------------------------------------
+ */
+static ItclFrameContext *
+FindFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr)
+{
+    Tcl_HashEntry *hPtr;
+    ItclFrameContext *recPtr;
+
+    recPtr = &infoPtr->frameRing[Itcl_GetCallFrameLevel(framePtr)
+	    & (ITCL_FRAME_RING_SIZE - 1)];
+    if (recPtr->framePtr == framePtr) {
+	return recPtr;
+    }
+    if (infoPtr->frameContext.numEntries > 0) {
+	hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
+	if (hPtr != NULL) {
+	    return (ItclFrameContext *)Tcl_GetHashValue(hPtr);
+	}
+    }
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  CreateFrameContext()
+ *
+ *  Returns the context record of the given call frame, claiming the
+ *  ring slot for its depth or, if that slot belongs to another live
+ *  frame, an overflow record in infoPtr->frameContext.
+ * ------------------------------------------------------------------------
+ */
+static ItclFrameContext *
+CreateFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr)
+{
+    Tcl_HashEntry *hPtr;
+    ItclFrameContext *recPtr;
+    int level;
+    int isNew;
+
+    recPtr = FindFrameContext(infoPtr, framePtr);
+    if (recPtr != NULL) {
+	return recPtr;
+    }
+    level = Itcl_GetCallFrameLevel(framePtr);
+    recPtr = &infoPtr->frameRing[level & (ITCL_FRAME_RING_SIZE - 1)];
+    if (recPtr->framePtr != NULL) {
+	hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
+		(char *)framePtr, &isNew);
+	recPtr = (ItclFrameContext *)Itcl_Alloc(sizeof(ItclFrameContext));
+	Itcl_InitStack(&recPtr->contexts);
+	Itcl_InitStack(&recPtr->ooContexts);
+	Tcl_SetHashValue(hPtr, recPtr);
+    }
+    recPtr->framePtr = framePtr;
+    recPtr->level = level;
+    return recPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ReleaseFrameContext()
+ *
+ *  Gives back the record of a frame once its context stack is empty.
+ *  Ring slots are kept (with their stack storage) for reuse.
+ * ------------------------------------------------------------------------
+ */
+static void
+ReleaseFrameContext(
+    ItclObjectInfo *infoPtr,
+    ItclFrameContext *recPtr)
+{
+    Tcl_HashEntry *hPtr;
+
+    if (Itcl_GetStackSize(&recPtr->contexts) > 0) {
+	return;
+    }
+    if ((recPtr >= infoPtr->frameRing)
+	    && (recPtr < infoPtr->frameRing + ITCL_FRAME_RING_SIZE)) {
+	recPtr->framePtr = NULL;
+	return;
+    }
+    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
+	    (char *)recPtr->framePtr);
+    assert(hPtr);
+    Tcl_DeleteHashEntry(hPtr);
+    Itcl_DeleteStack(&recPtr->contexts);
+    Itcl_DeleteStack(&recPtr->ooContexts);
+    Itcl_Free(recPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPushCallContext()
+ *  ItclPopCallContext()
+ *
+ *  Push the call context of a method invocation onto the context
+ *  stack of its call frame, and pop it again given the TclOO context
+ *  of the same invocation.  By the time the pop runs, the method frame
+ *  usually has been popped already, so the record is searched for at
+ *  the depth just below the current frame before the ring and the
+ *  overflow table are scanned.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclPushCallContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr,
+    ItclCallContext *callContextPtr,
+    Tcl_ObjectContext contextPtr)
+{
+    ItclFrameContext *recPtr = CreateFrameContext(infoPtr, framePtr);
+
+    Itcl_PushStack(callContextPtr, &recPtr->contexts);
+    Itcl_PushStack(contextPtr, &recPtr->ooContexts);
+}
+
+static int
+FrameContextMatches(
+    ItclFrameContext *recPtr,
+    Tcl_ObjectContext contextPtr)
+{
+    return (recPtr->framePtr != NULL)
+	    && (Itcl_GetStackSize(&recPtr->ooContexts) > 0)
+	    && (Itcl_PeekStack(&recPtr->ooContexts) == (ClientData)contextPtr);
+}
+
+ItclCallContext *
+ItclPopCallContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_Interp *interp,
+    Tcl_ObjectContext contextPtr)
+{
+    Tcl_HashSearch place;
+    Tcl_HashEntry *hPtr;
+    ItclFrameContext *recPtr;
+    ItclFrameContext *bestPtr;
+    ItclCallContext *callContextPtr;
+    int level;
+    int i;
+
+    bestPtr = NULL;
+    level = Itcl_GetCallFrameLevel(Itcl_GetUplevelCallFrame(interp, 0));
+    for (i = 1; i >= 0 && bestPtr == NULL; i--) {
+	recPtr = &infoPtr->frameRing[(level + i)
+		& (ITCL_FRAME_RING_SIZE - 1)];
+	if ((recPtr->level == level + i)
+		&& FrameContextMatches(recPtr, contextPtr)
+		&& (infoPtr->frameContext.numEntries == 0)) {
+	    bestPtr = recPtr;
+	}
+    }
+    if (bestPtr == NULL) {
+	for (i = 0; i < ITCL_FRAME_RING_SIZE; i++) {
+	    recPtr = &infoPtr->frameRing[i];
+	    if (FrameContextMatches(recPtr, contextPtr)
+		    && ((bestPtr == NULL) || (recPtr->level > bestPtr->level))) {
+		bestPtr = recPtr;
+	    }
+	}
+	hPtr = Tcl_FirstHashEntry(&infoPtr->frameContext, &place);
+	while (hPtr) {
+	    recPtr = (ItclFrameContext *)Tcl_GetHashValue(hPtr);
+	    if (FrameContextMatches(recPtr, contextPtr)
+		    && ((bestPtr == NULL) || (recPtr->level > bestPtr->level))) {
+		bestPtr = recPtr;
+	    }
+	    hPtr = Tcl_NextHashEntry(&place);
+	}
+    }
+    if (bestPtr == NULL) {
+	return NULL;
+    }
+    Itcl_PopStack(&bestPtr->ooContexts);
+    callContextPtr = (ItclCallContext *)Itcl_PopStack(&bestPtr->contexts);
+    ReleaseFrameContext(infoPtr, bestPtr);
+    return callContextPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPushFrameContext()
+ *  ItclPopFrameContext()
+ *  ItclPeekFrameContext()
+ *
+ *  Manage plain object contexts that are not tied to a method
+ *  invocation (Itcl_SetContext, [info]).  The first such context of a
+ *  frame is the spare embedded in its record, so no allocation is
+ *  needed in the common case.
+ * ------------------------------------------------------------------------
+ */
+ItclCallContext *
+ItclPushFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr)
+{
+    ItclFrameContext *recPtr = CreateFrameContext(infoPtr, framePtr);
+    ItclCallContext *contextPtr;
+
+    if (recPtr->spare.refCount == 0) {
+	contextPtr = &recPtr->spare;
+    } else {
+	contextPtr = (ItclCallContext *)Itcl_Alloc(sizeof(ItclCallContext));
+    }
+    memset(contextPtr, 0, sizeof(ItclCallContext));
+    contextPtr->refCount = 1;
+    Itcl_PushStack(contextPtr, &recPtr->contexts);
+    Itcl_PushStack(NULL, &recPtr->ooContexts);
+    return contextPtr;
+}
+
+void
+ItclPopFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr,
+    ItclCallContext *contextPtr)
+{
+    ItclFrameContext *recPtr = FindFrameContext(infoPtr, framePtr);
+
+    if ((recPtr == NULL)
+	    || (Itcl_PeekStack(&recPtr->contexts) != (ClientData)contextPtr)) {
+	Tcl_Panic("Context stack mismatch!");
+    }
+    Itcl_PopStack(&recPtr->contexts);
+    Itcl_PopStack(&recPtr->ooContexts);
+    if (contextPtr->refCount-- > 1) {
+	Tcl_Panic("frame context ref count not zero!");
+    }
+    if (contextPtr == &recPtr->spare) {
+	contextPtr->refCount = 0;
+    } else {
+	Itcl_Free(contextPtr);
+    }
+    ReleaseFrameContext(infoPtr, recPtr);
+}
+
+ItclCallContext *
+ItclPeekFrameContext(
+    ItclObjectInfo *infoPtr,
+    Tcl_CallFrame *framePtr)
+{
+    ItclFrameContext *recPtr = FindFrameContext(infoPtr, framePtr);
+
+    if (recPtr == NULL) {
+	return NULL;
+    }
+    return (ItclCallContext *)Itcl_PeekStack(&recPtr->contexts);
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_GetContext()
@@ -1401,29 +1828,12 @@ Itcl_SetContext(
     Tcl_Interp *interp,
     ItclObject *ioPtr)
 {
-    int isNew;
-    Itcl_Stack *stackPtr;
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr, &isNew);
-    ItclCallContext *contextPtr
-	    = (ItclCallContext *) ckalloc(sizeof(ItclCallContext));
+    ItclCallContext *contextPtr = ItclPushFrameContext(infoPtr, framePtr);
 
-    memset(contextPtr, 0, sizeof(ItclCallContext));
     contextPtr->ioPtr = ioPtr;
-    contextPtr->refCount = 1;
-
-    if (!isNew) {
-	Tcl_Panic("frame already has context?!");
-    }
-
-    stackPtr = (Itcl_Stack *) ckalloc(sizeof(Itcl_Stack));
-    Itcl_InitStack(stackPtr);
-    Tcl_SetHashValue(hPtr, stackPtr);
-
-    Itcl_PushStack(contextPtr, stackPtr);
 }
 
 void
@@ -1433,21 +1843,9 @@ Itcl_UnsetContext(
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr);
-    Itcl_Stack *stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-    ItclCallContext *contextPtr = (ItclCallContext *)Itcl_PopStack(stackPtr);
 
-    if (Itcl_GetStackSize(stackPtr) > 0) {
-	Tcl_Panic("frame context stack not empty!");
-    }
-    Itcl_DeleteStack(stackPtr);
-    ckfree((char *) stackPtr);
-    Tcl_DeleteHashEntry(hPtr);
-    if (contextPtr->refCount-- > 1) {
-	Tcl_Panic("frame context ref count not zero!");
-    }
-    ckfree((char *)contextPtr);
+    ItclPopFrameContext(infoPtr, framePtr,
+	    ItclPeekFrameContext(infoPtr, framePtr));
 }
 
 int
@@ -1464,15 +1862,11 @@ Itcl_GetContext(
     /* Try to map it to a context stack. */
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr);
-    if (hPtr) {
-	/* Frame maps to a context stack. */
-	Itcl_Stack *stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-	ItclCallContext *contextPtr = (ItclCallContext *)Itcl_PeekStack(stackPtr);
-
-	assert(contextPtr);
+    ItclCallContext *contextPtr = ItclPeekFrameContext(infoPtr, framePtr);
+    Tcl_HashEntry *hPtr;
 
+    if (contextPtr) {
+	/* Frame maps to a context stack. */
 	if (contextPtr->objectFlags & ITCL_OBJECT_ROOT_METHOD) {
 	    ItclObject *ioPtr = contextPtr->ioPtr;
 
@@ -1616,6 +2010,38 @@ Itcl_GetMemberFuncUsage(
     }
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  CallBoundMethod()
+ *
+ *  Runs a method call bound by NRExecMethod.  Like CallItclObjectCmd
+ *  followed by ItclObjectCmd, but the member function is already
+ *  known: TclOO gets its class as start class, and ItclMapMethodNameProc
+ *  passes the name through unchanged.
+ * ------------------------------------------------------------------------
+ */
+static int
+CallBoundMethod(
+    ClientData data[],
+    Tcl_Interp *interp,
+    int result)
+{
+    ItclMemberFunc *imPtr = (ItclMemberFunc *)data[0];
+    ItclObject *ioPtr = (ItclObject *)data[1];
+    Tcl_Obj *const *objv = (Tcl_Obj *const *)data[3];
+    int objc = PTR2INT(data[2]);
+
+    ioPtr->hadConstructorError = 0;
+    imPtr->infoPtr->directImPtr = imPtr;
+    result = Itcl_PublicObjectCmd(ioPtr->oPtr, interp,
+            imPtr->iclsPtr->clsPtr, objc, objv);
+    imPtr->infoPtr->directImPtr = NULL;
+    if ((result != TCL_OK) && (ioPtr->hadConstructorError == 0)) {
+        ioPtr->hadConstructorError = 1;
+    }
+    return result;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_ExecMethod()
@@ -1693,6 +2119,58 @@ NRExecMethod(
 		imPtr = clookup->imPtr;
             }
         }
+
+	/*
+	 *  A plain call of a Tcl method of an ::itcl::class object,
+	 *  usually from one of the object's own methods, is bound to
+	 *  the member function found above.  That saves the parse of
+	 *  the name in ItclObjectCmd and the access check and lookup in
+	 *  ItclMapMethodNameProc, and TclOO finds the call chain cached
+	 *  in the private name of the method.  Anything else, and all
+	 *  calls the caller may not make, take the general path, which
+	 *  also reports the errors.
+	 */
+	if ((ioPtr->oPtr != NULL) && !(ioPtr->flags & (ITCL_OBJECT_IS_DELETED|
+		ITCL_OBJECT_IS_DESTRUCTED|ITCL_OBJECT_IS_DESTROYED|
+		ITCL_OBJECT_IS_RENAMED|ITCL_OBJECT_CLASS_DESTRUCTED|
+		ITCL_TCLOO_OBJECT_IS_DELETED))
+		&& (ioPtr->iclsPtr->flags & ITCL_CLASS)
+		&& !(imPtr->flags & (ITCL_COMMON|ITCL_CONSTRUCTOR|
+		ITCL_DESTRUCTOR))
+		&& (Itcl_GetMemberCode(interp, imPtr) == TCL_OK)
+		&& ((imPtr->codePtr->flags & (ITCL_IMPLEMENT_TCL|ITCL_BUILTIN))
+		== ITCL_IMPLEMENT_TCL)
+		&& (Tcl_ObjectGetMethodNameMapper(ioPtr->oPtr)
+		== ItclMapMethodNameProc)
+		&& Itcl_CanAccessFunc(imPtr, Tcl_GetCurrentNamespace(interp))) {
+	    Tcl_Obj **newObjv;
+	    void *callbackPtr;
+
+	    if (imPtr->callNamePtr == NULL) {
+		imPtr->callNamePtr = Tcl_NewStringObj(
+			Tcl_GetString(imPtr->namePtr), -1);
+		Tcl_IncrRefCount(imPtr->callNamePtr);
+	    }
+	    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc+1));
+	    newObjv[0] = Tcl_NewStringObj("my", 2);
+	    newObjv[1] = imPtr->callNamePtr;
+	    memcpy(newObjv+2, objv+1, (sizeof(Tcl_Obj*)*(objc-1)));
+	    Tcl_IncrRefCount(newObjv[0]);
+	    Tcl_IncrRefCount(newObjv[1]);
+
+	    Itcl_PreserveData(imPtr);
+	    Itcl_PreserveData(ioPtr);
+	    callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
+	    Tcl_NRAddCallback(interp, CallBoundMethod, imPtr, ioPtr,
+		    INT2PTR(objc+1), newObjv);
+	    result = Itcl_NRRunCallbacks(interp, callbackPtr);
+	    Itcl_ReleaseData(ioPtr);
+	    Tcl_DecrRefCount(newObjv[1]);
+	    Tcl_DecrRefCount(newObjv[0]);
+	    ckfree((char *)newObjv);
+	    Itcl_ReleaseData(imPtr);
+	    return result;
+	}
     }
 
     /*
@@ -1879,8 +2357,7 @@ Itcl_ConstructBase(
 	Tcl_HashEntry *entry;
         ItclClass *iclsPtr = (ItclClass*)Itcl_GetListValue(elem);
 
-        if (Tcl_FindHashEntry(contextObj->constructed,
-		(char *)iclsPtr->namePtr)) {
+        if (ItclClassSetContains(contextObj->constructed, iclsPtr)) {
 
 	    /* Already constructed, nothing to do. */
 	    continue;
@@ -2039,6 +2516,195 @@ Itcl_InvokeMethodIfExists(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_GetMethod()
+ *
+ *  Looks up a method of a class for C code that calls it many times.
+ *  The method name may be qualified with the name of a base class, as
+ *  in "Base::method".  The returned token stays valid until it is
+ *  released with Itcl_ReleaseMethod, even if the class is deleted.
+ *
+ *  Returns a token for the method, or NULL (along with an error
+ *  message in the interpreter) if anything goes wrong.
+ * ------------------------------------------------------------------------
+ */
+Itcl_Method
+Itcl_GetMethod(
+    Tcl_Interp *interp,       /* current interpreter */
+    const char *className,    /* name of the class */
+    const char *methodName)   /* name of the method */
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_Obj *objPtr;
+    ItclClass *iclsPtr;
+    ItclMemberFunc *imPtr;
+    ItclMethodHandle *handlePtr;
+
+    iclsPtr = Itcl_FindClass(interp, className, /* autoload */ 1);
+    if (iclsPtr == NULL) {
+        return NULL;
+    }
+    objPtr = Tcl_NewStringObj(methodName, -1);
+    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)objPtr);
+    Tcl_DecrRefCount(objPtr);
+    imPtr = NULL;
+    if (hPtr != NULL) {
+        imPtr = ((ItclCmdLookup *)Tcl_GetHashValue(hPtr))->imPtr;
+    }
+    if ((imPtr == NULL) || (imPtr->flags & (ITCL_COMMON|ITCL_CONSTRUCTOR|
+            ITCL_DESTRUCTOR))) {
+        Tcl_AppendResult(interp, "class \"",
+	        Tcl_GetString(iclsPtr->fullNamePtr), "\" has no method \"",
+		methodName, "\"", NULL);
+        return NULL;
+    }
+
+    handlePtr = (ItclMethodHandle *)ckalloc(sizeof(ItclMethodHandle));
+    handlePtr->imPtr = imPtr;
+    handlePtr->namePtr = Tcl_NewStringObj(
+            Tcl_GetString(imPtr->namePtr), -1);
+    Tcl_IncrRefCount(handlePtr->namePtr);
+    Itcl_PreserveData(imPtr);
+    Itcl_PreserveData(imPtr->iclsPtr);
+    return (Itcl_Method)handlePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_ReleaseMethod()
+ *
+ *  Releases a token handed out by Itcl_GetMethod.  After this call,
+ *  the token is no longer valid.
+ * ------------------------------------------------------------------------
+ */
+void
+Itcl_ReleaseMethod(
+    Itcl_Method method)       /* token from Itcl_GetMethod */
+{
+    ItclMethodHandle *handlePtr = (ItclMethodHandle *)method;
+    ItclClass *iclsPtr = handlePtr->imPtr->iclsPtr;
+
+    Tcl_DecrRefCount(handlePtr->namePtr);
+    Itcl_ReleaseData(handlePtr->imPtr);
+    Itcl_ReleaseData(iclsPtr);
+    ckfree((char *)handlePtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  CallInvokeMethod()
+ *
+ *  Callback of Itcl_InvokeMethod that calls the method through TclOO,
+ *  with the name mapper told which member function is meant.
+ * ------------------------------------------------------------------------
+ */
+static int
+CallInvokeMethod(
+    ClientData data[],
+    Tcl_Interp *interp,
+    int result)
+{
+    ItclMemberFunc *imPtr = (ItclMemberFunc *)data[0];
+    ItclObject *ioPtr = (ItclObject *)data[1];
+    Tcl_Obj *const *objv = (Tcl_Obj *const *)data[3];
+    int objc = PTR2INT(data[2]);
+
+    /*
+     *  The method is known, so let ItclMapMethodNameProc pass the
+     *  name through unchanged.  TclOO calls the mapper before anything
+     *  else, and objects get it only after their construction.
+     */
+    if (Tcl_ObjectGetMethodNameMapper(ioPtr->oPtr) == ItclMapMethodNameProc) {
+        imPtr->infoPtr->directImPtr = imPtr;
+    }
+    result = Itcl_PublicObjectCmd(ioPtr->oPtr, interp,
+            imPtr->iclsPtr->clsPtr, objc, objv);
+    imPtr->infoPtr->directImPtr = NULL;
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_InvokeMethod()
+ *
+ *  Invokes a method from Itcl_GetMethod on an object with the
+ *  arguments (objc,objv), which do not include the method name.  The
+ *  call behaves like "$object Class::method ?arg ...?": the method of
+ *  the class the token was fetched from is called, not the most
+ *  specific one.  Unlike that command, it needs neither a lookup of
+ *  the object command nor a parse of the method name, and the TclOO
+ *  call chain for the method is kept cached in the token.
+ *
+ *  Returns TCL_OK/TCL_ERROR along with the result of the method, or
+ *  an error message in the interpreter.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_InvokeMethod(
+    Tcl_Interp *interp,       /* current interpreter */
+    Itcl_Method method,       /* token from Itcl_GetMethod */
+    Tcl_Object object,        /* object to invoke the method on */
+    int objc,                 /* number of arguments */
+    Tcl_Obj *const objv[])    /* argument objects */
+{
+    ItclMethodHandle *handlePtr = (ItclMethodHandle *)method;
+    ItclMemberFunc *imPtr = handlePtr->imPtr;
+    ItclObject *ioPtr;
+    Tcl_Obj **newObjv;
+    void *callbackPtr;
+    int result;
+
+    if (imPtr->iclsPtr->flags & ITCL_CLASS_IS_DELETED) {
+        Tcl_AppendResult(interp, "class \"",
+	        Tcl_GetString(imPtr->iclsPtr->fullNamePtr),
+		"\" has been deleted", NULL);
+        return TCL_ERROR;
+    }
+    ioPtr = NULL;
+    if (object != NULL) {
+        ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(object,
+	        imPtr->infoPtr->object_meta_type);
+    }
+    if ((ioPtr == NULL) || (ioPtr->oPtr == NULL)) {
+        Tcl_AppendResult(interp, "cannot invoke method \"",
+	        Tcl_GetString(imPtr->fullNamePtr),
+		"\" without an object context", NULL);
+        return TCL_ERROR;
+    }
+    if (!Itcl_ObjectIsa(ioPtr, imPtr->iclsPtr)) {
+        Tcl_AppendResult(interp, "object \"",
+	        Tcl_GetString(ioPtr->namePtr), "\" is not a \"",
+		Tcl_GetString(imPtr->iclsPtr->fullNamePtr), "\"", NULL);
+        return TCL_ERROR;
+    }
+    if ((imPtr->protection != ITCL_PUBLIC) &&
+            !Itcl_CanAccessFunc(imPtr, Tcl_GetCurrentNamespace(interp))) {
+        Tcl_AppendResult(interp, "can't access \"",
+	        Tcl_GetString(imPtr->fullNamePtr), "\": ",
+		Itcl_ProtectionStr(imPtr->protection), " function", NULL);
+        return TCL_ERROR;
+    }
+
+    newObjv = (Tcl_Obj **)ckalloc(sizeof(Tcl_Obj *)*(objc + 2));
+    newObjv[0] = ioPtr->namePtr;
+    newObjv[1] = handlePtr->namePtr;
+    memcpy(newObjv + 2, objv, (objc * sizeof(Tcl_Obj *)));
+    Tcl_IncrRefCount(newObjv[0]);
+    Tcl_IncrRefCount(newObjv[1]);
+
+    Itcl_PreserveData(ioPtr);
+    callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
+    Tcl_NRAddCallback(interp, CallInvokeMethod, imPtr, ioPtr,
+            INT2PTR(objc + 2), newObjv);
+    result = Itcl_NRRunCallbacks(interp, callbackPtr);
+    Itcl_ReleaseData(ioPtr);
+    Tcl_DecrRefCount(newObjv[1]);
+    Tcl_DecrRefCount(newObjv[0]);
+    ckfree((char *)newObjv);
+    return result;
+}
+
 
 /*
  * ------------------------------------------------------------------------
@@ -2137,7 +2803,8 @@ Itcl_CmdAliasProc(
 	    return Tcl_FindCommand(interp, "::itcl::builtin::setupcomponent", NULL, 0);
 	}
 	if (strcmp(cmdName, "@itcl-builtin-initoptions") == 0) {
-	    return Tcl_FindCommand(interp, "::itcl::builtin::initoptions", NULL, 0);
+	    return Tcl_FindCommand(interp, "::itcl::builtin::itcl_initoptions",
+	            NULL, 0);
 	}
 	if (strcmp(cmdName, "@itcl-builtin-mytypemethod") == 0) {
 	    return Tcl_FindCommand(interp, "::itcl::builtin::mytypemethod",
@@ -2234,24 +2901,21 @@ Itcl_VarAliasProc(
     }
 
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectVariables,
-	        (char *)ivlPtr->ivPtr);
+        varPtr = ItclGetObjectVar(ioPtr, ivlPtr->ivPtr);
     } else {
         hPtr = Tcl_FindHashEntry(&iclsPtr->classCommons,
 	        (char *)ivlPtr->ivPtr);
-        if (hPtr == NULL) {
+        if (hPtr != NULL) {
+            varPtr = (Tcl_Var)Tcl_GetHashValue(hPtr);
+        } else {
 	    if (callContextPtr != NULL) {
 	        ioPtr = callContextPtr->ioPtr;
 	    }
 	    if (ioPtr != NULL) {
-                hPtr = Tcl_FindHashEntry(&ioPtr->objectVariables,
-	                (char *)ivlPtr->ivPtr);
+                varPtr = ItclGetObjectVar(ioPtr, ivlPtr->ivPtr);
 	    }
 	}
     }
-    if (hPtr != NULL) {
-        varPtr = (Tcl_Var)Tcl_GetHashValue(hPtr);
-    }
     return varPtr;
 }
 
@@ -2285,6 +2949,96 @@ ItclCheckCallProc(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  CallContextIndex()
+ *
+ *  Returns the index into the callContexts of the object at which it
+ *  keeps the reusable call context for the member function, or -1 if
+ *  the function has no slot in objects of that class.
+ * ------------------------------------------------------------------------
+ */
+static int
+CallContextIndex(
+    ItclObject *ioPtr,
+    ItclMemberFunc *imPtr)
+{
+    Tcl_HashEntry *hPtr;
+
+    if (imPtr->slot < 0) {
+        return -1;
+    }
+    hPtr = Tcl_FindHashEntry(&ioPtr->iclsPtr->heritage,
+            (char *)imPtr->iclsPtr);
+    if (hPtr == NULL) {
+        return -1;
+    }
+    return PTR2INT(Tcl_GetHashValue(hPtr)) + imPtr->slot;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  CallContextSlot()
+ *
+ *  Returns where the object keeps the reusable call context for the
+ *  member function, or NULL if the function has no slot.
+ * ------------------------------------------------------------------------
+ */
+static ItclCallContext **
+CallContextSlot(
+    ItclObject *ioPtr,
+    ItclMemberFunc *imPtr)
+{
+    int idx;
+    int num;
+
+    idx = CallContextIndex(ioPtr, imPtr);
+    if (idx < 0) {
+        return NULL;
+    }
+    if (idx >= ioPtr->numCallContexts) {
+        num = ioPtr->iclsPtr->numMethodSlots;
+	if (num <= idx) {
+	    num = idx + 1;
+	}
+	if (ioPtr->callContexts == NULL) {
+	    ioPtr->callContexts = (ItclCallContext **)ckalloc(
+	            num * sizeof(ItclCallContext *));
+	} else {
+	    ioPtr->callContexts = (ItclCallContext **)ckrealloc(
+	            (char *)ioPtr->callContexts,
+	            num * sizeof(ItclCallContext *));
+	}
+	memset(ioPtr->callContexts + ioPtr->numCallContexts, 0,
+	        (num - ioPtr->numCallContexts) * sizeof(ItclCallContext *));
+	ioPtr->numCallContexts = num;
+    }
+    return ioPtr->callContexts + idx;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  IsSlotCallContext()
+ *
+ *  Returns 1 if the call context is the one kept by its object, which
+ *  is then freed with the object only.
+ * ------------------------------------------------------------------------
+ */
+static int
+IsSlotCallContext(
+    ItclCallContext *callContextPtr)
+{
+    ItclObject *ioPtr = callContextPtr->ioPtr;
+    int idx;
+
+    if (ioPtr == NULL) {
+        return 0;
+    }
+    idx = CallContextIndex(ioPtr, callContextPtr->imPtr);
+    return (idx >= 0) && (idx < ioPtr->numCallContexts)
+            && (ioPtr->callContexts[idx] == callContextPtr);
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclCheckCallMethod()
@@ -2300,25 +3054,19 @@ ItclCheckCallMethod(
     Tcl_CallFrame *framePtr,
     int *isFinished)
 {
-    Itcl_Stack *stackPtr;
-
     Tcl_Object oPtr;
     ItclObject *ioPtr;
-    Tcl_HashEntry *hPtr;
     Tcl_Obj *const * cObjv;
     Tcl_Namespace *currNsPtr;
     ItclCallContext *callContextPtr;
     ItclCallContext *callContextPtr2;
+    ItclCallContext **slotPtr;
     ItclMemberFunc *imPtr;
     int result;
-    int isNew;
     int cObjc;
     int min_allowed_args;
 
-    ItclObjectInfo *infoPtr;
-
     oPtr = NULL;
-    hPtr = NULL;
     imPtr = (ItclMemberFunc *)clientData;
     Itcl_PreserveData(imPtr);
     if (imPtr->flags & ITCL_CONSTRUCTOR) {
@@ -2334,6 +3082,10 @@ ItclCheckCallMethod(
                 if (isFinished != NULL) {
                     *isFinished = 0;
                 }
+		if (imPtr->infoPtr->profiling) {
+		    ItclProfileEnter(imPtr->infoPtr,
+		            ItclProfileFunctionRecord(imPtr));
+		}
 		return TCL_OK;
             }
 	    Tcl_AppendResult(interp,
@@ -2382,13 +3134,21 @@ ItclCheckCallMethod(
 	goto finishReturn;
     }
   }
-    isNew = 0;
     callContextPtr = NULL;
+    slotPtr = NULL;
     currNsPtr = Tcl_GetCurrentNamespace(interp);
     if (ioPtr != NULL) {
-        hPtr = Tcl_CreateHashEntry(&ioPtr->contextCache, (char *)imPtr, &isNew);
-        if (!isNew) {
-	    callContextPtr2 = (ItclCallContext *)Tcl_GetHashValue(hPtr);
+        slotPtr = CallContextSlot(ioPtr, imPtr);
+        if ((slotPtr != NULL) && (*slotPtr != NULL)
+                && ((*slotPtr)->imPtr != imPtr)) {
+	    /*
+	     *  Only if a base class got new member functions after this
+	     *  class was built.  Leave the slot to the function that has it.
+	     */
+	    slotPtr = NULL;
+	}
+        if ((slotPtr != NULL) && (*slotPtr != NULL)) {
+	    callContextPtr2 = *slotPtr;
 	    if (callContextPtr2->refCount == 0) {
 	        callContextPtr = callContextPtr2;
                 callContextPtr->objectFlags = ioPtr->flags;
@@ -2406,7 +3166,7 @@ ItclCheckCallMethod(
         }
     }
     if (callContextPtr == NULL) {
-        callContextPtr = (ItclCallContext *)ckalloc(
+        callContextPtr = (ItclCallContext *)Itcl_Alloc(
                 sizeof(ItclCallContext));
 	if (ioPtr == NULL) {
             callContextPtr->objectFlags = 0;
@@ -2419,41 +3179,17 @@ ItclCheckCallMethod(
         callContextPtr->imPtr = imPtr;
         callContextPtr->refCount = 1;
     }
-    if (isNew) {
-        Tcl_SetHashValue(hPtr, callContextPtr);
+    if ((slotPtr != NULL) && (*slotPtr == NULL)) {
+        *slotPtr = callContextPtr;
     }
 
     if (framePtr == NULL) {
 	framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     }
 
-    isNew = 0;
-    infoPtr = imPtr->iclsPtr->infoPtr;
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *)ckalloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-        Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    }
-
     assert (callContextPtr) ;
-    Itcl_PushStack(callContextPtr, stackPtr);
-
-    /* Ugly abuse alert.  Two maps in one table */
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)contextPtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *)ckalloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-        Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    }
-
-    Itcl_PushStack(framePtr, stackPtr);
+    ItclPushCallContext(imPtr->iclsPtr->infoPtr, framePtr, callContextPtr,
+	    contextPtr);
 
     if (ioPtr != NULL) {
 	ioPtr->callRefCount++;
@@ -2463,6 +3199,9 @@ ItclCheckCallMethod(
     if (!imPtr->iclsPtr->infoPtr->useOldResolvers) {
         Itcl_SetCallFrameResolver(interp, ioPtr->resolvePtr);
     }
+    if (imPtr->infoPtr->profiling) {
+        ItclProfileEnter(imPtr->infoPtr, ItclProfileFunctionRecord(imPtr));
+    }
     result = TCL_OK;
 
     if (isFinished != NULL) {
@@ -2489,39 +3228,20 @@ ItclAfterCallMethod(
     TCL_UNUSED(Tcl_Namespace*),
     int call_result)
 {
-    Tcl_HashEntry *hPtr;
     ItclObject *ioPtr;
     ItclMemberFunc *imPtr;
     ItclCallContext *callContextPtr;
-    int newEntry;
     int result;
 
     imPtr = (ItclMemberFunc *)clientData;
+    if (imPtr->infoPtr->profiling) {
+        ItclProfileLeave(imPtr->infoPtr, ItclProfileFunctionRecord(imPtr),
+	        call_result);
+    }
     callContextPtr = NULL;
     if (contextPtr != NULL) {
-    ItclObjectInfo *infoPtr = imPtr->infoPtr;
-    Tcl_CallFrame *framePtr;
-    Itcl_Stack *stackPtr;
-
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)contextPtr);
-    assert(hPtr);
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    framePtr = (Tcl_CallFrame *)Itcl_PopStack(stackPtr);
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	ckfree((char *) stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
-
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
-    assert(hPtr);
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    callContextPtr = (ItclCallContext *)Itcl_PopStack(stackPtr);
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	ckfree((char *) stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
+	callContextPtr = ItclPopCallContext(imPtr->infoPtr, interp, contextPtr);
+	assert(callContextPtr);
     }
     if (callContextPtr == NULL) {
         if ((imPtr->flags & ITCL_COMMON) ||
@@ -2548,13 +3268,11 @@ ItclAfterCallMethod(
         if (imPtr->flags & (ITCL_CONSTRUCTOR | ITCL_DESTRUCTOR)) {
             if ((imPtr->flags & ITCL_DESTRUCTOR) && ioPtr &&
                  ioPtr->destructed) {
-                Tcl_CreateHashEntry(ioPtr->destructed,
-                    (char *)imPtr->iclsPtr->namePtr, &newEntry);
+                ItclClassSetAdd(ioPtr->destructed, imPtr->iclsPtr);
             }
             if ((imPtr->flags & ITCL_CONSTRUCTOR) && ioPtr &&
                  ioPtr->constructed) {
-                Tcl_CreateHashEntry(ioPtr->constructed,
-                    (char *)imPtr->iclsPtr->namePtr, &newEntry);
+                ItclClassSetAdd(ioPtr->constructed, imPtr->iclsPtr);
             }
         }
       }
@@ -2565,14 +3283,8 @@ ItclAfterCallMethod(
     }
 
     if (callContextPtr->refCount-- <= 1) {
-        if (callContextPtr->ioPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&callContextPtr->ioPtr->contextCache,
-	            (char *)callContextPtr->imPtr);
-            if (hPtr == NULL) {
-                ckfree((char *)callContextPtr);
-	    }
-        } else {
-            ckfree((char *)callContextPtr);
+        if (!IsSlotCallContext(callContextPtr)) {
+            Itcl_Free(callContextPtr);
         }
     }
 
@@ -2598,7 +3310,6 @@ ItclProcErrorProc(
     ItclObject *contextIoPtr;
     ItclClass *currIclsPtr;
     char num[20];
-    Itcl_Stack *stackPtr;
 
     /* Fetch the current call frame.  That determines context. */
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
@@ -2606,15 +3317,7 @@ ItclProcErrorProc(
     /* Try to map it to a context stack. */
     infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
-    if (hPtr == NULL) {
-	/* Can this happen? */
-	return;
-    }
-
-    /* Frame maps to a context stack. */
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    callContextPtr = (ItclCallContext *)Itcl_PeekStack(stackPtr);
+    callContextPtr = ItclPeekFrameContext(infoPtr, framePtr);
 
     if (callContextPtr == NULL) {
 	return;
@@ -109,6 +109,37 @@ Itcl_GetUplevelCallFrame(
     return (Tcl_CallFrame *)framePtr;
 }
 
+int
+Itcl_GetCallFrameLevel(
+    Tcl_CallFrame *framePtr)
+{
+    if (framePtr == NULL) {
+        return 0;
+    }
+    return ((CallFrame *)framePtr)->level;
+}
+
+Tcl_Obj *
+Itcl_GetVarValue(
+    Tcl_Interp *interp,
+    Tcl_Var varPtr,
+    Tcl_Obj *namePtr,
+    int flags)
+{
+    return TclPtrGetVar(interp, varPtr, NULL, namePtr, NULL, flags);
+}
+
+Tcl_Obj *
+Itcl_SetVarValue(
+    Tcl_Interp *interp,
+    Tcl_Var varPtr,
+    Tcl_Obj *namePtr,
+    Tcl_Obj *valuePtr,
+    int flags)
+{
+    return TclPtrSetVar(interp, varPtr, NULL, namePtr, NULL, valuePtr, flags);
+}
+
 Tcl_CallFrame *
 Itcl_ActivateCallFrame(
     Tcl_Interp *interp,
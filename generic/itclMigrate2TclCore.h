@@ -78,6 +78,11 @@ MODULE_SCOPE void Itcl_ReleaseVar(Tcl_Var var);
 MODULE_SCOPE int Itcl_IsCallFrameArgument(Tcl_Interp *interp, const char *name);
 MODULE_SCOPE int Itcl_GetCallVarFrameObjc(Tcl_Interp *interp);
 MODULE_SCOPE Tcl_Obj * const * Itcl_GetCallVarFrameObjv(Tcl_Interp *interp);
+MODULE_SCOPE int Itcl_GetCallFrameLevel(Tcl_CallFrame *framePtr);
+MODULE_SCOPE Tcl_Obj *Itcl_GetVarValue(Tcl_Interp *interp, Tcl_Var varPtr,
+        Tcl_Obj *namePtr, int flags);
+MODULE_SCOPE Tcl_Obj *Itcl_SetVarValue(Tcl_Interp *interp, Tcl_Var varPtr,
+        Tcl_Obj *namePtr, Tcl_Obj *valuePtr, int flags);
 #define Tcl_SetNamespaceResolver _Tcl_SetNamespaceResolver
 MODULE_SCOPE int _Tcl_SetNamespaceResolver(Tcl_Namespace *nsPtr,
         struct Tcl_Resolve *resolvePtr);
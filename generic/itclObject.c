@@ -45,8 +45,6 @@ static char* ItclTraceSelfnsVar(ClientData cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
 static char* ItclTraceWinVar(ClientData cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
-static char* ItclTraceOptionVar(ClientData cdata, Tcl_Interp *interp,
-	const char *name1, const char *name2, int flags);
 static char* ItclTraceComponentVar(ClientData cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
 static char* ItclTraceItclHullVar(ClientData cdata, Tcl_Interp *interp,
@@ -69,6 +67,12 @@ static const char * GetConstructorVar(Tcl_Interp *interp, ItclClass *iclsPtr,
         const char *varName);
 static ItclClass * GetClassFromClassName(Tcl_Interp *interp,
 	const char *className, ItclClass *iclsPtr);
+static ItclClass * GetQualifierClass(Tcl_Interp *interp,
+	const char *className, ItclClass *iclsPtr);
+static int CreateObject(Tcl_Interp *interp, const char *name,
+        ItclClass *iclsPtr, int objc, Tcl_Obj *const objv[]);
+static void LinkInstance(ItclObject *ioPtr);
+static void UnlinkInstance(ItclObject *ioPtr);
 
 
 /*
@@ -178,6 +182,102 @@ Itcl_CreateObject(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_CreateObjects()
+ *
+ *  Creates "count" objects of the given class in the current namespace,
+ *  passing the same constructor arguments to each of them.  The objects
+ *  get unique names built from the class name, as with "#auto".  The
+ *  name prefix and the class lookup are done once for the whole batch.
+ *
+ *  If namesPtr is not NULL, the names of the new objects are appended
+ *  to this list object.  If any constructor fails, the objects created
+ *  so far are deleted again and TCL_ERROR is returned along with the
+ *  error of the failing constructor.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_CreateObjects(
+    Tcl_Interp *interp,      /* interpreter mananging new objects */
+    ItclClass *iclsPtr,      /* class for new objects */
+    int count,               /* number of objects to create */
+    int objc,                /* number of constructor arguments */
+    Tcl_Obj *const objv[],   /* constructor argument objects */
+    Tcl_Obj *namesPtr)       /* returns: list of object names or NULL */
+{
+    Tcl_DString buffer;
+    Tcl_CmdInfo dummy;
+    Tcl_Obj *createdPtr;
+    Tcl_Obj **namev;
+    Itcl_InterpState istate;
+    Tcl_Command cmd;
+    char unique[TCL_INTEGER_SPACE];
+    int prefixLen;
+    int result;
+    int namec;
+    int i;
+
+    if (iclsPtr->flags & (ITCL_WIDGET|ITCL_WIDGETADAPTOR)) {
+        Tcl_AppendResult(interp, "cannot create several objects of widget",
+                " class \"", Tcl_GetString(iclsPtr->fullNamePtr), "\" at once",
+                NULL);
+        return TCL_ERROR;
+    }
+    result = TCL_OK;
+    createdPtr = Tcl_NewListObj(0, NULL);
+    Tcl_IncrRefCount(createdPtr);
+    ItclPreserveClass(iclsPtr);
+
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, Tcl_GetString(iclsPtr->namePtr), -1);
+    Tcl_DStringValue(&buffer)[0] = tolower(UCHAR(Tcl_DStringValue(&buffer)[0]));
+    prefixLen = Tcl_DStringLength(&buffer);
+
+    for (i = 0; i < count; i++) {
+        /*
+         *  Same naming scheme as "#auto": keep incrementing the unique
+         *  counter of the class until no command has that name.
+         */
+        do {
+            sprintf(unique, "%d", iclsPtr->unique++);
+            Tcl_DStringSetLength(&buffer, prefixLen);
+            Tcl_DStringAppend(&buffer, unique, -1);
+        } while (Tcl_GetCommandInfo(interp, Tcl_DStringValue(&buffer),
+                &dummy) != 0);
+
+        result = ItclCreateObject(interp, Tcl_DStringValue(&buffer), iclsPtr,
+                objc, objv);
+        if (result != TCL_OK) {
+            break;
+        }
+        Tcl_ListObjAppendElement(NULL, createdPtr,
+                Tcl_NewStringObj(Tcl_DStringValue(&buffer),
+                Tcl_DStringLength(&buffer)));
+    }
+    Tcl_DStringFree(&buffer);
+
+    if (result != TCL_OK) {
+        istate = Itcl_SaveInterpState(interp, result);
+        Tcl_ListObjGetElements(NULL, createdPtr, &namec, &namev);
+        for (i = 0; i < namec; i++) {
+            cmd = Tcl_FindCommand(interp, Tcl_GetString(namev[i]), NULL, 0);
+            if ((cmd != NULL) && Itcl_IsObject(cmd)) {
+                Tcl_DeleteCommandFromToken(interp, cmd);
+            }
+        }
+        result = Itcl_RestoreInterpState(interp, istate);
+    } else {
+        Tcl_ResetResult(interp);
+        if (namesPtr != NULL) {
+            Tcl_ListObjAppendList(NULL, namesPtr, createdPtr);
+        }
+    }
+    Tcl_DecrRefCount(createdPtr);
+    ItclReleaseClass(iclsPtr);
+    return result;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclCreateObject()
@@ -204,6 +304,33 @@ ItclCreateObject(
     ItclClass *iclsPtr,        /* class for new object */
     int objc,                /* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
+{
+    ItclObjectInfo *infoPtr = iclsPtr->infoPtr;
+    int result;
+
+    if (!infoPtr->profiling) {
+        return CreateObject(interp, name, iclsPtr, objc, objv);
+    }
+    ItclProfileEnter(infoPtr, &infoPtr->profileCreate);
+    result = CreateObject(interp, name, iclsPtr, objc, objv);
+    ItclProfileLeave(infoPtr, &infoPtr->profileCreate, result);
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  CreateObject()
+ *
+ *  The work of ItclCreateObject(), which adds the profiling.
+ * ------------------------------------------------------------------------
+ */
+static int
+CreateObject(
+    Tcl_Interp *interp,      /* interpreter mananging new object */
+    const char* name,        /* name of new object */
+    ItclClass *iclsPtr,        /* class for new object */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
 {
     int result = TCL_OK;
 
@@ -257,8 +384,7 @@ ItclCreateObject(
     ioPtr->infoPtr = infoPtr;
     ItclPreserveClass(iclsPtr);
 
-    ioPtr->constructed = (Tcl_HashTable*)ckalloc(sizeof(Tcl_HashTable));
-    Tcl_InitObjHashTable(ioPtr->constructed);
+    ioPtr->constructed = ItclNewClassSet();
 
     ioPtr->oPtr = Tcl_NewObjectInstance(interp, iclsPtr->clsPtr, NULL,
             /* nsName */ NULL, /* objc */ -1, /* objv */ NULL, /* skip */ 0);
@@ -295,12 +421,6 @@ ItclCreateObject(
     Tcl_DStringFree(&buffer);
 
     Tcl_InitHashTable(&ioPtr->objectVariables, TCL_ONE_WORD_KEYS);
-    Tcl_InitObjHashTable(&ioPtr->objectOptions);
-    Tcl_InitObjHashTable(&ioPtr->objectComponents);
-    Tcl_InitObjHashTable(&ioPtr->objectDelegatedOptions);
-    Tcl_InitObjHashTable(&ioPtr->objectDelegatedFunctions);
-    Tcl_InitObjHashTable(&ioPtr->objectMethodVariables);
-    Tcl_InitHashTable(&ioPtr->contextCache, TCL_ONE_WORD_KEYS);
 
     Itcl_PreserveData(ioPtr);
 
@@ -462,6 +582,7 @@ ItclCreateObject(
     hPtr = Tcl_CreateHashEntry(&iclsPtr->infoPtr->objects,
         (char*)ioPtr, &newEntry);
     Tcl_SetHashValue(hPtr, ioPtr);
+    LinkInstance(ioPtr);
 
     /* Use the TclOO object namespaces as a unique key in case the
      * object is renamed. Used by mytypemethod, etc. */
@@ -626,6 +747,7 @@ ItclCreateObject(
         hPtr = Tcl_CreateHashEntry(&iclsPtr->infoPtr->objects,
                 (char*)ioPtr, &newEntry);
         Tcl_SetHashValue(hPtr, ioPtr);
+	LinkInstance(ioPtr);
 
 	/*
 	 * This is an inelegant hack, left behind until the need for it
@@ -686,8 +808,7 @@ ItclCreateObject(
         infoPtr->currIoPtr = saveCurrIoPtr;
     }
     infoPtr->lastIoPtr = ioPtr;
-    Tcl_DeleteHashTable(ioPtr->constructed);
-    ckfree((char*)ioPtr->constructed);
+    ItclFreeClassSet(ioPtr->constructed);
     ioPtr->constructed = NULL;
     ItclAddObjectsDictInfo(interp, ioPtr);
     Itcl_ReleaseData(ioPtr);
@@ -710,8 +831,7 @@ errorReturn:
         infoPtr->currIoPtr = saveCurrIoPtr;
     }
     if (ioPtr->constructed != NULL) {
-        Tcl_DeleteHashTable(ioPtr->constructed);
-        ckfree((char*)ioPtr->constructed);
+        ItclFreeClassSet(ioPtr->constructed);
         ioPtr->constructed = NULL;
     }
     ItclDeleteObjectVariablesNamespace(interp, ioPtr);
@@ -744,6 +864,81 @@ ItclInitObjectCommands(
     return TCL_OK;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetObjectVar()
+ *
+ *  Returns the object's instance of the given data member, or NULL if
+ *  the object has none.  Variables with a slot on the object's
+ *  inheritance chain are found by index; all others fall back to the
+ *  objectVariables table.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Var
+ItclGetObjectVar(
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr)
+{
+    Tcl_HashEntry *hPtr;
+
+    if ((ivPtr->slot >= 0) && (ivPtr->slot < ioPtr->numVarSlots)
+            && (ioPtr->varSlots[ivPtr->slot].ivPtr == ivPtr)) {
+        return ioPtr->varSlots[ivPtr->slot].varPtr;
+    }
+    hPtr = Tcl_FindHashEntry(&ioPtr->objectVariables, (char *)ivPtr);
+    if (hPtr == NULL) {
+        return NULL;
+    }
+    return (Tcl_Var)Tcl_GetHashValue(hPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclObjectOptionsVar()
+ *
+ *  Returns the "itcl_options" array of an ::itcl::type, widget or
+ *  extendedclass object, or NULL if it does not exist yet.  The array
+ *  lives in the object's variable namespace; once found
+ *  it is kept on the object, so the resolvers hand it out without any
+ *  name lookup.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Var
+ItclObjectOptionsVar(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr)
+{
+    Tcl_DString buffer;
+    Tcl_Var varPtr;
+
+    if (ioPtr->optionsVarPtr != NULL) {
+        return ioPtr->optionsVarPtr;
+    }
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, Tcl_GetString(ioPtr->varNsNamePtr), -1);
+    Tcl_DStringAppend(&buffer, "::itcl_options", -1);
+    varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer), NULL, 0);
+    Tcl_DStringFree(&buffer);
+    if (varPtr != NULL) {
+        Itcl_PreserveVar(varPtr);
+        ioPtr->optionsVarPtr = varPtr;
+    }
+    return varPtr;
+}
+
+static void
+SetObjectVarSlot(
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr,
+    Tcl_Var varPtr)
+{
+    if ((ivPtr->slot >= 0) && (ivPtr->slot < ioPtr->numVarSlots)
+            && (ioPtr->varSlots[ivPtr->slot].ivPtr == NULL)) {
+        ioPtr->varSlots[ivPtr->slot].ivPtr = ivPtr;
+        ioPtr->varSlots[ivPtr->slot].varPtr = varPtr;
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclInitObjectVariables()
@@ -760,44 +955,75 @@ ItclInitObjectVariables(
    ItclClass *iclsPtr)
 {
     Tcl_DString buffer;
-    Tcl_DString buffer2;
     Tcl_HashEntry *hPtr;
     Tcl_HashEntry *hPtr2;
     Tcl_HashSearch place;
     Tcl_Namespace *varNsPtr;
-    Tcl_Namespace *varNsPtr2;
     Tcl_CallFrame frame;
     Tcl_Var varPtr;
     ItclClass *iclsPtr2;
-    ItclHierIter hier;
+    ItclObjectProto *protoPtr;
     ItclVariable *ivPtr;
     ItclComponent *icPtr;
     const char *varName;
     const char *inheritComponentName;
-    int itclOptionsIsSet;
     int isNew;
+    int prefixLen;
+    int i;
 
     ivPtr = NULL;
+    if ((ioPtr->varSlots == NULL) && (iclsPtr->numVarSlots > 0)) {
+        ioPtr->numVarSlots = iclsPtr->numVarSlots;
+        ioPtr->varSlots = (ItclVarSlot *)ckalloc(
+                ioPtr->numVarSlots * sizeof(ItclVarSlot));
+        memset(ioPtr->varSlots, 0, ioPtr->numVarSlots * sizeof(ItclVarSlot));
+    }
     /*
      * create all the variables for each class in the
      * ::itcl::variables::<object namespace>::<class> namespace as an
      * undefined variable using the Tcl "variable xx" command
      */
-    itclOptionsIsSet = 0;
     inheritComponentName = NULL;
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
+    protoPtr = ItclGetObjectProto(iclsPtr);
     Tcl_ResetResult(interp);
-    while (iclsPtr2 != NULL) {
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, -1);
-	Tcl_DStringAppend(&buffer,
-		(Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, -1);
+    /*
+     * The object's part of the namespace names is the same for all
+     * classes.  The namespaces of a new object hardly ever exist, so
+     * try to create them first and only look for them on failure.
+     */
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, Tcl_GetString(ioPtr->varNsNamePtr), -1);
+    prefixLen = Tcl_DStringLength(&buffer);
+    for (i = 0; i < protoPtr->numClasses; i++) {
+	iclsPtr2 = protoPtr->classes[i];
+	/*
+	 * A base class whose only data member is "this" needs no
+	 * namespace of its own: "this" resolves to the variable of the
+	 * most specific class in every class scope anyway.
+	 */
+	if ((iclsPtr2 != iclsPtr) && (ioPtr->thisVarPtr != NULL)
+	        && (iclsPtr2->variables.numEntries == 1)) {
+	    hPtr = Tcl_FirstHashEntry(&iclsPtr2->variables, &place);
+	    ivPtr = (ItclVariable *)Tcl_GetHashValue(hPtr);
+	    if ((ivPtr->flags & ITCL_THIS_VAR)
+	            && (strcmp(Tcl_GetString(ivPtr->namePtr), "this") == 0)) {
+	        hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectVariables,
+		        (char *)ivPtr, &isNew);
+	        if (isNew) {
+		    Itcl_PreserveVar(ioPtr->thisVarPtr);
+		    Tcl_SetHashValue(hPtr2, ioPtr->thisVarPtr);
+		    SetObjectVarSlot(ioPtr, ivPtr, ioPtr->thisVarPtr);
+	        }
+	        continue;
+	    }
+	}
+	Tcl_DStringSetLength(&buffer, prefixLen);
 	Tcl_DStringAppend(&buffer, iclsPtr2->nsPtr->fullName, -1);
-	varNsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer),
+	varNsPtr = Tcl_CreateNamespace(interp, Tcl_DStringValue(&buffer),
 	        NULL, 0);
 	if (varNsPtr == NULL) {
-	    varNsPtr = Tcl_CreateNamespace(interp, Tcl_DStringValue(&buffer),
+	    Tcl_ResetResult(interp);
+	    varNsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer),
 	            NULL, 0);
 	}
 	/* now initialize the variables which have an init value */
@@ -809,35 +1035,11 @@ ItclInitObjectVariables(
         while (hPtr) {
             ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
 	    varName = Tcl_GetString(ivPtr->namePtr);
-            if ((ivPtr->flags & ITCL_OPTIONS_VAR) && !itclOptionsIsSet) {
-                /* this is the special code for the "itcl_options" variable */
-		itclOptionsIsSet = 1;
-                Tcl_DStringInit(&buffer2);
-	        Tcl_DStringAppend(&buffer2, ITCL_VARIABLES_NAMESPACE, -1);
-		Tcl_DStringAppend(&buffer,
-			(Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, -1);
-	        varNsPtr2 = Tcl_FindNamespace(interp,
-		        Tcl_DStringValue(&buffer2), NULL, 0);
-	        if (varNsPtr2 == NULL) {
-	            varNsPtr2 = Tcl_CreateNamespace(interp,
-		            Tcl_DStringValue(&buffer2), NULL, 0);
-	        }
-                Tcl_DStringFree(&buffer2);
-	        Itcl_PopCallFrame(interp);
-	        /* now initialize the variables which have an init value */
-                if (Itcl_PushCallFrame(interp, &frame, varNsPtr2,
-                        /*isProcCallFrame*/0) != TCL_OK) {
-		    goto errorCleanup2;
-                }
-                Tcl_TraceVar2(interp, "itcl_options",
-                        NULL,
-                        TCL_TRACE_READS|TCL_TRACE_WRITES,
-                        ItclTraceOptionVar, ioPtr);
-	        Itcl_PopCallFrame(interp);
-                if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
-                        /*isProcCallFrame*/0) != TCL_OK) {
-		    goto errorCleanup2;
-                }
+            if (ivPtr->flags & ITCL_OPTIONS_VAR) {
+                /*
+                 * "itcl_options" is not a variable of the class scope,
+                 * see ItclObjectOptionsVar().
+                 */
                 hPtr = Tcl_NextHashEntry(&place);
 	        continue;
             }
@@ -866,7 +1068,8 @@ ItclInitObjectVariables(
 		        inheritComponentName = Tcl_GetString(icPtr->namePtr);
 		    }
 		}
-                hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectComponents,
+                hPtr2 = Tcl_CreateHashEntry(
+                        &ItclCreateObjectTables(ioPtr)->objectComponents,
                         (char *)ivPtr->namePtr, &isNew);
 		if (isNew) {
 		    Tcl_SetHashValue(hPtr2, icPtr);
@@ -894,6 +1097,12 @@ ItclInitObjectVariables(
 	        if (isNew) {
 		    Itcl_PreserveVar(varPtr);
 		    Tcl_SetHashValue(hPtr2, varPtr);
+		    SetObjectVarSlot(ioPtr, ivPtr, varPtr);
+		    if ((iclsPtr2 == iclsPtr) && (ivPtr->flags & ITCL_THIS_VAR)
+		            && (strcmp(varName, "this") == 0)) {
+		        /* the one "this" all class scopes resolve to */
+		        ioPtr->thisVarPtr = varPtr;
+		    }
 		}
 	        if (ivPtr->flags & (ITCL_THIS_VAR|ITCL_TYPE_VAR|
 		        ITCL_SELF_VAR|ITCL_SELFNS_VAR|ITCL_WIN_VAR)) {
@@ -938,8 +1147,7 @@ ItclInitObjectVariables(
 		} else {
 	            if (ivPtr->flags & ITCL_HULL_VAR) {
 	                Tcl_TraceVar2(interp, varName, NULL,
-		            TCL_TRACE_READS|TCL_TRACE_WRITES,
-			    ItclTraceItclHullVar,
+		            TCL_TRACE_WRITES, ItclTraceItclHullVar,
 		            ioPtr);
 		    } else {
 	              if (ivPtr->init != NULL) {
@@ -986,8 +1194,7 @@ ItclInitObjectVariables(
 	        } else {
 	            if (ivPtr->flags & ITCL_HULL_VAR) {
 	                Tcl_TraceVar2(interp, varName, NULL,
-		            TCL_TRACE_READS|TCL_TRACE_WRITES,
-			    ItclTraceItclHullVar,
+		            TCL_TRACE_WRITES, ItclTraceItclHullVar,
 		            ioPtr);
 		    }
 	            hPtr2 = Tcl_FindHashEntry(&iclsPtr2->classCommons,
@@ -1001,6 +1208,7 @@ ItclInitObjectVariables(
 	            if (isNew) {
 			Itcl_PreserveVar(varPtr);
 		        Tcl_SetHashValue(hPtr2, varPtr);
+		        SetObjectVarSlot(ioPtr, ivPtr, varPtr);
 	        }
 	        if (ivPtr->flags & ITCL_COMPONENT_VAR) {
 	            if (ivPtr->flags & ITCL_COMMON) {
@@ -1035,14 +1243,13 @@ ItclInitObjectVariables(
             hPtr = Tcl_NextHashEntry(&place);
         }
 	Itcl_PopCallFrame(interp);
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
     Tcl_DStringFree(&buffer);
-    Itcl_DeleteHierIter(&hier);
     return TCL_OK;
 errorCleanup:
     Itcl_PopCallFrame(interp);
 errorCleanup2:
+    Tcl_DStringFree(&buffer);
     varNsPtr = Tcl_FindNamespace(interp, Tcl_GetString(ioPtr->varNsNamePtr),
             NULL, 0);
     if (varNsPtr != NULL) {
@@ -1073,76 +1280,64 @@ ItclInitObjectOptions(
 {
     Tcl_DString buffer;
     Tcl_HashEntry *hPtr;
-    Tcl_HashEntry *hPtr2;
-    Tcl_HashSearch place;
     Tcl_CallFrame frame;
     Tcl_Namespace *varNsPtr;
-    ItclClass *iclsPtr2;
-    ItclHierIter hier;
+    ItclObjectProto *protoPtr;
     ItclOption *ioptPtr;
     ItclDelegatedOption *idoPtr;
     int isNew;
+    int i;
 
-    ioptPtr = NULL;
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
+    protoPtr = ItclGetObjectProto(iclsPtr);
+    if (protoPtr->numOptions > 0) {
+        Tcl_DStringInit(&buffer);
+	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, -1);
+	Tcl_DStringAppend(&buffer,
+		(Tcl_GetObjectNamespace(ioPtr->oPtr)->fullName), -1);
+	varNsPtr = Tcl_FindNamespace(interp,
+		Tcl_DStringValue(&buffer), NULL, 0);
+	if (varNsPtr == NULL) {
+	    varNsPtr = Tcl_CreateNamespace(interp,
+		    Tcl_DStringValue(&buffer), NULL, 0);
+	}
+        Tcl_DStringFree(&buffer);
 	/* now initialize the options which have an init value */
-        hPtr = Tcl_FirstHashEntry(&iclsPtr2->options, &place);
-        while (hPtr) {
-            ioptPtr = (ItclOption*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectOptions,
+        if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
+                /*isProcCallFrame*/0) != TCL_OK) {
+            return TCL_ERROR;
+        }
+        for (i = 0; i < protoPtr->numOptions; i++) {
+            ioptPtr = protoPtr->options[i];
+	    hPtr = Tcl_CreateHashEntry(
+	            &ItclCreateObjectTables(ioPtr)->objectOptions,
 	            (char *)ioptPtr->namePtr, &isNew);
-	    if (isNew) {
-		Tcl_SetHashValue(hPtr2, ioptPtr);
-                Tcl_DStringInit(&buffer);
-	        Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, -1);
-		Tcl_DStringAppend(&buffer,
-			(Tcl_GetObjectNamespace(ioPtr->oPtr)->fullName), -1);
-	        varNsPtr = Tcl_FindNamespace(interp,
-		        Tcl_DStringValue(&buffer), NULL, 0);
-	        if (varNsPtr == NULL) {
-	            varNsPtr = Tcl_CreateNamespace(interp,
-		            Tcl_DStringValue(&buffer), NULL, 0);
-		}
-                Tcl_DStringFree(&buffer);
-	        /* now initialize the options which have an init value */
-                if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
-                        /*isProcCallFrame*/0) != TCL_OK) {
-                    return TCL_ERROR;
+	    if (!isNew) {
+	        continue;
+	    }
+	    Tcl_SetHashValue(hPtr, ioptPtr);
+	    if ((ioptPtr->namePtr != NULL) &&
+		    (ioptPtr->defaultValuePtr != NULL)) {
+                if (Tcl_SetVar2(interp, "itcl_options",
+		        Tcl_GetString(ioptPtr->namePtr),
+	                Tcl_GetString(ioptPtr->defaultValuePtr),
+			TCL_NAMESPACE_ONLY) == NULL) {
+	            Itcl_PopCallFrame(interp);
+		    return TCL_ERROR;
                 }
-		if ((ioptPtr != NULL) && (ioptPtr->namePtr != NULL) &&
-		        (ioptPtr->defaultValuePtr != NULL)) {
-                    if (Tcl_SetVar2(interp, "itcl_options",
-		            Tcl_GetString(ioptPtr->namePtr),
-	                    Tcl_GetString(ioptPtr->defaultValuePtr),
-			    TCL_NAMESPACE_ONLY) == NULL) {
-	                Itcl_PopCallFrame(interp);
-		        return TCL_ERROR;
-                    }
-                    Tcl_TraceVar2(interp, "itcl_options",
-                            NULL,
-                            TCL_TRACE_READS|TCL_TRACE_WRITES,
-                            ItclTraceOptionVar, ioPtr);
-		}
-	        Itcl_PopCallFrame(interp);
-            }
-            hPtr = Tcl_NextHashEntry(&place);
-        }
-	/* now check for options which are delegated */
-        hPtr = Tcl_FirstHashEntry(&iclsPtr2->delegatedOptions, &place);
-        while (hPtr) {
-            idoPtr = (ItclDelegatedOption*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
-	            (char *)idoPtr->namePtr, &isNew);
-	    if (isNew) {
-		Tcl_SetHashValue(hPtr2, idoPtr);
 	    }
-            hPtr = Tcl_NextHashEntry(&place);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
+	Itcl_PopCallFrame(interp);
+    }
+    /* now check for options which are delegated */
+    for (i = 0; i < protoPtr->numDelegatedOptions; i++) {
+        idoPtr = protoPtr->delegatedOptions[i];
+	hPtr = Tcl_CreateHashEntry(
+	        &ItclCreateObjectTables(ioPtr)->objectDelegatedOptions,
+	        (char *)idoPtr->namePtr, &isNew);
+	if (isNew) {
+	    Tcl_SetHashValue(hPtr, idoPtr);
+	}
     }
-    Itcl_DeleteHierIter(&hier);
     return TCL_OK;
 }
 
@@ -1163,33 +1358,24 @@ ItclInitObjectMethodVariables(
    ItclClass *iclsPtr,
    const char *name)
 {
-    ItclClass *iclsPtr2;
-    ItclHierIter hier;
+    ItclObjectProto *protoPtr;
     ItclMethodVariable *imvPtr;
     Tcl_HashEntry *hPtr;
-    Tcl_HashEntry *hPtr2;
-    Tcl_HashSearch place;
     int isNew;
+    int i;
     (void)dummy;
     (void)name;
 
-    imvPtr = NULL;
-    Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    while (iclsPtr2 != NULL) {
-        hPtr = Tcl_FirstHashEntry(&iclsPtr2->methodVariables, &place);
-        while (hPtr) {
-            imvPtr = (ItclMethodVariable*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectMethodVariables,
-	            (char *)imvPtr->namePtr, &isNew);
-	    if (isNew) {
-		Tcl_SetHashValue(hPtr2, imvPtr);
-            }
-            hPtr = Tcl_NextHashEntry(&place);
+    protoPtr = ItclGetObjectProto(iclsPtr);
+    for (i = 0; i < protoPtr->numMethodVariables; i++) {
+        imvPtr = protoPtr->methodVariables[i];
+	hPtr = Tcl_CreateHashEntry(
+	        &ItclCreateObjectTables(ioPtr)->objectMethodVariables,
+	        (char *)imvPtr->namePtr, &isNew);
+	if (isNew) {
+	    Tcl_SetHashValue(hPtr, imvPtr);
         }
-        iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Itcl_DeleteHierIter(&hier);
     return TCL_OK;
 }
 
@@ -1237,6 +1423,14 @@ Itcl_DeleteObject(
     if (hPtr) {
         Tcl_DeleteHashEntry(hPtr);
     }
+    if (contextIoPtr->accessCmd != NULL) {
+        hPtr = Tcl_FindHashEntry(&contextIoPtr->infoPtr->objectCmds,
+            (char*)contextIoPtr->accessCmd);
+        if (hPtr) {
+            Tcl_DeleteHashEntry(hPtr);
+        }
+    }
+    UnlinkInstance(contextIoPtr);
 
     /*
      *  Change the object's access command so that it can be
@@ -1299,8 +1493,7 @@ FinalizeDeleteObject(
         Tcl_ResetResult(interp);
     }
 
-    Tcl_DeleteHashTable(contextIoPtr->destructed);
-    ckfree((char*)contextIoPtr->destructed);
+    ItclFreeClassSet(contextIoPtr->destructed);
     contextIoPtr->destructed = NULL;
     return result;
 }
@@ -1376,14 +1569,25 @@ Itcl_DestructObject(
     result = TCL_OK;
     if (contextIoPtr->oPtr != NULL) {
         void *callbackPtr;
+
         /*
-         *  Create a "destructed" table to keep track of which destructors
+         *  Nothing to invoke anywhere in the hierarchy:  skip the
+         *  bookkeeping for the destructors and just get rid of the
+         *  variables.
+         */
+        if (!ItclObjectHasDestructors(contextIoPtr)) {
+	    ItclDeleteObjectVariablesNamespace(interp, contextIoPtr);
+            Tcl_ResetResult(interp);
+            return TCL_OK;
+        }
+
+        /*
+         *  Create a "destructed" set to keep track of which destructors
          *  have been invoked.  This is used in ItclDestructBase to make
          *  sure that all base class destructors have been called,
          *  explicitly or implicitly.
          */
-        contextIoPtr->destructed = (Tcl_HashTable*)ckalloc(sizeof(Tcl_HashTable));
-        Tcl_InitObjHashTable(contextIoPtr->destructed);
+        contextIoPtr->destructed = ItclNewClassSet();
 
         /*
          *  Destruct the object starting from the most-specific class.
@@ -1399,6 +1603,104 @@ Itcl_DestructObject(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclObjectHasDestructors()
+ *
+ *  Returns 0 if destructing the object will not run any script:  no
+ *  class of its hierarchy has a destructor and there is no hull window
+ *  to destroy.  Relies on the object prototype of its class, so objects
+ *  whose prototype is outdated are assumed to have destructors.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclObjectHasDestructors(
+    ItclObject *ioPtr)          /* object about to be destructed */
+{
+    ItclObjectProto *protoPtr = ioPtr->iclsPtr->protoPtr;
+
+    if ((protoPtr == NULL)
+            || (protoPtr->epoch != ioPtr->infoPtr->protoEpoch)) {
+        return 1;
+    }
+    return (protoPtr->numDestructors > 0)
+            || (ioPtr->hullWindowNamePtr != NULL);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclNewClassSet()
+ *
+ *  Creates an empty set of classes, used to remember the classes whose
+ *  constructor or destructor has already run for an object.  There are
+ *  only a few classes in a hierarchy, so the set is a plain array that
+ *  is searched linearly.  Free it with ItclFreeClassSet().
+ * ------------------------------------------------------------------------
+ */
+Itcl_Stack *
+ItclNewClassSet(void)
+{
+    Itcl_Stack *setPtr;
+
+    setPtr = (Itcl_Stack *)Itcl_Alloc(sizeof(Itcl_Stack));
+    Itcl_InitStack(setPtr);
+    return setPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeClassSet()
+ *
+ *  Frees a set of classes created by ItclNewClassSet().
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeClassSet(
+    Itcl_Stack *setPtr)         /* set to be freed */
+{
+    Itcl_DeleteStack(setPtr);
+    Itcl_Free(setPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclClassSetContains()
+ *
+ *  Returns non-zero if the class is an element of the set.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclClassSetContains(
+    Itcl_Stack *setPtr,         /* set to be searched */
+    ItclClass *iclsPtr)         /* class to look for */
+{
+    int i;
+
+    for (i = 0; i < setPtr->len; i++) {
+        if (setPtr->values[i] == (ClientData)iclsPtr) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclClassSetAdd()
+ *
+ *  Adds a class to the set, unless it is an element already.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclClassSetAdd(
+    Itcl_Stack *setPtr,         /* set to be extended */
+    ItclClass *iclsPtr)         /* class to add */
+{
+    if (!ItclClassSetContains(setPtr, iclsPtr)) {
+        Itcl_PushStack(iclsPtr, setPtr);
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclDestructBase()
@@ -1410,6 +1712,10 @@ Itcl_DestructObject(
  *  are invoked even if errors are encountered, and the result will
  *  always be TCL_OK.
  *
+ *  For the most-specific class, the object prototype already lists the
+ *  classes that have a destructor in the proper order, so those are
+ *  invoked one after the other as long as no class definition changes.
+ *
  *  Returns TCL_OK on success, or TCL_ERROR (along with an error message
  *  in interp->result) on error.
  * ------------------------------------------------------------------------
@@ -1422,18 +1728,47 @@ ItclDestructBase(
     int flags)                  /* flags: ITCL_IGNORE_ERRS */
 {
     int result;
+    int i;
+    int epoch;
     Itcl_ListElem *elem;
     ItclClass *iclsPtr;
+    ItclObjectProto *protoPtr;
 
     if (contextIoPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED) {
         return TCL_OK;
     }
+    protoPtr = contextIclsPtr->protoPtr;
+    epoch = contextIoPtr->infoPtr->protoEpoch;
+    if ((contextIclsPtr == contextIoPtr->iclsPtr) && (protoPtr != NULL)
+            && (protoPtr->epoch == epoch)) {
+        for (i = 0; i < protoPtr->numDestructors; i++) {
+            iclsPtr = protoPtr->destructors[i];
+            if (ItclClassSetContains(contextIoPtr->destructed, iclsPtr)) {
+                continue;
+            }
+            result = Itcl_InvokeMethodIfExists(interp, "destructor",
+                    iclsPtr, contextIoPtr, 0, NULL);
+            if (result != TCL_OK) {
+                return TCL_ERROR;
+            }
+            if (contextIoPtr->infoPtr->protoEpoch != epoch) {
+                /* the prototype is outdated, walk the hierarchy */
+                return ItclDestructBase(interp, contextIoPtr,
+                        contextIclsPtr, flags);
+            }
+            if (contextIoPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED) {
+                break;
+            }
+        }
+        Tcl_ResetResult(interp);
+        return TCL_OK;
+    }
+
     /*
      *  Look for a destructor in this class, and if found,
      *  invoke it.
      */
-    if (Tcl_FindHashEntry(contextIoPtr->destructed,
-            (char *)contextIclsPtr->namePtr) == NULL) {
+    if (!ItclClassSetContains(contextIoPtr->destructed, contextIclsPtr)) {
         result = Itcl_InvokeMethodIfExists(interp, "destructor",
             contextIclsPtr, contextIoPtr, 0, NULL);
         if (result != TCL_OK) {
@@ -1483,6 +1818,8 @@ Itcl_FindObject(
     const char *name,        /* name of the object */
     ItclObject **roPtr)      /* returns: object data or NULL */
 {
+    ItclObjectInfo *infoPtr;
+    Tcl_HashEntry *hPtr;
     Tcl_Command cmd;
     Tcl_CmdInfo cmdInfo;
     Tcl_Namespace *contextNs;
@@ -1501,11 +1838,20 @@ Itcl_FindObject(
     }
 
     /*
-     *  Look for the object's access command, and see if it has
-     *  the appropriate command handler.
+     *  Look for the object's access command.  Known access commands
+     *  map straight to their object; anything else (e.g. an imported
+     *  command) is checked for the appropriate command handler.
      */
     cmd = Tcl_FindCommand(interp, cmdName, contextNs, /* flags */ 0);
-    if (cmd != NULL && Itcl_IsObject(cmd)) {
+    infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
+            ITCL_INTERP_DATA, NULL);
+    hPtr = NULL;
+    if ((cmd != NULL) && (infoPtr != NULL)) {
+        hPtr = Tcl_FindHashEntry(&infoPtr->objectCmds, (char *)cmd);
+    }
+    if (hPtr != NULL) {
+        *roPtr = (ItclObject *)Tcl_GetHashValue(hPtr);
+    } else if (cmd != NULL && Itcl_IsObject(cmd)) {
         if (Tcl_GetCommandInfoFromToken(cmd, &cmdInfo) != 1) {
             *roPtr = NULL;
         }
@@ -1606,6 +1952,7 @@ ItclGetInstanceVar(
     ItclClass *contextIclsPtr) /* name is interpreted in this scope */
 {
     Tcl_HashEntry *hPtr;
+    Tcl_Var varPtr;
     Tcl_CallFrame frame;
     Tcl_CallFrame *framePtr;
     Tcl_Namespace *nsPtr;
@@ -1644,10 +1991,9 @@ ItclGetInstanceVar(
      *  Install the object context and access the data member
      *  like any other variable.
      */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables, (char *)ivPtr);
-    if (hPtr) {
+    varPtr = ItclGetObjectVar(contextIoPtr, ivPtr);
+    if (varPtr) {
 	Tcl_Obj *varName = Tcl_NewObj();
-	Tcl_Var varPtr = (Tcl_Var)Tcl_GetHashValue(hPtr);
 	Tcl_GetVariableFullName(interp, varPtr, varName);
 
 	val = Tcl_GetVar2(interp, Tcl_GetString(varName), name2,
@@ -1823,6 +2169,7 @@ ItclSetInstanceVar(
     ItclClass *contextIclsPtr) /* name is interpreted in this scope */
 {
     Tcl_HashEntry *hPtr;
+    Tcl_Var varPtr;
     Tcl_CallFrame frame;
     Tcl_CallFrame *framePtr;
     Tcl_Namespace *nsPtr;
@@ -1864,10 +2211,9 @@ ItclSetInstanceVar(
      *  like any other variable.
      */
 
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables, (char *)ivPtr);
-    if (hPtr) {
+    varPtr = ItclGetObjectVar(contextIoPtr, ivPtr);
+    if (varPtr) {
 	Tcl_Obj *varName = Tcl_NewObj();
-	Tcl_Var varPtr = (Tcl_Var)Tcl_GetHashValue(hPtr);
 	Tcl_GetVariableFullName(interp, varPtr, varName);
 
 	val = Tcl_SetVar2(interp, Tcl_GetString(varName), name2, value,
@@ -2357,60 +2703,6 @@ ItclTraceSelfnsVar(
     return NULL;
 }
 
-/*
- * ------------------------------------------------------------------------
- *  ItclTraceOptionVar()
- *
- *  Invoked to handle read/write traces on "option" variables
- *
- *  On read, this procedure checks if there is a cgetMethodPtr and calls it
- *  On write, this procedure checks if there is a configureMethodPtr
- *  or validateMethodPtr and calls it
- * ------------------------------------------------------------------------
- */
-/* ARGSUSED */
-static char*
-ItclTraceOptionVar(
-    ClientData cdata,	    /* object instance data */
-    Tcl_Interp *interp,	    /* interpreter managing this variable */
-    const char *name1,      /* variable name */
-    const char *name2,      /* unused */
-    int flags)		    /* flags indicating read/write */
-{
-    ItclObject *ioPtr;
-    ItclOption *ioptPtr;
-    (void)interp;
-    (void)name1;
-    (void)name2;
-
-/* FIXME !!! */
-/* don't know yet if ItclTraceOptionVar is really needed !! */
-/* FIXME should free memory on unset or rename!! */
-    if (cdata != NULL) {
-        ioPtr = (ItclObject*)cdata;
-	if (ioPtr == NULL) {
-	}
-    } else {
-        ioptPtr = (ItclOption*)cdata;
-	if (ioptPtr == NULL) {
-	}
-        /*
-         *  Handle read traces "itcl_options"
-         */
-        if ((flags & TCL_TRACE_READS) != 0) {
-            return NULL;
-        }
-
-        /*
-         *  Handle write traces "itcl_options"
-         */
-        if ((flags & TCL_TRACE_WRITES) != 0) {
-            return NULL;
-        }
-    }
-    return NULL;
-}
-
 /*
  * ------------------------------------------------------------------------
  *  ItclTraceComponentVar()
@@ -2451,13 +2743,15 @@ ItclTraceComponentVar(
 	    return NULL;
 	}
         objPtr = Tcl_NewStringObj(name1, -1);
-	hPtr = Tcl_FindHashEntry(&ioPtr->objectComponents, (char *)objPtr);
+	hPtr = Tcl_FindHashEntry(
+	        &ItclObjectTablesOf(ioPtr)->objectComponents, (char *)objPtr);
         Tcl_DecrRefCount(objPtr);
 
         /*
          *  Handle write traces
          */
         if ((flags & TCL_TRACE_WRITES) != 0) {
+	    ItclResetDelegateTargets(ioPtr);
 	    if (ioPtr->noComponentTrace) {
 	        return NULL;
 	    }
@@ -2512,11 +2806,187 @@ ItclTraceComponentVar(
     }
     return NULL;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFindDelegateTarget()
+ *
+ *  Looks up where a delegated option of an object is forwarded to, as
+ *  remembered by ItclCacheDelegateTarget().  The flags tell which kind
+ *  of lookup (ITCL_DELEGATE_CGET, ...) is asking.
+ *
+ *  Returns the target, or NULL if the option has not been resolved by
+ *  this kind of lookup since the last change of the components.
+ * ------------------------------------------------------------------------
+ */
+ItclDelegateTarget *
+ItclFindDelegateTarget(
+    ItclObject *ioPtr,         /* object owning the option */
+    Tcl_Obj *optionPtr,        /* option name, like "-color" */
+    int flags)                 /* ITCL_DELEGATE_* kind of lookup */
+{
+    Tcl_HashEntry *hPtr;
+    ItclDelegateTarget *targetPtr;
+
+    hPtr = Tcl_FindHashEntry(
+            &ItclObjectTablesOf(ioPtr)->delegateTargets, (char *)optionPtr);
+    if (hPtr == NULL) {
+        return NULL;
+    }
+    targetPtr = (ItclDelegateTarget *)Tcl_GetHashValue(hPtr);
+    if ((targetPtr->flags & flags) == 0) {
+        return NULL;
+    }
+    return targetPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclCacheDelegateTarget()
+ *
+ *  Remembers that the option optionPtr of an object has been resolved
+ *  to the delegation idoPtr, which currently goes to the component
+ *  named componentName.
+ *
+ *  Returns the target for the option.
+ * ------------------------------------------------------------------------
+ */
+ItclDelegateTarget *
+ItclCacheDelegateTarget(
+    ItclObject *ioPtr,         /* object owning the option */
+    Tcl_Obj *optionPtr,        /* option name, like "-color" */
+    ItclDelegatedOption *idoPtr, /* delegation found for the option */
+    ItclComponent *icPtr,      /* component the option goes to */
+    const char *componentName, /* current value of the component */
+    int flags)                 /* ITCL_DELEGATE_* kind of lookup */
+{
+    Tcl_HashEntry *hPtr;
+    ItclDelegateTarget *targetPtr;
+    int isNew;
+
+    hPtr = Tcl_CreateHashEntry(
+            &ItclCreateObjectTables(ioPtr)->delegateTargets, (char *)optionPtr,
+            &isNew);
+    if (!isNew) {
+        targetPtr = (ItclDelegateTarget *)Tcl_GetHashValue(hPtr);
+	if ((targetPtr->idoPtr == idoPtr) && (targetPtr->icPtr == icPtr)
+	        && (strcmp(Tcl_GetString(targetPtr->componentPtr),
+		componentName) == 0)) {
+	    targetPtr->flags |= flags;
+	    return targetPtr;
+	}
+	Tcl_DecrRefCount(targetPtr->componentPtr);
+	Tcl_DecrRefCount(targetPtr->optionPtr);
+    } else {
+        targetPtr = (ItclDelegateTarget *)Itcl_Alloc(
+	        sizeof(ItclDelegateTarget));
+        Tcl_SetHashValue(hPtr, targetPtr);
+    }
+    targetPtr->idoPtr = idoPtr;
+    targetPtr->icPtr = icPtr;
+    targetPtr->componentPtr = Tcl_NewStringObj(componentName, -1);
+    Tcl_IncrRefCount(targetPtr->componentPtr);
+    if ((idoPtr->asPtr != NULL) && (strcmp(Tcl_GetString(idoPtr->namePtr),
+            Tcl_GetString(optionPtr)) == 0)) {
+        targetPtr->optionPtr = idoPtr->asPtr;
+    } else {
+        targetPtr->optionPtr = optionPtr;
+    }
+    Tcl_IncrRefCount(targetPtr->optionPtr);
+    targetPtr->flags = flags;
+    return targetPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInitObjectTables()
+ *
+ *  Initializes the option, component and delegation tables of an
+ *  object.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclInitObjectTables(
+    ItclObjectTables *tablesPtr)  /* tables to initialize */
+{
+    Tcl_InitObjHashTable(&tablesPtr->objectOptions);
+    Tcl_InitObjHashTable(&tablesPtr->objectComponents);
+    Tcl_InitObjHashTable(&tablesPtr->objectMethodVariables);
+    Tcl_InitObjHashTable(&tablesPtr->objectDelegatedOptions);
+    Tcl_InitObjHashTable(&tablesPtr->objectDelegatedFunctions);
+    Tcl_InitObjHashTable(&tablesPtr->delegateTargets);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclDeleteObjectTables()
+ *
+ *  Deletes the option, component and delegation tables of an object.
+ *  The values in these tables belong to the classes, except for the
+ *  delegate targets, which must have been freed before.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclDeleteObjectTables(
+    ItclObjectTables *tablesPtr)  /* tables to delete */
+{
+    Tcl_DeleteHashTable(&tablesPtr->delegateTargets);
+    Tcl_DeleteHashTable(&tablesPtr->objectOptions);
+    Tcl_DeleteHashTable(&tablesPtr->objectComponents);
+    Tcl_DeleteHashTable(&tablesPtr->objectMethodVariables);
+    Tcl_DeleteHashTable(&tablesPtr->objectDelegatedOptions);
+    Tcl_DeleteHashTable(&tablesPtr->objectDelegatedFunctions);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclCreateObjectTables()
+ *
+ *  Returns the option, component and delegation tables of an object
+ *  for adding entries.  Objects of plain classes never fill them, so
+ *  they are only allocated on the first call.
+ * ------------------------------------------------------------------------
+ */
+ItclObjectTables *
+ItclCreateObjectTables(
+    ItclObject *ioPtr)         /* object owning the tables */
+{
+    if (ioPtr->tablesPtr == NULL) {
+        ioPtr->tablesPtr = (ItclObjectTables *)ckalloc(
+	        sizeof(ItclObjectTables));
+	ItclInitObjectTables(ioPtr->tablesPtr);
+    }
+    return ioPtr->tablesPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclResetDelegateTargets()
+ *
+ *  Forgets all resolved delegated options of an object.  Called when
+ *  one of its components is set or its delegated options change.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclResetDelegateTargets(
+    ItclObject *ioPtr)         /* object owning the options */
+{
+    FOREACH_HASH_DECLS;
+    ItclDelegateTarget *targetPtr;
+
+    FOREACH_HASH_VALUE(targetPtr, &ItclObjectTablesOf(ioPtr)->delegateTargets) {
+        Tcl_DecrRefCount(targetPtr->componentPtr);
+        Tcl_DecrRefCount(targetPtr->optionPtr);
+	Itcl_Free(targetPtr);
+	Tcl_DeleteHashEntry(hPtr);
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclTraceItclHullVar()
  *
- *  Invoked to handle read/write traces on "itcl_hull" variables
+ *  Invoked to handle write traces on "itcl_hull" variables
  *
  *  On write, this procedure returns an error as "itcl_hull" may not be modfied
  *  after the first initialization
@@ -2562,6 +3032,7 @@ ItclTraceItclHullVar(
         if ((flags & TCL_TRACE_WRITES) != 0) {
 	    if (ivPtr->initted == 0) {
 		ivPtr->initted = 1;
+		ItclResetDelegateTargets(ioPtr);
                 return NULL;
 	    } else {
 	        return (char *)"The itcl_hull component cannot be redefined";
@@ -2638,11 +3109,83 @@ ItclDestroyObject(
         if (hPtr) {
             Tcl_DeleteHashEntry(hPtr);
         }
+        hPtr = Tcl_FindHashEntry(&contextIoPtr->infoPtr->objectCmds,
+            (char*)contextIoPtr->accessCmd);
+        if (hPtr) {
+            Tcl_DeleteHashEntry(hPtr);
+        }
+	UnlinkInstance(contextIoPtr);
         contextIoPtr->accessCmd = NULL;
     }
     Itcl_ReleaseData(contextIoPtr);
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  LinkInstance()
+ *
+ *  Appends an object to the instance list of its most-specific class
+ *  and updates the instance counters of that class.  Called whenever
+ *  the object is entered into the objects table of the ItclObjectInfo,
+ *  does nothing if it is already in the list.
+ * ------------------------------------------------------------------------
+ */
+static void
+LinkInstance(
+    ItclObject *ioPtr)  /* object being made known */
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+
+    if ((ioPtr->prevInstancePtr != NULL)
+            || (iclsPtr->firstInstancePtr == ioPtr)) {
+        return;
+    }
+    ioPtr->prevInstancePtr = iclsPtr->lastInstancePtr;
+    ioPtr->nextInstancePtr = NULL;
+    if (iclsPtr->lastInstancePtr != NULL) {
+        iclsPtr->lastInstancePtr->nextInstancePtr = ioPtr;
+    } else {
+        iclsPtr->firstInstancePtr = ioPtr;
+    }
+    iclsPtr->lastInstancePtr = ioPtr;
+    if (++iclsPtr->numInstances > iclsPtr->peakInstances) {
+        iclsPtr->peakInstances = iclsPtr->numInstances;
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  UnlinkInstance()
+ *
+ *  Removes an object from the instance list of its class, once it is
+ *  taken out of the objects table of the ItclObjectInfo.
+ * ------------------------------------------------------------------------
+ */
+static void
+UnlinkInstance(
+    ItclObject *ioPtr)  /* object going away */
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+
+    if ((ioPtr->prevInstancePtr == NULL)
+            && (iclsPtr->firstInstancePtr != ioPtr)) {
+        return;
+    }
+    if (ioPtr->prevInstancePtr != NULL) {
+        ioPtr->prevInstancePtr->nextInstancePtr = ioPtr->nextInstancePtr;
+    } else {
+        iclsPtr->firstInstancePtr = ioPtr->nextInstancePtr;
+    }
+    if (ioPtr->nextInstancePtr != NULL) {
+        ioPtr->nextInstancePtr->prevInstancePtr = ioPtr->prevInstancePtr;
+    } else {
+        iclsPtr->lastInstancePtr = ioPtr->prevInstancePtr;
+    }
+    ioPtr->prevInstancePtr = NULL;
+    ioPtr->nextInstancePtr = NULL;
+    iclsPtr->numInstances--;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  FreeObject()
@@ -2656,10 +3199,9 @@ FreeObject(
     char * cdata)  /* object instance data */
 {
     FOREACH_HASH_DECLS;
-    Tcl_HashSearch place;
-    ItclCallContext *callContextPtr;
     ItclObject *ioPtr;
     Tcl_Var var;
+    int i;
 
     ioPtr = (ItclObject*)cdata;
 
@@ -2675,39 +3217,49 @@ FreeObject(
      *    from below.
      */
 
+    UnlinkInstance(ioPtr);
     ItclReleaseClass(ioPtr->iclsPtr);
     if (ioPtr->constructed) {
-        Tcl_DeleteHashTable(ioPtr->constructed);
-        ckfree((char*)ioPtr->constructed);
+        ItclFreeClassSet(ioPtr->constructed);
     }
     if (ioPtr->destructed) {
-        Tcl_DeleteHashTable(ioPtr->destructed);
-        ckfree((char*)ioPtr->destructed);
+        ItclFreeClassSet(ioPtr->destructed);
     }
     ItclDeleteObjectsDictInfo(ioPtr->interp, ioPtr);
     /*
      *  Delete all context definitions.
      */
-    while (1) {
-	hPtr = Tcl_FirstHashEntry(&ioPtr->contextCache, &place);
-	if (hPtr == NULL) {
-	    break;
+    if (ioPtr->callContexts != NULL) {
+	for (i = 0; i < ioPtr->numCallContexts; i++) {
+	    if (ioPtr->callContexts[i] != NULL) {
+		Itcl_Free(ioPtr->callContexts[i]);
+	    }
 	}
-	callContextPtr = (ItclCallContext *)Tcl_GetHashValue(hPtr);
-	Tcl_DeleteHashEntry(hPtr);
-	ckfree((char *)callContextPtr);
+	ckfree((char *)ioPtr->callContexts);
+	ioPtr->callContexts = NULL;
+	ioPtr->numCallContexts = 0;
     }
     FOREACH_HASH_VALUE(var, &ioPtr->objectVariables) {
 	Itcl_ReleaseVar(var);
     }
+    ioPtr->thisVarPtr = NULL;
+    if (ioPtr->optionsVarPtr != NULL) {
+	Itcl_ReleaseVar(ioPtr->optionsVarPtr);
+	ioPtr->optionsVarPtr = NULL;
+    }
+    if (ioPtr->varSlots != NULL) {
+	ckfree((char *)ioPtr->varSlots);
+	ioPtr->varSlots = NULL;
+	ioPtr->numVarSlots = 0;
+    }
 
-    Tcl_DeleteHashTable(&ioPtr->contextCache);
     Tcl_DeleteHashTable(&ioPtr->objectVariables);
-    Tcl_DeleteHashTable(&ioPtr->objectOptions);
-    Tcl_DeleteHashTable(&ioPtr->objectComponents);
-    Tcl_DeleteHashTable(&ioPtr->objectMethodVariables);
-    Tcl_DeleteHashTable(&ioPtr->objectDelegatedOptions);
-    Tcl_DeleteHashTable(&ioPtr->objectDelegatedFunctions);
+    if (ioPtr->tablesPtr != NULL) {
+	ItclResetDelegateTargets(ioPtr);
+	ItclDeleteObjectTables(ioPtr->tablesPtr);
+	ckfree((char *)ioPtr->tablesPtr);
+	ioPtr->tablesPtr = NULL;
+    }
     Tcl_DecrRefCount(ioPtr->namePtr);
     Tcl_DecrRefCount(ioPtr->origNamePtr);
     if (ioPtr->createNamePtr != NULL) {
@@ -2998,6 +3550,44 @@ GetClassFromClassName(
     Tcl_DecrRefCount(objPtr);
     return iclsPtr;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  GetQualifierClass()
+ *
+ *  Resolves the "Class" part of a "Class::method" call on an object of
+ *  class iclsPtr like GetClassFromClassName().  Classes found within
+ *  the hierarchy of iclsPtr are remembered in its qualifierClasses
+ *  table, which is emptied by Itcl_BuildVirtualTables().
+ * ------------------------------------------------------------------------
+ */
+static ItclClass *
+GetQualifierClass(
+    Tcl_Interp *interp,
+    const char *className,
+    ItclClass *iclsPtr)
+{
+    Tcl_HashEntry *hPtr;
+    ItclClass *foundPtr;
+    int isNew;
+
+    hPtr = Tcl_FindHashEntry(&iclsPtr->qualifierClasses, className);
+    if (hPtr != NULL) {
+        return (ItclClass *)Tcl_GetHashValue(hPtr);
+    }
+    foundPtr = GetClassFromClassName(interp, className, iclsPtr);
+    /*
+     *  Classes outside of the hierarchy may come and go, so only the
+     *  base classes (and the class itself) are remembered.
+     */
+    if ((foundPtr != NULL) && (Tcl_FindHashEntry(&iclsPtr->heritage,
+            (char *)foundPtr) != NULL)) {
+        hPtr = Tcl_CreateHashEntry(&iclsPtr->qualifierClasses, className,
+	        &isNew);
+	Tcl_SetHashValue(hPtr, foundPtr);
+    }
+    return foundPtr;
+}
 
 /*
  * ------------------------------------------------------------------------
@@ -3012,8 +3602,6 @@ ItclMapMethodNameProc(
     Tcl_Class *startClsPtr,
     Tcl_Obj *methodObj)
 {
-    Tcl_Obj *methodName;
-    Tcl_Obj *className;
     Tcl_DString buffer;
     Tcl_HashEntry *hPtr;
     Tcl_Namespace * myNsPtr;
@@ -3027,9 +3615,16 @@ ItclMapMethodNameProc(
 
     iclsPtr = NULL;
     iclsPtr2 = NULL;
-    methodName = NULL;
     infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
             ITCL_INTERP_DATA, NULL);
+    if (infoPtr->directImPtr != NULL) {
+	/*
+	 *  Called for Itcl_InvokeMethod, which has checked the method
+	 *  and set the start class already.
+	 */
+	infoPtr->directImPtr = NULL;
+	return TCL_OK;
+    }
     ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
             infoPtr->object_meta_type);
     hPtr = Tcl_FindHashEntry(&infoPtr->objects, (char *)ioPtr);
@@ -3055,7 +3650,14 @@ ItclMapMethodNameProc(
         iclsPtr = ioPtr->iclsPtr;
     }
     sp = Tcl_GetString(methodObj);
-    Itcl_ParseNamespPath(sp, &buffer, &head, &tail);
+    if (strstr(sp, "::") != NULL) {
+        Itcl_ParseNamespPath(sp, &buffer, &head, &tail);
+    } else {
+	/* the usual plain method name, nothing to split */
+        Tcl_DStringInit(&buffer);
+        head = NULL;
+	tail = sp;
+    }
     if (head == NULL) {
         /* itcl bug #3600923 call private method in class
 	 * without namespace
@@ -3070,22 +3672,15 @@ ItclMapMethodNameProc(
 	}
     }
     if (head != NULL) {
-        className = NULL;
-        methodName = Tcl_NewStringObj(tail, -1);
-        Tcl_IncrRefCount(methodName);
-        className = Tcl_NewStringObj(head, -1);
-        Tcl_IncrRefCount(className);
 	if (strlen(head) > 0) {
-	    iclsPtr2 = GetClassFromClassName(interp, head, iclsPtr);
+	    iclsPtr2 = GetQualifierClass(interp, head, iclsPtr);
 	} else {
 	    iclsPtr2 = NULL;
 	}
 	if (iclsPtr2 != NULL) {
 	    *startClsPtr = iclsPtr2->clsPtr;
-	    Tcl_SetStringObj(methodObj, Tcl_GetString(methodName), -1);
+	    Tcl_SetStringObj(methodObj, tail, -1);
 	}
-        Tcl_DecrRefCount(className);
-        Tcl_DecrRefCount(methodName);
     }
     hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)methodObj);
     if (hPtr == NULL) {
@@ -135,6 +135,16 @@ static Tcl_ObjCmdProc Itcl_ClassForwardCmd;
 static Tcl_ObjCmdProc Itcl_ClassMethodVariableCmd;
 static Tcl_ObjCmdProc Itcl_ClassTypeConstructorCmd;
 static Tcl_ObjCmdProc ItclGenericClassCmd;
+static int DefineClass(ClientData clientData, Tcl_Interp *interp, int flags,
+        int objc, Tcl_Obj *const objv[], int fromSnapshot,
+        ItclClass **iclsPtrPtr);
+static int LoadSnapshotImage(ClientData clientData, Tcl_Interp *interp,
+        Tcl_Obj *cmdPtr, Tcl_Obj *imagePtr);
+static int ReplaySnapshotConfigBody(Tcl_Interp *interp,
+        ItclObjectInfo *infoPtr, Tcl_Obj *recordPtr, int objc,
+	Tcl_Obj *const objv[]);
+static int ReplaySnapshotMembers(Tcl_Interp *interp, ItclObjectInfo *infoPtr,
+        Tcl_Obj *membersPtr);
 
 static const struct {
     const char *name;
@@ -343,6 +353,103 @@ Itcl_ParseInit(
     Tcl_CreateObjCommand(interp, "::itcl::scope", Itcl_ScopeCmd,
         NULL, NULL);
 
+    /*
+     *  Add "new" command for creating objects in batches.
+     */
+    Tcl_CreateObjCommand(interp, "::itcl::new", Itcl_NewCmd,
+        NULL, NULL);
+
+    /*
+     *  Add the "itcl::profile" command for counting member function
+     *  calls.
+     */
+    if (Itcl_CreateEnsemble(interp, "::itcl::profile") != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (Itcl_AddEnsemblePart(interp, "::itcl::profile",
+            "on", "", Itcl_ProfileOnCmd,
+            infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData(infoPtr);
+    if (Itcl_AddEnsemblePart(interp, "::itcl::profile",
+            "off", "", Itcl_ProfileOffCmd,
+            infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData(infoPtr);
+    if (Itcl_AddEnsemblePart(interp, "::itcl::profile",
+            "reset", "", Itcl_ProfileResetCmd,
+            infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData(infoPtr);
+    if (Itcl_AddEnsemblePart(interp, "::itcl::profile",
+            "report", "", Itcl_ProfileReportCmd,
+            infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData(infoPtr);
+
+    /*
+     *  Add the "itcl::snapshot" command for saving class definitions
+     *  and creating them again without parsing their scripts.
+     */
+    if (Itcl_CreateEnsemble(interp, "::itcl::snapshot") != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (Itcl_AddEnsemblePart(interp, "::itcl::snapshot",
+            "save", "?className...?", Itcl_SnapshotSaveCmd,
+            infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData(infoPtr);
+    if (Itcl_AddEnsemblePart(interp, "::itcl::snapshot",
+            "load", "image", Itcl_SnapshotLoadCmd,
+            infoPtr, Itcl_ReleaseData) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData(infoPtr);
+
+    /*
+     *  Shared images belong to the whole process, so a safe interp
+     *  must not be able to put its own class code into them.
+     */
+    if (!Tcl_IsSafe(interp)) {
+        if (Itcl_AddEnsemblePart(interp, "::itcl::snapshot",
+                "share", "name ?className...?", Itcl_SnapshotShareCmd,
+                infoPtr, Itcl_ReleaseData) != TCL_OK) {
+            return TCL_ERROR;
+        }
+        Itcl_PreserveData(infoPtr);
+        if (Itcl_AddEnsemblePart(interp, "::itcl::snapshot",
+                "attach", "name", Itcl_SnapshotAttachCmd,
+                infoPtr, Itcl_ReleaseData) != TCL_OK) {
+            return TCL_ERROR;
+        }
+        Itcl_PreserveData(infoPtr);
+        if (Itcl_AddEnsemblePart(interp, "::itcl::snapshot",
+                "shared", "?pattern?", Itcl_SnapshotSharedCmd,
+                infoPtr, Itcl_ReleaseData) != TCL_OK) {
+            return TCL_ERROR;
+        }
+        Itcl_PreserveData(infoPtr);
+        if (Itcl_AddEnsemblePart(interp, "::itcl::snapshot",
+                "unshare", "name", Itcl_SnapshotUnshareCmd,
+                infoPtr, Itcl_ReleaseData) != TCL_OK) {
+            return TCL_ERROR;
+        }
+        Itcl_PreserveData(infoPtr);
+    }
+
+    /*
+     *  Add the "itcl::memstats" command for finding out where the
+     *  memory of classes and objects goes.
+     */
+    Tcl_CreateObjCommand(interp, "::itcl::memstats", Itcl_MemStatsCmd,
+        infoPtr, Itcl_ReleaseData);
+    Itcl_PreserveData(infoPtr);
+
     /*
      *  Add the "filter" commands (add/delete)
      */
@@ -623,15 +730,9 @@ Itcl_ClassCmd(
     return ItclClassBaseCmd(clientData, interp, ITCL_CLASS, objc, objv, NULL);
 }
 
-/*
- * ------------------------------------------------------------------------
- *  ItclClassBaseCmd()
- *
- * ------------------------------------------------------------------------
- */
-
 static Tcl_MethodCallProc ObjCallProc;
 static Tcl_MethodCallProc ArgCallProc;
+static Tcl_MethodCallProc MethodCCallProc;
 static Tcl_CloneProc CloneProc;
 
 static const Tcl_MethodType itclObjMethodType = {
@@ -650,6 +751,14 @@ static const Tcl_MethodType itclArgMethodType = {
     CloneProc
 };
 
+static const Tcl_MethodType itclMethodCMethodType = {
+    TCL_OO_METHOD_VERSION_CURRENT,
+    "itcl C method",
+    MethodCCallProc,
+    Itcl_ReleaseData,
+    CloneProc
+};
+
 static int
 CloneProc(
     Tcl_Interp *dummy,
@@ -718,6 +827,34 @@ ArgCallProc(
     return TCL_ERROR;
 }
 
+static int
+MethodCCallProc(
+    ClientData clientData,
+    Tcl_Interp *interp,
+    Tcl_ObjectContext context,
+    int objc,
+    Tcl_Obj *const *objv)
+{
+    ItclMemberFunc *imPtr = (ItclMemberFunc *)clientData;
+    ItclObject *ioPtr;
+    int skip;
+
+    /*
+     *  Methods from Itcl_RegisterMethodC get the object directly,
+     *  without ItclCheckCallMethod and a call context.
+     */
+    ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(
+            Tcl_ObjectContextObject(context), imPtr->infoPtr->object_meta_type);
+    skip = Tcl_ObjectContextSkippedArgs(context);
+    return ItclInvokeMethodC(interp, imPtr, ioPtr, objc-skip+1, objv+skip-1);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclClassBaseCmd()
+ *
+ * ------------------------------------------------------------------------
+ */
 int
 ItclClassBaseCmd(
     ClientData clientData,   /* info for all known objects */
@@ -727,6 +864,30 @@ ItclClassBaseCmd(
     int objc,                /* number of arguments */
     Tcl_Obj *const objv[],   /* argument objects */
     ItclClass **iclsPtrPtr)  /* for returning iclsPtr */
+{
+    return DefineClass(clientData, interp, flags, objc, objv, 0, iclsPtrPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  DefineClass()
+ *
+ *  Creates a class from "name definition" in objv[1] and objv[2].  The
+ *  definition is a script of parser commands, or, if fromSnapshot is
+ *  set, a member list of an "itcl::snapshot save" image, which is
+ *  replayed without evaluating a script.
+ * ------------------------------------------------------------------------
+ */
+static int
+DefineClass(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int flags,               /* flags: ITCL_CLASS, ITCL_TYPE,
+                              * ITCL_WIDGET or ITCL_WIDGETADAPTOR */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[],   /* argument objects */
+    int fromSnapshot,        /* objv[2] is a snapshot member list */
+    ItclClass **iclsPtrPtr)  /* for returning iclsPtr */
 {
     Tcl_Obj *argumentPtr;
     Tcl_Obj *bodyPtr;
@@ -814,12 +975,23 @@ ItclClassBaseCmd(
 
     Itcl_SetCallFrameResolver(interp, iclsPtr->resolvePtr);
     if (result == TCL_OK) {
-        result = Tcl_EvalObjEx(interp, objv[2], 0);
+        if (fromSnapshot) {
+            result = ReplaySnapshotMembers(interp, infoPtr, objv[2]);
+        } else {
+            result = Tcl_EvalObjEx(interp, objv[2], 0);
+        }
         Itcl_PopCallFrame(interp);
     }
     Itcl_PopStack(&infoPtr->clsStack);
 
     noCleanup = 0;
+    if ((result != TCL_OK) && fromSnapshot) {
+	Tcl_AppendObjToErrorInfo(interp, Tcl_ObjPrintf(
+		"\n    (while loading the snapshot of class \"%s\")",
+		className));
+        result = TCL_ERROR;
+        goto errorReturn;
+    }
     if (result != TCL_OK) {
 	Tcl_Obj *options = Tcl_GetReturnOptions(interp, result);
 	Tcl_Obj *key = Tcl_NewStringObj("-errorline", -1);
@@ -897,6 +1069,19 @@ if (imPtr->codePtr->flags & ITCL_IMPLEMENT_OBJCMD) {
 	Itcl_PreserveData(imPtr);
     }
 
+} else if (imPtr->codePtr->flags & ITCL_IMPLEMENT_METHODC) {
+    /* Implementation of this member is coded in C expecting the object */
+
+    imPtr->tmPtr = Tcl_NewMethod(interp, iclsPtr->clsPtr, imPtr->namePtr,
+	    1, &itclMethodCMethodType, imPtr);
+    Itcl_PreserveData(imPtr);
+
+    if (iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR)) {
+	imPtr->tmPtr = Tcl_NewInstanceMethod(interp, iclsPtr->oPtr,
+		imPtr->namePtr, 1, &itclMethodCMethodType, imPtr);
+	Itcl_PreserveData(imPtr);
+    }
+
 } else if (imPtr->codePtr->flags & ITCL_IMPLEMENT_ARGCMD) {
     /* Implementation of this member is coded in C expecting (char *) */
 
@@ -977,7 +1162,8 @@ if (imPtr->codePtr->flags & ITCL_IMPLEMENT_OBJCMD) {
 		}
 		if (strcmp(Tcl_GetString(imPtr->codePtr->bodyPtr),
 		        "@itcl-builtin-initoptions") == 0) {
-		    Tcl_AppendToObj(bodyPtr, "::itcl::builtin::initoptions", -1);
+		    Tcl_AppendToObj(bodyPtr, "::itcl::builtin::itcl_initoptions",
+		            -1);
 		    isDone = 1;
 		}
 		if (strcmp(Tcl_GetString(imPtr->codePtr->bodyPtr),
@@ -2354,7 +2540,838 @@ Itcl_ClassCommonCmd(
     return ItclClassCommonCmd(clientData, interp, objc, objv, 0, &ivPtr);
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  SnapshotMember()
+ *
+ *  Appends one member record {protection command arg...} to the member
+ *  list of a class snapshot.  An empty protection leaves the current
+ *  protection level alone when the record is replayed.
+ * ------------------------------------------------------------------------
+ */
+static void
+SnapshotMember(
+    Tcl_Obj *membersPtr,     /* member list of the class */
+    const char *protection,  /* "public", "protected", "private" or "" */
+    const char *command,     /* parser command to replay */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* arguments of the parser command */
+{
+    Tcl_Obj *recordPtr;
+    int i;
+
+    recordPtr = Tcl_NewListObj(0, NULL);
+    Tcl_ListObjAppendElement(NULL, recordPtr,
+            Tcl_NewStringObj(protection, -1));
+    Tcl_ListObjAppendElement(NULL, recordPtr, Tcl_NewStringObj(command, -1));
+    for (i = 0; i < objc; i++) {
+        Tcl_ListObjAppendElement(NULL, recordPtr,
+	        (objv[i] != NULL) ? objv[i] : Tcl_NewObj());
+    }
+    Tcl_ListObjAppendElement(NULL, membersPtr, recordPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  SnapshotClass()
+ *
+ *  Appends the record {className members} of a class to a snapshot
+ *  image, after the records of its base classes and of the class it
+ *  is nested in, if it is nested in one that can be saved.  The
+ *  members are
+ *  taken from the class definition as it is now, so bodies changed
+ *  with "itcl::body" or "itcl::configbody" are saved as changed.
+ *  Classes already in "savedPtr" are skipped.
+ * ------------------------------------------------------------------------
+ */
+static int
+SnapshotClass(
+    Tcl_Interp *interp,      /* current interpreter */
+    ItclClass *iclsPtr,      /* class to be saved */
+    Tcl_HashTable *savedPtr, /* classes already in the image */
+    Tcl_Obj *imagePtr)       /* image to append to */
+{
+    FOREACH_HASH_DECLS;
+    Itcl_ListElem *elem;
+    ItclClass *outerClsPtr;
+    ItclVariable *ivPtr;
+    ItclMemberFunc *imPtr;
+    ItclMemberCode *mcode;
+    Tcl_Obj *membersPtr;
+    Tcl_Obj *recordPtr;
+    Tcl_Obj *prefixPtr;
+    Tcl_Obj *objv[4];
+    const char *body;
+    int prefixLen;
+    int isNew;
+    int objc;
+
+    Tcl_CreateHashEntry(savedPtr, (char *)iclsPtr, &isNew);
+    if (!isNew) {
+        return TCL_OK;
+    }
+    if (iclsPtr->flags &
+            (ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR|ITCL_ECLASS)) {
+        Tcl_AppendResult(interp, "can't snapshot class \"",
+	        Tcl_GetString(iclsPtr->fullNamePtr),
+		"\": only classes defined with itcl::class can be saved",
+		NULL);
+        return TCL_ERROR;
+    }
+
+    /*
+     *  The namespace of an enclosing class must be created by that
+     *  class, so it goes first.
+     */
+    hPtr = Tcl_FindHashEntry(&iclsPtr->infoPtr->namespaceClasses,
+            (char *)iclsPtr->nsPtr->parentPtr);
+    if (hPtr != NULL) {
+	outerClsPtr = (ItclClass *)Tcl_GetHashValue(hPtr);
+	if (!(outerClsPtr->flags & (ITCL_CLASS_IS_DELETED|ITCL_TYPE|
+	        ITCL_WIDGET|ITCL_WIDGETADAPTOR|ITCL_ECLASS)) &&
+		(SnapshotClass(interp, outerClsPtr, savedPtr,
+		imagePtr) != TCL_OK)) {
+	    return TCL_ERROR;
+	}
+    }
+
+    membersPtr = Tcl_NewListObj(0, NULL);
+    Tcl_IncrRefCount(membersPtr);
+    elem = Itcl_FirstListElem(&iclsPtr->bases);
+    if (elem != NULL) {
+	Tcl_Obj *inheritPtr = Tcl_NewListObj(0, NULL);
+
+	Tcl_ListObjAppendElement(NULL, inheritPtr, Tcl_NewObj());
+	Tcl_ListObjAppendElement(NULL, inheritPtr,
+	        Tcl_NewStringObj("inherit", -1));
+	while (elem != NULL) {
+	    ItclClass *baseClsPtr = (ItclClass *)Itcl_GetListValue(elem);
+
+	    if (SnapshotClass(interp, baseClsPtr, savedPtr,
+	            imagePtr) != TCL_OK) {
+		Tcl_DecrRefCount(inheritPtr);
+		Tcl_DecrRefCount(membersPtr);
+		return TCL_ERROR;
+	    }
+	    Tcl_ListObjAppendElement(NULL, inheritPtr,
+	            baseClsPtr->fullNamePtr);
+	    elem = Itcl_NextListElem(elem);
+	}
+	Tcl_ListObjAppendElement(NULL, membersPtr, inheritPtr);
+    }
+
+    FOREACH_HASH_VALUE(ivPtr, &iclsPtr->variables) {
+	Tcl_Obj *configPtr;
+
+        if ((ivPtr->iclsPtr != iclsPtr) || (ivPtr->flags & (ITCL_THIS_VAR|
+	        ITCL_OPTIONS_VAR|ITCL_TYPE_VAR|ITCL_SELF_VAR|ITCL_SELFNS_VAR|
+		ITCL_WIN_VAR|ITCL_HULL_VAR|ITCL_OPTION_COMP_VAR))) {
+	    continue;
+	}
+	objc = 0;
+	objv[objc++] = ivPtr->namePtr;
+	if (ivPtr->flags & ITCL_COMMON) {
+	    if (ivPtr->init != NULL) {
+		objv[objc++] = ivPtr->init;
+	    }
+	    SnapshotMember(membersPtr, Itcl_ProtectionStr(ivPtr->protection),
+	            "common", objc, objv);
+	    continue;
+	}
+	configPtr = NULL;
+	if ((ivPtr->codePtr != NULL) &&
+	        Itcl_IsMemberCodeImplemented(ivPtr->codePtr)) {
+	    configPtr = ivPtr->codePtr->bodyPtr;
+	}
+	if (ivPtr->init != NULL) {
+	    objv[objc++] = ivPtr->init;
+	    if (configPtr != NULL) {
+		objv[objc++] = configPtr;
+	    }
+	}
+	SnapshotMember(membersPtr, Itcl_ProtectionStr(ivPtr->protection),
+	        "variable", objc, objv);
+	if ((ivPtr->init == NULL) && (configPtr != NULL)) {
+	    /*
+	     *  "variable" takes config code only after an init value,
+	     *  so code added by "itcl::configbody" is a record of its own.
+	     */
+	    objv[0] = ivPtr->namePtr;
+	    objv[1] = configPtr;
+	    SnapshotMember(membersPtr, "", "configbody", 2, objv);
+	}
+    }
+
+    /*
+     *  Constructor bodies are stored with a call of ItclConstructBase
+     *  in front, which the constructor command adds again.
+     */
+    prefixPtr = Tcl_ObjPrintf(
+            "[::info object namespace ${this}]::my ItclConstructBase %s\n",
+	    Tcl_GetString(iclsPtr->fullNamePtr));
+    Tcl_IncrRefCount(prefixPtr);
+    (void) Tcl_GetStringFromObj(prefixPtr, &prefixLen);
+
+    FOREACH_HASH_VALUE(imPtr, &iclsPtr->functions) {
+	Tcl_Obj *argsPtr;
+	Tcl_Obj *bodyPtr;
+
+	mcode = imPtr->codePtr;
+	if ((imPtr->iclsPtr != iclsPtr) || (mcode == NULL)) {
+	    continue;
+	}
+	body = Tcl_GetString(mcode->bodyPtr);
+	if ((mcode->flags & ITCL_BUILTIN) &&
+	        (strncmp(body, "@itcl-builtin-", 14) == 0)) {
+	    /* installed again by Itcl_InstallBiMethods */
+	    continue;
+	}
+	argsPtr = NULL;
+	if (mcode->flags & ITCL_ARG_SPEC) {
+	    argsPtr = mcode->argumentPtr;
+	} else if (imPtr->flags & ITCL_ARG_SPEC) {
+	    argsPtr = imPtr->origArgsPtr;
+	}
+	bodyPtr = NULL;
+	if (Itcl_IsMemberCodeImplemented(mcode)) {
+	    bodyPtr = mcode->bodyPtr;
+	}
+	objc = 0;
+	if (imPtr->flags & ITCL_CONSTRUCTOR) {
+	    objv[objc++] = argsPtr;
+	    if (iclsPtr->initCode != NULL) {
+		objv[objc++] = iclsPtr->initCode;
+	    }
+	    if ((bodyPtr != NULL) && (strncmp(body,
+	            Tcl_GetString(prefixPtr), prefixLen) == 0)) {
+		bodyPtr = Tcl_NewStringObj(body + prefixLen, -1);
+	    }
+	    objv[objc++] = bodyPtr;
+	    SnapshotMember(membersPtr, Itcl_ProtectionStr(imPtr->protection),
+	            "constructor", objc, objv);
+	} else if (imPtr->flags & ITCL_DESTRUCTOR) {
+	    objv[objc++] = bodyPtr;
+	    SnapshotMember(membersPtr, Itcl_ProtectionStr(imPtr->protection),
+	            "destructor", objc, objv);
+	} else {
+	    objv[objc++] = imPtr->namePtr;
+	    if ((argsPtr != NULL) || (bodyPtr != NULL)) {
+		objv[objc++] = argsPtr;
+	    }
+	    if (bodyPtr != NULL) {
+		objv[objc++] = bodyPtr;
+	    }
+	    SnapshotMember(membersPtr, Itcl_ProtectionStr(imPtr->protection),
+	            (imPtr->flags & ITCL_COMMON) ? "proc" : "method",
+		    objc, objv);
+	}
+    }
+    Tcl_DecrRefCount(prefixPtr);
+
+    recordPtr = Tcl_NewListObj(0, NULL);
+    Tcl_ListObjAppendElement(NULL, recordPtr, iclsPtr->fullNamePtr);
+    Tcl_ListObjAppendElement(NULL, recordPtr, membersPtr);
+    Tcl_ListObjAppendElement(NULL, imagePtr, recordPtr);
+    Tcl_DecrRefCount(membersPtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  SnapshotImage()
+ *
+ *  Makes an image of the classes named in objv, or of all classes if
+ *  objc is 0.  Base classes are saved along with the classes derived
+ *  from them, in front of them.
+ *
+ *  Returns the image with a reference count of 1, or NULL with an
+ *  error message in the interpreter.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj *
+SnapshotImage(
+    Tcl_Interp *interp,      /* current interpreter */
+    ItclObjectInfo *infoPtr, /* info for all known objects */
+    int objc,                /* number of class names */
+    Tcl_Obj *const objv[])   /* class names */
+{
+    FOREACH_HASH_DECLS;
+    ItclClass *iclsPtr;
+    Tcl_HashTable saved;
+    Tcl_Obj *imagePtr;
+    int result;
+    int i;
+
+    imagePtr = Tcl_NewListObj(0, NULL);
+    Tcl_IncrRefCount(imagePtr);
+    Tcl_ListObjAppendElement(NULL, imagePtr,
+            Tcl_NewStringObj(ITCL_SNAPSHOT_MAGIC, -1));
+    Tcl_ListObjAppendElement(NULL, imagePtr,
+            Tcl_NewIntObj(ITCL_SNAPSHOT_VERSION));
+    Tcl_InitHashTable(&saved, TCL_ONE_WORD_KEYS);
+
+    result = TCL_OK;
+    if (objc > 0) {
+	for (i = 0; (i < objc) && (result == TCL_OK); i++) {
+	    iclsPtr = Itcl_FindClass(interp, Tcl_GetString(objv[i]),
+	            /* autoload */ 0);
+	    if (iclsPtr == NULL) {
+		result = TCL_ERROR;
+	    } else {
+		result = SnapshotClass(interp, iclsPtr, &saved, imagePtr);
+	    }
+	}
+    } else {
+	FOREACH_HASH_VALUE(iclsPtr, &infoPtr->classes) {
+	    if (iclsPtr->flags & ITCL_CLASS_IS_DELETED) {
+		continue;
+	    }
+	    result = SnapshotClass(interp, iclsPtr, &saved, imagePtr);
+	    if (result != TCL_OK) {
+		break;
+	    }
+	}
+    }
+
+    Tcl_DeleteHashTable(&saved);
+    if (result != TCL_OK) {
+        Tcl_DecrRefCount(imagePtr);
+	return NULL;
+    }
+    return imagePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_SnapshotSaveCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::snapshot save"
+ *  command.  Handles the following syntax:
+ *
+ *    itcl::snapshot save ?className...?
+ *
+ *  Returns an image of the named classes, or of all classes, which
+ *  "itcl::snapshot load" turns back into classes.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_SnapshotSaveCmd(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    Tcl_Obj *imagePtr;
+
+    imagePtr = SnapshotImage(interp, (ItclObjectInfo *)clientData,
+            objc-1, objv+1);
+    if (imagePtr == NULL) {
+        return TCL_ERROR;
+    }
+    Tcl_SetObjResult(interp, imagePtr);
+    Tcl_DecrRefCount(imagePtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ReplaySnapshotConfigBody()
+ *
+ *  Replays a member record {{} configbody varName body}, which sets
+ *  the config code of a variable declared without an init value, as
+ *  "itcl::configbody" does, for the class on top of the class
+ *  definition stack.
+ * ------------------------------------------------------------------------
+ */
+static int
+ReplaySnapshotConfigBody(
+    Tcl_Interp *interp,      /* current interpreter */
+    ItclObjectInfo *infoPtr, /* info for all known objects */
+    Tcl_Obj *recordPtr,      /* whole member record */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* varName body */
+{
+    Tcl_HashEntry *hPtr;
+    ItclClass *iclsPtr;
+    ItclVarLookup *vlookup;
+    ItclVariable *ivPtr;
+    ItclMemberCode *mcode;
+
+    iclsPtr = (ItclClass *)Itcl_PeekStack(&infoPtr->clsStack);
+    vlookup = NULL;
+    if (objc == 2) {
+	hPtr = ItclResolveVarEntry(iclsPtr, Tcl_GetString(objv[0]));
+	if (hPtr != NULL) {
+	    vlookup = (ItclVarLookup *)Tcl_GetHashValue(hPtr);
+	}
+    }
+    if ((vlookup == NULL) || (vlookup->ivPtr->iclsPtr != iclsPtr)) {
+	Tcl_AppendResult(interp, "bad snapshot member \"",
+	        Tcl_GetString(recordPtr), "\"", NULL);
+	return TCL_ERROR;
+    }
+    ivPtr = vlookup->ivPtr;
+    if (Itcl_CreateMemberCode(interp, iclsPtr, NULL, Tcl_GetString(objv[1]),
+            &mcode) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    Itcl_PreserveData(mcode);
+    if (ivPtr->codePtr != NULL) {
+        Itcl_ReleaseData(ivPtr->codePtr);
+    }
+    ivPtr->codePtr = mcode;
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ReplaySnapshotMembers()
+ *
+ *  Runs the parser commands of the member list of a class snapshot
+ *  for the class on top of the class definition stack.  The commands
+ *  are called directly, so nothing is parsed or compiled as it would
+ *  be for a class definition script.
+ * ------------------------------------------------------------------------
+ */
+static int
+ReplaySnapshotMembers(
+    Tcl_Interp *interp,      /* current interpreter */
+    ItclObjectInfo *infoPtr, /* info for all known objects */
+    Tcl_Obj *membersPtr)     /* member list of the snapshot */
+{
+    Tcl_Obj **memberv;
+    Tcl_Obj **objv;
+    int memberc;
+    int objc;
+    int result;
+    int oldLevel;
+    int idx;
+    int i;
+
+    if (Tcl_ListObjGetElements(interp, membersPtr, &memberc,
+            &memberv) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    for (i = 0; i < memberc; i++) {
+        if (Tcl_ListObjGetElements(interp, memberv[i], &objc,
+	        &objv) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	if (objc < 2) {
+	    Tcl_AppendResult(interp, "bad snapshot member \"",
+	            Tcl_GetString(memberv[i]), "\"", NULL);
+	    return TCL_ERROR;
+	}
+	if (strcmp(Tcl_GetString(objv[1]), "configbody") == 0) {
+	    if (ReplaySnapshotConfigBody(interp, infoPtr, memberv[i],
+	            objc-2, objv+2) != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    continue;
+	}
+	if (Tcl_GetIndexFromObjStruct(interp, objv[1], parseCmds,
+	        sizeof(parseCmds[0]), "parser command", TCL_EXACT,
+		&idx) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	oldLevel = 0;
+	if (Tcl_GetCharLength(objv[0]) > 0) {
+	    int pIdx;
+
+	    if (Tcl_GetIndexFromObjStruct(interp, objv[0], protectionCmds,
+	            sizeof(protectionCmds[0]), "protection", TCL_EXACT,
+		    &pIdx) != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    oldLevel = Itcl_Protection(interp, protectionCmds[pIdx].protection);
+	}
+	result = parseCmds[idx].objProc(infoPtr, interp, objc-1, objv+1);
+	if (oldLevel != 0) {
+	    Itcl_Protection(interp, oldLevel);
+	}
+	if (result != TCL_OK) {
+	    return result;
+	}
+    }
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_SnapshotLoadCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::snapshot load"
+ *  command.  Handles the following syntax:
+ *
+ *    itcl::snapshot load <image>
+ *
+ *  Creates the classes of an image made by "itcl::snapshot save", in
+ *  the order they were saved.  Returns the list of class names.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_SnapshotLoadCmd(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    if (objc != 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "image");
+        return TCL_ERROR;
+    }
+    return LoadSnapshotImage(clientData, interp, objv[0], objv[1]);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  LoadSnapshotImage()
+ *
+ *  Creates the classes of an image made by "itcl::snapshot save", in
+ *  the order they were saved.  Leaves the list of class names as the
+ *  result.  If one of the classes can't be created, the classes
+ *  created before it are deleted again.
+ * ------------------------------------------------------------------------
+ */
+static int
+LoadSnapshotImage(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    Tcl_Obj *cmdPtr,         /* name of the invoking command */
+    Tcl_Obj *imagePtr)       /* image to load */
+{
+    Tcl_Obj *namesPtr;
+    Tcl_Obj **classv;
+    Tcl_Obj **recordv;
+    Tcl_Obj *defv[3];
+    int classc;
+    int recordc;
+    int version;
+    int result;
+    int i;
+
+    Tcl_IncrRefCount(imagePtr);
+    if ((Tcl_ListObjGetElements(NULL, imagePtr, &classc,
+            &classv) != TCL_OK) || (classc < 2) ||
+	    (strcmp(Tcl_GetString(classv[0]), ITCL_SNAPSHOT_MAGIC) != 0) ||
+	    (Tcl_GetIntFromObj(NULL, classv[1], &version) != TCL_OK)) {
+	Tcl_AppendResult(interp, "not an itcl snapshot image", NULL);
+	Tcl_DecrRefCount(imagePtr);
+	return TCL_ERROR;
+    }
+    if ((version < 1) || (version > ITCL_SNAPSHOT_VERSION)) {
+	Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+	        "can't load snapshot image version %d, expected version %d"
+		" or older", version, ITCL_SNAPSHOT_VERSION));
+	Tcl_DecrRefCount(imagePtr);
+	return TCL_ERROR;
+    }
+
+    namesPtr = Tcl_NewListObj(0, NULL);
+    Tcl_IncrRefCount(namesPtr);
+    result = TCL_OK;
+    defv[0] = cmdPtr;
+    for (i = 2; i < classc; i++) {
+	if ((Tcl_ListObjGetElements(NULL, classv[i], &recordc,
+	        &recordv) != TCL_OK) || (recordc != 2)) {
+	    Tcl_AppendResult(interp, "bad snapshot class record \"",
+	            Tcl_GetString(classv[i]), "\"", NULL);
+	    result = TCL_ERROR;
+	    break;
+	}
+	defv[1] = recordv[0];
+	defv[2] = recordv[1];
+	result = DefineClass(clientData, interp, ITCL_CLASS, 3, defv,
+	        /* fromSnapshot */ 1, NULL);
+	if (result != TCL_OK) {
+	    break;
+	}
+	Tcl_ListObjAppendElement(NULL, namesPtr, recordv[0]);
+    }
+    if (result == TCL_OK) {
+	Tcl_SetObjResult(interp, namesPtr);
+    } else {
+	Tcl_InterpState state;
+	Tcl_HashEntry *hPtr;
+	Tcl_Namespace *nsPtr;
+	Tcl_Obj **namev;
+	int namec;
+
+	/*
+	 *  Derived and nested classes come after the classes they
+	 *  depend on, so they are deleted first.
+	 */
+	state = Tcl_SaveInterpState(interp, result);
+	Tcl_ListObjGetElements(NULL, namesPtr, &namec, &namev);
+	for (i = namec-1; i >= 0; i--) {
+	    nsPtr = Tcl_FindNamespace(interp, Tcl_GetString(namev[i]),
+	            NULL, 0);
+	    if (nsPtr == NULL) {
+	        continue;
+	    }
+	    hPtr = Tcl_FindHashEntry(
+	            &((ItclObjectInfo *)clientData)->namespaceClasses,
+		    (char *)nsPtr);
+	    if (hPtr != NULL) {
+		Itcl_DeleteClass(interp, (ItclClass *)Tcl_GetHashValue(hPtr));
+	    }
+	}
+	result = Tcl_RestoreInterpState(interp, state);
+    }
+    Tcl_DecrRefCount(namesPtr);
+    Tcl_DecrRefCount(imagePtr);
+    return result;
+}
+
 
+/*
+ *  Images added with "itcl::snapshot share" belong to the process, so
+ *  that every interpreter of every thread can create its classes from
+ *  them.  Tcl_Objs cannot be used by more than one thread, so the
+ *  images are kept as plain strings.
+ */
+typedef struct SharedImage {
+    char *bytes;             /* string rep of the image */
+    int length;              /* number of bytes in it */
+} SharedImage;
+
+static Tcl_HashTable sharedImages;
+static int sharedImagesInitialized = 0;
+TCL_DECLARE_MUTEX(sharedImagesMutex)
+
+/*
+ * ------------------------------------------------------------------------
+ *  FreeSharedImages()
+ *
+ *  Exit handler that frees all images made by "itcl::snapshot share".
+ * ------------------------------------------------------------------------
+ */
+static void
+FreeSharedImages(
+    ClientData clientData)   /* unused */
+{
+    FOREACH_HASH_DECLS;
+    SharedImage *imgPtr;
+    (void)clientData;
+
+    Tcl_MutexLock(&sharedImagesMutex);
+    if (sharedImagesInitialized) {
+	FOREACH_HASH_VALUE(imgPtr, &sharedImages) {
+	    ckfree(imgPtr->bytes);
+	    ckfree((char *)imgPtr);
+	}
+	Tcl_DeleteHashTable(&sharedImages);
+	sharedImagesInitialized = 0;
+    }
+    Tcl_MutexUnlock(&sharedImagesMutex);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_SnapshotShareCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::snapshot share"
+ *  command.  Handles the following syntax:
+ *
+ *    itcl::snapshot share <name> ?className...?
+ *
+ *  Makes an image of the named classes, or of all classes, like
+ *  "itcl::snapshot save", and keeps it for the whole process under
+ *  the given name, replacing an image of the same name.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_SnapshotShareCmd(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    Tcl_HashEntry *hPtr;
+    SharedImage *imgPtr;
+    Tcl_Obj *imagePtr;
+    const char *bytes;
+    int length;
+    int isNew;
+
+    if (objc < 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "name ?className...?");
+        return TCL_ERROR;
+    }
+    imagePtr = SnapshotImage(interp, (ItclObjectInfo *)clientData,
+            objc-2, objv+2);
+    if (imagePtr == NULL) {
+        return TCL_ERROR;
+    }
+    bytes = Tcl_GetStringFromObj(imagePtr, &length);
+
+    Tcl_MutexLock(&sharedImagesMutex);
+    if (!sharedImagesInitialized) {
+	Tcl_InitHashTable(&sharedImages, TCL_STRING_KEYS);
+	sharedImagesInitialized = 1;
+	Tcl_CreateExitHandler(FreeSharedImages, NULL);
+    }
+    hPtr = Tcl_CreateHashEntry(&sharedImages, Tcl_GetString(objv[1]),
+            &isNew);
+    if (isNew) {
+	imgPtr = (SharedImage *)ckalloc(sizeof(SharedImage));
+	Tcl_SetHashValue(hPtr, imgPtr);
+    } else {
+	imgPtr = (SharedImage *)Tcl_GetHashValue(hPtr);
+	ckfree(imgPtr->bytes);
+    }
+    imgPtr->bytes = (char *)ckalloc(length + 1);
+    memcpy(imgPtr->bytes, bytes, length + 1);
+    imgPtr->length = length;
+    Tcl_MutexUnlock(&sharedImagesMutex);
+
+    Tcl_DecrRefCount(imagePtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_SnapshotAttachCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::snapshot attach"
+ *  command.  Handles the following syntax:
+ *
+ *    itcl::snapshot attach <name>
+ *
+ *  Creates the classes of the image shared under the given name by
+ *  any interpreter of the process.  Returns the list of class names.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_SnapshotAttachCmd(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    Tcl_HashEntry *hPtr;
+    SharedImage *imgPtr;
+    Tcl_Obj *imagePtr;
+
+    if (objc != 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "name");
+        return TCL_ERROR;
+    }
+    imagePtr = NULL;
+    Tcl_MutexLock(&sharedImagesMutex);
+    if (sharedImagesInitialized) {
+	hPtr = Tcl_FindHashEntry(&sharedImages, Tcl_GetString(objv[1]));
+	if (hPtr != NULL) {
+	    imgPtr = (SharedImage *)Tcl_GetHashValue(hPtr);
+	    imagePtr = Tcl_NewStringObj(imgPtr->bytes, imgPtr->length);
+	}
+    }
+    Tcl_MutexUnlock(&sharedImagesMutex);
+    if (imagePtr == NULL) {
+	Tcl_AppendResult(interp, "no shared snapshot image \"",
+	        Tcl_GetString(objv[1]), "\"", NULL);
+	return TCL_ERROR;
+    }
+    return LoadSnapshotImage(clientData, interp, objv[0], imagePtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_SnapshotSharedCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::snapshot shared"
+ *  command.  Handles the following syntax:
+ *
+ *    itcl::snapshot shared ?pattern?
+ *
+ *  Returns the names of the shared images that match the pattern, or
+ *  of all shared images.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_SnapshotSharedCmd(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    FOREACH_HASH_DECLS;
+    SharedImage *imgPtr;
+    Tcl_Obj *listPtr;
+    const char *pattern;
+    const char *name;
+    (void)clientData;
+
+    if (objc > 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "?pattern?");
+        return TCL_ERROR;
+    }
+    pattern = (objc == 2) ? Tcl_GetString(objv[1]) : NULL;
+    listPtr = Tcl_NewListObj(0, NULL);
+    Tcl_MutexLock(&sharedImagesMutex);
+    if (sharedImagesInitialized) {
+	FOREACH_HASH(name, imgPtr, &sharedImages) {
+	    if ((pattern == NULL) || Tcl_StringMatch(name, pattern)) {
+		Tcl_ListObjAppendElement(NULL, listPtr,
+		        Tcl_NewStringObj(name, -1));
+	    }
+	}
+    }
+    Tcl_MutexUnlock(&sharedImagesMutex);
+    Tcl_SetObjResult(interp, listPtr);
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_SnapshotUnshareCmd()
+ *
+ *  Invoked by Tcl whenever the user issues an "itcl::snapshot unshare"
+ *  command.  Handles the following syntax:
+ *
+ *    itcl::snapshot unshare <name>
+ *
+ *  Forgets the shared image of the given name.  Classes already
+ *  created from it are not affected.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_SnapshotUnshareCmd(
+    ClientData clientData,   /* info for all known objects */
+    Tcl_Interp *interp,      /* current interpreter */
+    int objc,                /* number of arguments */
+    Tcl_Obj *const objv[])   /* argument objects */
+{
+    Tcl_HashEntry *hPtr;
+    SharedImage *imgPtr;
+    int found;
+    (void)clientData;
+
+    if (objc != 2) {
+        Tcl_WrongNumArgs(interp, 1, objv, "name");
+        return TCL_ERROR;
+    }
+    found = 0;
+    Tcl_MutexLock(&sharedImagesMutex);
+    if (sharedImagesInitialized) {
+	hPtr = Tcl_FindHashEntry(&sharedImages, Tcl_GetString(objv[1]));
+	if (hPtr != NULL) {
+	    imgPtr = (SharedImage *)Tcl_GetHashValue(hPtr);
+	    ckfree(imgPtr->bytes);
+	    ckfree((char *)imgPtr);
+	    Tcl_DeleteHashEntry(hPtr);
+	    found = 1;
+	}
+    }
+    Tcl_MutexUnlock(&sharedImagesMutex);
+    if (!found) {
+	Tcl_AppendResult(interp, "no shared snapshot image \"",
+	        Tcl_GetString(objv[1]), "\"", NULL);
+	return TCL_ERROR;
+    }
+    return TCL_OK;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclFreeParserCommandData()
@@ -2411,7 +3428,7 @@ ItclDelObjectInfo(
 	    /*hPtr = Tcl_NextHashEntry(&place);*/
     }
     Tcl_DeleteHashTable(&infoPtr->objects);
-    Tcl_DeleteHashTable(&infoPtr->frameContext);
+    ItclFinishFrameContexts(infoPtr);
 
     Itcl_DeleteStack(&infoPtr->clsStack);
     Itcl_Free(infoPtr);
@@ -2658,7 +3675,8 @@ ItclParseOption(
     }
     if (ioPtr != NULL) {
         /* check for already delegated!! */
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedOptions,
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(ioPtr)->objectDelegatedOptions,
 	        (char *)objv[1]);
 	if (hPtr != NULL) {
 	    Tcl_AppendResult(interp, "cannot define option \"", optionName,
@@ -3407,7 +4425,8 @@ delegate method * ?to <componentName>? ?using <pattern>? ?except <methods>?";
     /* check for already delegated */
     methodNamePtr = Tcl_NewStringObj(methodName, -1);
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedFunctions, (char *)
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(ioPtr)->objectDelegatedFunctions, (char *)
                 methodNamePtr);
     } else {
         hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions, (char *)
@@ -3527,6 +4546,7 @@ Itcl_ClassDelegateMethodCmd(
         return result;
     }
     idmPtr->flags |= ITCL_METHOD;
+    ItclResetResolveCmdCache(iclsPtr);
     hPtr = Tcl_CreateHashEntry(&iclsPtr->delegatedFunctions,
             (char *)idmPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, idmPtr);
@@ -3701,7 +4721,8 @@ Itcl_HandleDelegateOptionCmd(
     allOptionNamePtr = Tcl_NewStringObj("*", -1);
     Tcl_IncrRefCount(allOptionNamePtr);
     if (ioPtr != NULL) {
-        hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedOptions, (char *)
+        hPtr = Tcl_FindHashEntry(
+                &ItclObjectTablesOf(ioPtr)->objectDelegatedOptions, (char *)
                 allOptionNamePtr);
     } else {
         hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedOptions, (char *)
@@ -3752,7 +4773,7 @@ Itcl_HandleDelegateOptionCmd(
 	/* FIXME !!! */
         /* check for valid option name */
 	if (ioPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&ioPtr->objectOptions,
+	    hPtr = Tcl_FindHashEntry(&ItclObjectTablesOf(ioPtr)->objectOptions,
 	            (char *)optionNamePtr);
 	} else {
             Itcl_InitHierIter(&hier, iclsPtr);
@@ -3892,6 +4913,7 @@ Itcl_ClassDelegateOptionCmd(
     hPtr = Tcl_CreateHashEntry(&iclsPtr->delegatedOptions,
             (char *)idoPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, idoPtr);
+    iclsPtr->infoPtr->protoEpoch++;
     return TCL_OK;
 }
 
@@ -4071,9 +5093,12 @@ delegate typemethod * ?to <componentName>? ?using <pattern>? ?except <typemethod
         Tcl_IncrRefCount(idmPtr->usingPtr);
     }
     idmPtr->flags = ITCL_COMMON|ITCL_TYPE_METHOD;
+    ItclResetResolveCmdCache(iclsPtr);
     hPtr = Tcl_CreateHashEntry(&iclsPtr->delegatedFunctions,
             (char *)idmPtr->namePtr, &isNew);
     if (!isNew) {
+	/* the old one may still be queued for the dicts */
+	ItclFlushDictInfo(interp, iclsPtr->infoPtr);
         ItclDeleteDelegatedFunction((ItclDelegatedFunction *)
 	        Tcl_GetHashValue(hPtr));
     }
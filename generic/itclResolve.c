@@ -64,7 +64,6 @@ Itcl_ClassCmdResolver(
     Tcl_Command *rPtr)		/* returns: resolved command */
 {
     Tcl_HashEntry *hPtr;
-    Tcl_Obj *objPtr;
     Tcl_Obj *namePtr;
     ItclClass *iclsPtr;
     ItclObjectInfo *infoPtr;
@@ -86,26 +85,41 @@ Itcl_ClassCmdResolver(
      *  If the command is a member function
      */
     imPtr = NULL;
-    objPtr = Tcl_NewStringObj(name, -1);
-    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)objPtr);
-    Tcl_DecrRefCount(objPtr);
+    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmdNames, name);
     if (hPtr == NULL) {
 	ItclCmdLookup *clookup;
-	if ((iclsPtr->flags & ITCL_ECLASS)) {
+	if ((iclsPtr->flags & ITCL_ECLASS) == 0) {
+            return TCL_CONTINUE;
+	}
+	/*
+	 *  Names of delegated methods resolve to "unknown".  Remember
+	 *  the outcome, so that each name is looked up only once.
+	 */
+	hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmdCache, name);
+	if (hPtr != NULL) {
+	    clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
+	} else {
+	    int isNew;
+
+	    clookup = NULL;
 	    namePtr = Tcl_NewStringObj(name, -1);
 	    hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions,
 	            (char *)namePtr);
+	    Tcl_DecrRefCount(namePtr);
 	    if (hPtr != NULL) {
-                objPtr = Tcl_NewStringObj("unknown", -1);
-                hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)objPtr);
-                Tcl_DecrRefCount(objPtr);
+                hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmdNames,
+                        "unknown");
+                if (hPtr != NULL) {
+                    clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
+                }
 	    }
-	    Tcl_DecrRefCount(namePtr);
+	    hPtr = Tcl_CreateHashEntry(&iclsPtr->resolveCmdCache, name,
+	            &isNew);
+	    Tcl_SetHashValue(hPtr, clookup);
 	}
-        if (hPtr == NULL) {
+        if (clookup == NULL) {
             return TCL_CONTINUE;
         }
-        clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
         imPtr = clookup->imPtr;
     } else {
         ItclCmdLookup *clookup;
@@ -246,6 +260,7 @@ Itcl_ClassVarResolver(
     ItclObject *contextIoPtr;
     Tcl_HashEntry *hPtr;
     ItclVarLookup *vlookup;
+    Tcl_Var objVarPtr;
 
     contextIoPtr = NULL;
     /*
@@ -311,6 +326,12 @@ Itcl_ClassVarResolver(
     hPtr = Tcl_FindHashEntry(&infoPtr->objects, (char *)contextIoPtr);
     if (hPtr == NULL) {
 	return TCL_CONTINUE;
+    }
+    if ((vlookup->ivPtr->flags & ITCL_THIS_VAR)
+	    && (contextIoPtr->thisVarPtr != NULL)
+	    && (strcmp(name, "this") == 0)) {
+	*rPtr = contextIoPtr->thisVarPtr;
+	return TCL_OK;
     }
         if (contextIoPtr->iclsPtr != vlookup->ivPtr->iclsPtr) {
 	    if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0) {
@@ -322,10 +343,9 @@ Itcl_ClassVarResolver(
                 }
             }
         }
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables,
-                (char *)vlookup->ivPtr);
+        objVarPtr = ItclGetObjectVar(contextIoPtr, vlookup->ivPtr);
 
-    if (hPtr == NULL) {
+    if (objVarPtr == NULL) {
         return TCL_CONTINUE;
     }
     if (strcmp(name, "this") == 0) {
@@ -353,15 +373,8 @@ Itcl_ClassVarResolver(
     }
     if (strcmp(name, "itcl_options") == 0) {
         Tcl_Var varPtr;
-        Tcl_DString buffer;
 
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, -1);
-	Tcl_DStringAppend(&buffer,
-		(Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), -1);
-	Tcl_DStringAppend(&buffer, "::itcl_options", -1);
-	varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer), NULL, 0);
-	Tcl_DStringFree(&buffer);
+	varPtr = ItclObjectOptionsVar(interp, contextIoPtr);
         if (varPtr != NULL) {
             *rPtr = varPtr;
 	    return TCL_OK;
@@ -383,11 +396,8 @@ Itcl_ClassVarResolver(
 	    return TCL_OK;
         }
     }
-    if (hPtr != NULL) {
-        *rPtr = (Tcl_Var)Tcl_GetHashValue(hPtr);
-        return TCL_OK;
-    }
-    return TCL_CONTINUE;
+    *rPtr = objVarPtr;
+    return TCL_OK;
 }
 
 
@@ -499,6 +509,7 @@ ItclClassRuntimeVarResolver(
     ItclClass *iclsPtr;
     ItclObject *contextIoPtr;
     Tcl_HashEntry *hPtr;
+    Tcl_Var objVarPtr;
 
     /*
      *  If this is a common data member, then the associated
@@ -524,6 +535,16 @@ ItclClassRuntimeVarResolver(
 	return NULL;
     }
 
+    /*
+     *  All class scopes of an object share the "this" variable of its
+     *  most-specific class.  It is cached on the object.
+     */
+    if ((vlookup->ivPtr->flags & ITCL_THIS_VAR)
+	    && (contextIoPtr->thisVarPtr != NULL)
+	    && (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0)) {
+	return contextIoPtr->thisVarPtr;
+    }
+
         if (contextIoPtr->iclsPtr != vlookup->ivPtr->iclsPtr) {
 	    if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0) {
 	        /* only for the this variable we need the one of the
@@ -536,8 +557,7 @@ ItclClassRuntimeVarResolver(
 	        }
 	    }
         }
-        hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables,
-                (char *)vlookup->ivPtr);
+        objVarPtr = ItclGetObjectVar(contextIoPtr, vlookup->ivPtr);
         if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0) {
             Tcl_Var varPtr;
             Tcl_DString buffer;
@@ -560,19 +580,10 @@ ItclClassRuntimeVarResolver(
 	        return varPtr;
             }
         }
-        if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr),
-	        "itcl_options") == 0) {
+        if (vlookup->ivPtr->flags & ITCL_OPTIONS_VAR) {
             Tcl_Var varPtr;
-            Tcl_DString buffer;
 
-	    Tcl_DStringInit(&buffer);
-	    Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, -1);
-	    Tcl_DStringAppend(&buffer,
-		    (Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), -1);
-	    Tcl_DStringAppend(&buffer, "::itcl_options", -1);
-	    varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer),
-	            NULL, 0);
-	    Tcl_DStringFree(&buffer);
+	    varPtr = ItclObjectOptionsVar(interp, contextIoPtr);
             if (varPtr != NULL) {
 	        return varPtr;
             }
@@ -594,10 +605,7 @@ ItclClassRuntimeVarResolver(
 	        return varPtr;
             }
         }
-        if (hPtr != NULL) {
-            return (Tcl_Var)Tcl_GetHashValue(hPtr);
-        }
-    return NULL;
+    return objVarPtr;
 }
 
 /*
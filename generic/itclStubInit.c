@@ -198,6 +198,7 @@ static const ItclIntStubs itclIntStubs = {
     Itcl_SetContext, /* 182 */
     Itcl_UnsetContext, /* 183 */
     ItclGetInstanceVar, /* 184 */
+    Itcl_CreateObjects, /* 185 */
 };
 
 static const ItclStubHooks itclStubHooks = {
@@ -237,6 +238,10 @@ const ItclStubs itclStubs = {
     Itcl_DiscardInterpState, /* 25 */
     Itcl_Alloc, /* 26 */
     Itcl_Free, /* 27 */
+    Itcl_GetMethod, /* 28 */
+    Itcl_InvokeMethod, /* 29 */
+    Itcl_ReleaseMethod, /* 30 */
+    Itcl_RegisterMethodC, /* 31 */
 };
 
 /* !END!: Do not edit above this line. */
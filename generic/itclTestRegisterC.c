@@ -113,12 +113,79 @@ fprintf(stderr, "IP2:%p %p %p\n",interp, clientData, iclsPtr);
     return TCL_OK;
 }
 
+/*
+ *  testinvokemethod className methodName objectName ?arg ...?
+ *
+ *  Looks up a method with Itcl_GetMethod, invokes it on an object with
+ *  Itcl_InvokeMethod and releases the token again.
+ */
+static int
+TestInvokeMethodCmd(
+    ClientData clientData,
+    Tcl_Interp *interp,
+    int objc,
+    Tcl_Obj *const *objv)
+{
+    Itcl_Method method;
+    Tcl_Object object;
+    int result;
+    (void)clientData;
+
+    if (objc < 4) {
+        Tcl_WrongNumArgs(interp, 1, objv,
+	        "className methodName objectName ?arg ...?");
+        return TCL_ERROR;
+    }
+    method = Itcl_GetMethod(interp, Tcl_GetString(objv[1]),
+            Tcl_GetString(objv[2]));
+    if (method == NULL) {
+        return TCL_ERROR;
+    }
+    object = Tcl_GetObjectFromObj(interp, objv[3]);
+    if (object == NULL) {
+        result = TCL_ERROR;
+    } else {
+        result = Itcl_InvokeMethod(interp, method, object, objc-4, objv+4);
+    }
+    Itcl_ReleaseMethod(method);
+    return result;
+}
+
+/*
+ *  Handler registered with Itcl_RegisterMethodC as "testMethodC",
+ *  taking one or two arguments.  Returns the object name, the class
+ *  of the method and the arguments including the method name.
+ */
+static int
+TestMethodC(
+    ClientData clientData,
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclClass *iclsPtr,
+    int objc,
+    Tcl_Obj *const objv[])
+{
+    Tcl_Obj *listPtr;
+    (void)clientData;
+
+    listPtr = Tcl_NewListObj(0, NULL);
+    Tcl_ListObjAppendElement(NULL, listPtr, ioPtr->namePtr);
+    Tcl_ListObjAppendElement(NULL, listPtr, iclsPtr->fullNamePtr);
+    Tcl_ListObjAppendElement(NULL, listPtr, Tcl_NewListObj(objc, objv));
+    Tcl_SetObjResult(interp, listPtr);
+    return TCL_OK;
+}
 
 void
 RegisterDebugCFunctions(Tcl_Interp *interp)
 {
     int result;
 
+    Tcl_CreateObjCommand(interp, "testinvokemethod", TestInvokeMethodCmd,
+            NULL, NULL);
+    Itcl_RegisterMethodC(interp, "testMethodC", TestMethodC, 1, 2,
+            NULL, NULL);
+
     /* args: interp, name, c-function, clientdata, deleteproc */
     result = Itcl_RegisterC(interp, "cArgFunc", cArgFunc, NULL, NULL);
     result = Itcl_RegisterObjC(interp, "cObjFunc", cObjFunc, NULL, NULL);
@@ -33,12 +33,30 @@
 
 /*
  *  POOL OF LIST ELEMENTS FOR LINKED LIST
+ *
+ *  Each thread has a pool of its own, so interpreters running in
+ *  different threads never touch the same pool and need no locking.
+ *  The maximum number of elements kept in a pool can be set at
+ *  compile time with -DITCL_LIST_POOL_SIZE=<n>.
  */
-static Itcl_ListElem *listPool = NULL;
-static int listPoolLen = 0;
+typedef struct ListPool {
+    int initialized;                /* exit handler has been installed */
+    int len;                        /* number of elements in the pool */
+    Itcl_ListElem *elems;           /* unused elements, linked by next */
+    Tcl_WideInt numUsed;            /* elements handed out and not yet
+                                     * deleted, for ItclGetMemStats() */
+} ListPool;
+
+static Tcl_ThreadDataKey listPoolKey;
+
+static ListPool *GetListPool(void);
+static void FreeListPool(ClientData clientData);
+static int CanAccessFunc(ItclMemberFunc *imPtr, Tcl_Namespace *fromNsPtr);
 
 #define ITCL_VALID_LIST 0x01face10  /* magic bit pattern for validation */
-#define ITCL_LIST_POOL_SIZE 200     /* max number of elements in listPool */
+#ifndef ITCL_LIST_POOL_SIZE
+#define ITCL_LIST_POOL_SIZE 1024    /* max number of elements in a pool */
+#endif
 
 /*
  *  This structure is used to take a snapshot of the interpreter
@@ -112,7 +130,7 @@ Itcl_DeleteStack(
      *  built-in buffer) then free it.
      */
     if (stack->values != stack->space) {
-        ckfree((char*)stack->values);
+        Itcl_Free(stack->values);
     }
     stack->values = NULL;
     stack->len = stack->max = 0;
@@ -136,14 +154,14 @@ Itcl_PushStack(
     if (stack->len+1 >= stack->max) {
         stack->max = 2*stack->max;
         newStack = (ClientData*)
-            ckalloc((unsigned)(stack->max*sizeof(ClientData)));
+            Itcl_Alloc(stack->max*sizeof(ClientData));
 
         if (stack->values) {
             memcpy((char*)newStack, (char*)stack->values,
                 (size_t)(stack->len*sizeof(ClientData)));
 
             if (stack->values != stack->space)
-                ckfree((char*)stack->values);
+                Itcl_Free(stack->values);
         }
         stack->values = newStack;
     }
@@ -263,15 +281,18 @@ Itcl_ListElem*
 Itcl_CreateListElem(
     Itcl_List *listPtr)     /* list that will contain this new element */
 {
+    ListPool *poolPtr;
     Itcl_ListElem *elemPtr;
 
-    if (listPoolLen > 0) {
-        elemPtr = listPool;
-        listPool = elemPtr->next;
-        --listPoolLen;
+    poolPtr = GetListPool();
+    if (poolPtr->len > 0) {
+        elemPtr = poolPtr->elems;
+        poolPtr->elems = elemPtr->next;
+        --poolPtr->len;
     } else {
         elemPtr = (Itcl_ListElem*)ckalloc((unsigned)sizeof(Itcl_ListElem));
     }
+    poolPtr->numUsed++;
     elemPtr->owner = listPtr;
     elemPtr->value = NULL;
     elemPtr->next  = NULL;
@@ -293,6 +314,7 @@ Itcl_ListElem*
 Itcl_DeleteListElem(
     Itcl_ListElem *elemPtr)     /* list element to be deleted */
 {
+    ListPool *poolPtr;
     Itcl_List *listPtr;
     Itcl_ListElem *nextPtr;
 
@@ -314,10 +336,12 @@ Itcl_DeleteListElem(
     }
     --listPtr->num;
 
-    if (listPoolLen < ITCL_LIST_POOL_SIZE) {
-        elemPtr->next = listPool;
-        listPool = elemPtr;
-        ++listPoolLen;
+    poolPtr = GetListPool();
+    poolPtr->numUsed--;
+    if (poolPtr->len < ITCL_LIST_POOL_SIZE) {
+        elemPtr->next = poolPtr->elems;
+        poolPtr->elems = elemPtr;
+        ++poolPtr->len;
     } else {
         ckfree((char*)elemPtr);
     }
@@ -494,28 +518,69 @@ Itcl_SetListValue(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  GetListPool()
+ *
+ *  Returns the list element pool of the current thread.  The first
+ *  call in a thread arranges for the pool to be freed when the thread
+ *  exits.
+ * ------------------------------------------------------------------------
+ */
+static ListPool *
+GetListPool(void)
+{
+    ListPool *poolPtr;
+
+    poolPtr = (ListPool *)Tcl_GetThreadData(&listPoolKey, sizeof(ListPool));
+    if (!poolPtr->initialized) {
+        poolPtr->initialized = 1;
+        Tcl_CreateThreadExitHandler(FreeListPool, NULL);
+    }
+    return poolPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FreeListPool()
+ *
+ *  Thread exit handler that frees all elements in the pool of the
+ *  exiting thread.
+ * ------------------------------------------------------------------------
+ */
+static void
+FreeListPool(
+    ClientData clientData)   /* unused */
+{
+    (void)clientData;
+
+    Itcl_FinishList();
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_FinishList()
  *
- *  free all memory used in the list pool
+ *  free all memory used in the list pool of the current thread
  * ------------------------------------------------------------------------
  */
 void
 Itcl_FinishList()
 {
+    ListPool *poolPtr;
     Itcl_ListElem *listPtr;
     Itcl_ListElem *elemPtr;
 
-    listPtr = listPool;
+    poolPtr = (ListPool *)Tcl_GetThreadData(&listPoolKey, sizeof(ListPool));
+    listPtr = poolPtr->elems;
     while (listPtr != NULL) {
         elemPtr = listPtr;
 	listPtr = elemPtr->next;
 	ckfree((char *)elemPtr);
         elemPtr = NULL;
     }
-    listPool = NULL;
-    listPoolLen = 0;
+    poolPtr->elems = NULL;
+    poolPtr->len = 0;
 }
 
 
@@ -532,9 +597,56 @@ Itcl_FinishList()
 
 typedef struct PresMemoryPrefix {
     Tcl_FreeProc *freeProc;     /* called by last Itcl_ReleaseData */
-    size_t refCount;            /* refernce (resp preserving) counter */
+    unsigned int refCount;      /* refernce (resp preserving) counter */
+    unsigned int numBytes;      /* size of the block, this prefix
+                                 * included; see BlockSizeClass() */
 } PresMemoryPrefix;
 
+/*
+ *  POOLS OF SMALL MEMORY BLOCKS
+ *
+ *  Call contexts, frame records, member code and the like are small
+ *  records of a few fixed sizes that come and go on every method call.
+ *  Itcl_Alloc() rounds small requests up to a multiple of
+ *  ITCL_BLOCK_GRAIN bytes, and Itcl_Free() keeps the freed blocks in a
+ *  pool per size class instead of giving them back to ckfree.  As with
+ *  the list element pool, each thread has pools of its own.  The
+ *  number of blocks kept per size class can be set at compile time
+ *  with -DITCL_BLOCK_POOL_SIZE=<n>, 0 turns the pools off.
+ */
+#define ITCL_BLOCK_GRAIN 16          /* size classes are this far apart */
+#define ITCL_BLOCK_CLASSES 32        /* largest pooled block is 512 bytes */
+#ifndef ITCL_BLOCK_POOL_SIZE
+#define ITCL_BLOCK_POOL_SIZE 256     /* max number of blocks per size class */
+#endif
+
+typedef struct FreeBlock {
+    struct FreeBlock *next;          /* next unused block of the same size */
+} FreeBlock;
+
+typedef struct BlockPool {
+    int initialized;                 /* exit handler has been installed */
+    int len[ITCL_BLOCK_CLASSES];     /* number of blocks in each pool */
+    FreeBlock *blocks[ITCL_BLOCK_CLASSES];
+                                     /* unused blocks of each size class */
+    Tcl_WideInt numUsed;             /* blocks handed out by Itcl_Alloc()
+                                      * and not yet freed */
+    Tcl_WideInt bytesUsed;           /* total size of these blocks */
+} BlockPool;
+
+/*
+ *  The size class of a block: blocks whose size rounded up to the
+ *  grain stays below ITCL_BLOCK_CLASSES grains were rounded up when
+ *  they were allocated and go back to the pool of their class.
+ */
+#define BlockSizeClass(numBytes) \
+    ((unsigned int)(((numBytes) + ITCL_BLOCK_GRAIN - 1) / ITCL_BLOCK_GRAIN))
+
+static Tcl_ThreadDataKey blockPoolKey;
+
+static BlockPool *GetBlockPool(void);
+static void FreeBlockPool(ClientData clientData);
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_EventuallyFree()
@@ -646,17 +758,36 @@ void * Itcl_Alloc(
     size_t size)	/* Size of memory to allocate */
 {
     size_t numBytes;
+    unsigned int sizeClass;
+    BlockPool *poolPtr;
     PresMemoryPrefix *blk;
 
     /* The ckalloc() in Tcl 8 can alloc at most UINT_MAX bytes */
     assert (size <= UINT_MAX - sizeof(PresMemoryPrefix));
     numBytes = size + sizeof(PresMemoryPrefix);
 
-    /* This will panic on allocation failure. No need to check return value. */
-    blk = (PresMemoryPrefix *)ckalloc(numBytes);
+    sizeClass = BlockSizeClass(numBytes);
+    blk = NULL;
+    poolPtr = GetBlockPool();
+    if ((ITCL_BLOCK_POOL_SIZE > 0) && (sizeClass < ITCL_BLOCK_CLASSES)) {
+	numBytes = sizeClass * ITCL_BLOCK_GRAIN;
+	if (poolPtr->len[sizeClass] > 0) {
+	    blk = (PresMemoryPrefix *)poolPtr->blocks[sizeClass];
+	    poolPtr->blocks[sizeClass] = poolPtr->blocks[sizeClass]->next;
+	    poolPtr->len[sizeClass]--;
+	}
+    }
+
+    if (blk == NULL) {
+	/* This will panic on allocation failure. No need to check return value. */
+	blk = (PresMemoryPrefix *)ckalloc(numBytes);
+    }
 
     /* Itcl_Alloc defined to zero-init memory it allocates */
     memset(blk, 0, numBytes);
+    blk->numBytes = (unsigned int)numBytes;
+    poolPtr->numUsed++;
+    poolPtr->bytesUsed += numBytes;
 
     /* ckalloc block to Itcl memory block */
     return blk+1;
@@ -666,6 +797,7 @@ void * Itcl_Alloc(
  * ItclFree()
  *
  *	Release memory allocated by Itcl_Alloc() that was never preserved.
+ *	Small blocks are kept in the pool of the current thread for reuse.
  *
  * Results:
  *	None.
@@ -674,6 +806,9 @@ void * Itcl_Alloc(
  */
 void Itcl_Free(void *ptr) {
     PresMemoryPrefix *blk;
+    BlockPool *poolPtr;
+    FreeBlock *freePtr;
+    unsigned int sizeClass;
 
     if (ptr == NULL) {
 	return;
@@ -683,9 +818,109 @@ void Itcl_Free(void *ptr) {
 
     assert(blk->refCount == 0); /* it should be not preserved */
     assert(blk->freeProc == NULL); /* it should be released */
+    sizeClass = BlockSizeClass(blk->numBytes);
+    poolPtr = GetBlockPool();
+    poolPtr->numUsed--;
+    poolPtr->bytesUsed -= blk->numBytes;
+    if ((ITCL_BLOCK_POOL_SIZE > 0) && (sizeClass < ITCL_BLOCK_CLASSES)) {
+	if (poolPtr->len[sizeClass] < ITCL_BLOCK_POOL_SIZE) {
+	    freePtr = (FreeBlock *)blk;
+	    freePtr->next = poolPtr->blocks[sizeClass];
+	    poolPtr->blocks[sizeClass] = freePtr;
+	    poolPtr->len[sizeClass]++;
+	    return;
+	}
+    }
     ckfree(blk);
 }
-
+
+/*
+ * ------------------------------------------------------------------------
+ *  GetBlockPool()
+ *
+ *  Returns the memory block pools of the current thread.  The first
+ *  call in a thread arranges for the pools to be freed when the thread
+ *  exits.
+ * ------------------------------------------------------------------------
+ */
+static BlockPool *
+GetBlockPool(void)
+{
+    BlockPool *poolPtr;
+
+    poolPtr = (BlockPool *)Tcl_GetThreadData(&blockPoolKey,
+            sizeof(BlockPool));
+    if (!poolPtr->initialized) {
+        poolPtr->initialized = 1;
+        Tcl_CreateThreadExitHandler(FreeBlockPool, NULL);
+    }
+    return poolPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FreeBlockPool()
+ *
+ *  Thread exit handler that gives all blocks in the pools of the
+ *  exiting thread back to ckfree.
+ * ------------------------------------------------------------------------
+ */
+static void
+FreeBlockPool(
+    ClientData clientData)   /* unused */
+{
+    BlockPool *poolPtr;
+    FreeBlock *freePtr;
+    int i;
+    (void)clientData;
+
+    poolPtr = (BlockPool *)Tcl_GetThreadData(&blockPoolKey,
+            sizeof(BlockPool));
+    for (i = 0; i < ITCL_BLOCK_CLASSES; i++) {
+	while (poolPtr->blocks[i] != NULL) {
+	    freePtr = poolPtr->blocks[i];
+	    poolPtr->blocks[i] = freePtr->next;
+	    ckfree((char *)freePtr);
+	}
+	poolPtr->len[i] = 0;
+    }
+    poolPtr->initialized = 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetMemStats()
+ *
+ *  Fills in how many list elements and Itcl_Alloc() blocks the current
+ *  thread has in use and how many it keeps in its pools, for the
+ *  "itcl::memstats" command.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclGetMemStats(
+    ItclMemStats *statsPtr)  /* returns the counters */
+{
+    ListPool *listPoolPtr;
+    BlockPool *blockPoolPtr;
+    int i;
+
+    listPoolPtr = GetListPool();
+    statsPtr->listElemsUsed = listPoolPtr->numUsed;
+    statsPtr->listElemsPooled = listPoolPtr->len;
+    statsPtr->listElemSize = sizeof(Itcl_ListElem);
+
+    blockPoolPtr = GetBlockPool();
+    statsPtr->blocksUsed = blockPoolPtr->numUsed;
+    statsPtr->blockBytesUsed = blockPoolPtr->bytesUsed;
+    statsPtr->blocksPooled = 0;
+    statsPtr->blockBytesPooled = 0;
+    for (i = 0; i < ITCL_BLOCK_CLASSES; i++) {
+	statsPtr->blocksPooled += blockPoolPtr->len[i];
+	statsPtr->blockBytesPooled +=
+	        (Tcl_WideInt)blockPoolPtr->len[i] * i * ITCL_BLOCK_GRAIN;
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_SaveInterpState()
@@ -965,6 +1200,10 @@ Itcl_CanAccess(
  *  current context is a base class that has the same method, then
  *  access is allowed.
  *
+ *  The result for the last namespace asking is kept on the function
+ *  until any class definition changes, as protected and private
+ *  functions are mostly called from the same class over and over.
+ *
  *  Returns 1/0 indicating true/false.
  * ------------------------------------------------------------------------
  */
@@ -972,6 +1211,32 @@ int
 Itcl_CanAccessFunc(
     ItclMemberFunc* imPtr,     /* member function being tested */
     Tcl_Namespace* fromNsPtr)  /* namespace requesting access */
+{
+    if (imPtr->protection == ITCL_PUBLIC) {
+        return 1;
+    }
+    if ((imPtr->accessNsPtr == fromNsPtr)
+            && (imPtr->accessEpoch == imPtr->infoPtr->protoEpoch)) {
+        return imPtr->accessResult;
+    }
+    imPtr->accessResult = CanAccessFunc(imPtr, fromNsPtr);
+    imPtr->accessNsPtr = fromNsPtr;
+    imPtr->accessEpoch = imPtr->infoPtr->protoEpoch;
+    return imPtr->accessResult;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  CanAccessFunc()
+ *
+ *  Does the checks of Itcl_CanAccessFunc() without looking at the
+ *  cached result.
+ * ------------------------------------------------------------------------
+ */
+static int
+CanAccessFunc(
+    ItclMemberFunc* imPtr,     /* member function being tested */
+    Tcl_Namespace* fromNsPtr)  /* namespace requesting access */
 {
     ItclClass *iclsPtr;
     ItclClass *fromIclsPtr;
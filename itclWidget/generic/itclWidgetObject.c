@@ -226,7 +226,8 @@ InstallComponent(
     /* first check for number of delegated options */
     numOpts = 0;
     starOption = 1;
-    FOREACH_HASH_VALUE(idoPtr, &ioPtr->objectDelegatedOptions) {
+    FOREACH_HASH_VALUE(idoPtr,
+            &ItclObjectTablesOf(ioPtr)->objectDelegatedOptions) {
 	if (strcmp(Tcl_GetString(idoPtr->namePtr), "*") == 0) {
 	    starOption = 1;
 	    starOptionPtr = idoPtr;
@@ -283,7 +284,8 @@ InstallComponent(
 	        val = Tk_GetOption(tkWin, argv2[1], argv2[2]);
 	        if (val != NULL) {
 		    objPtr = Tcl_NewStringObj(argv2[0], -1);
-		    hPtr = Tcl_FindHashEntry(&ioPtr->objectOptions,
+		    hPtr = Tcl_FindHashEntry(
+		            &ItclObjectTablesOf(ioPtr)->objectOptions,
 		            (char *)objPtr);
 		    if(hPtr == NULL) {
 			if (starOptionPtr != NULL) {
@@ -322,7 +324,8 @@ InstallComponent(
         }
         i = j - startIdx;
         if (numOpts > 0) {
-            FOREACH_HASH_VALUE(idoPtr, &ioPtr->objectDelegatedOptions) {
+            FOREACH_HASH_VALUE(idoPtr,
+                    &ItclObjectTablesOf(ioPtr)->objectDelegatedOptions) {
 	        val = Tk_GetOption(tkWin,
 	                Tcl_GetString(idoPtr->resourceNamePtr),
 	                Tcl_GetString(idoPtr->classNamePtr));
@@ -16,7 +16,11 @@
 
 
 if {![namespace exists ::tclTestPerf]} {
-  source [file join [file dirname [info library]] tests-perf test-performance.tcl]
+  if {[file exists [file join [file dirname [info library]] tests-perf test-performance.tcl]]} {
+    source [file join [file dirname [info library]] tests-perf test-performance.tcl]
+  } else {
+    source [file join [file dirname [info script]] perf-harness.tcl]
+  }
 }
 
 namespace eval ::itclTestPerf-Basic {
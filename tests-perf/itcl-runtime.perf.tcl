@@ -0,0 +1,292 @@
+#!/usr/bin/tclsh
+
+# ------------------------------------------------------------------------
+#
+# itcl-runtime.perf.tcl --
+#
+#  This file provides performance tests for the run-time hot paths of
+#  itcl: method dispatch, object creation, configure/cget, ensembles,
+#  delegation and introspection.  Run it from the build directory with
+#  "make perf", or directly (see the end of this file), and compare the
+#  numbers of two builds on the same machine.
+#
+# ------------------------------------------------------------------------
+#
+# See the file "license.terms" for information on usage and redistribution
+# of this file.
+#
+
+
+if {![namespace exists ::tclTestPerf]} {
+  if {[file exists [file join [file dirname [info library]] tests-perf test-performance.tcl]]} {
+    source [file join [file dirname [info library]] tests-perf test-performance.tcl]
+  } else {
+    source [file join [file dirname [info script]] perf-harness.tcl]
+  }
+}
+
+namespace eval ::itclTestPerf-Runtime {
+
+namespace path {::tclTestPerf}
+
+
+proc setup-classes {} {
+  itcl::class ::perfBase {
+    public variable pub 1
+    protected variable pro 2
+    private variable pri 3
+    public variable cfg 0 {set cfgCount [incr cfgCount]}
+    common cfgCount 0
+    constructor {args} {}
+    destructor {}
+    public method pubm {} {return $pub}
+    protected method prom {} {return $pro}
+    private method prim {} {return $pri}
+    public method callpro {} {prom}
+    public method callpri {} {prim}
+    public method callthis {} {$this pubm}
+    public method chained {} {return base}
+    public proc clsproc {} {return 1}
+  }
+  itcl::class ::perfMid {
+    inherit ::perfBase
+    constructor {args} {}
+    public method chained {} {chain}
+  }
+  itcl::class ::perfDerived {
+    inherit ::perfMid
+    constructor {args} {}
+    public method chained {} {chain}
+  }
+  itcl::ensemble ::perfEnsemble {
+    part one {} {return 1}
+    ensemble sub {
+      part two {} {return 2}
+    }
+  }
+  itcl::class ::perfTarget {
+    public method length {s} {string length $s}
+  }
+  itcl::extendedclass ::perfEclass {
+    component target
+    delegate method length to target
+    option -color red
+    constructor {} {set target [::perfTarget ::#auto]}
+  }
+  itcl::type ::perfColor {
+    option -color black
+    method hue {} {return 1}
+  }
+  itcl::type ::perfType {
+    component inner
+    delegate method * to inner
+    delegate option -color to inner
+    constructor {} {set inner [::perfColor %AUTO%]}
+  }
+}
+
+proc cleanup-classes {} {
+  foreach cls {::perfDerived ::perfMid ::perfBase ::perfEclass ::perfTarget} {
+    if {[itcl::is class $cls]} {
+      itcl::delete class $cls
+    }
+  }
+  foreach cls {::perfType ::perfColor} {
+    if {[info commands $cls] ne ""} {
+      $cls destroy
+    }
+  }
+  if {[info commands ::perfEnsemble] ne ""} {
+    rename ::perfEnsemble {}
+  }
+}
+
+# ------------------------------------------------------------------------
+
+# method dispatch:
+proc test-dispatch {{reptime 1000}} {
+  _test_run $reptime {
+    setup {::perfDerived o}
+    # public method
+    {o pubm}
+    # protected method from inside
+    {o callpro}
+    # private method from inside
+    {o callpri}
+    # method through $this
+    {o callthis}
+    # chain through two bases
+    {o chained}
+    # class proc
+    {::perfBase::clsproc}
+    # qualified method
+    {o ::perfBase::pubm}
+    cleanup {itcl::delete object o}
+  }
+}
+
+# create/delete object:
+proc test-objects {{reptime 1000}} {
+  _test_run $reptime {
+    setup {set i 0}
+    # create base objects
+    {::perfBase pb[incr i]}
+    # delete base objects
+    {itcl::delete object pb$i; if {[incr i -1] <= 0} break}
+    cleanup {while {$i > 0} {itcl::delete object pb$i; incr i -1}}
+    setup {set i 0}
+    # create derived objects (3 levels)
+    {::perfDerived pd[incr i]}
+    # delete derived objects (3 levels)
+    {itcl::delete object pd$i; if {[incr i -1] <= 0} break}
+    cleanup {while {$i > 0} {itcl::delete object pd$i; incr i -1}}
+    # create + delete
+    {::perfDerived o; itcl::delete object o}
+    # create + delete with #auto
+    {itcl::delete object [::perfBase #auto]}
+  }
+}
+
+# configure/cget:
+proc test-config {{reptime 1000}} {
+  _test_run $reptime {
+    setup {::perfDerived o}
+    # cget
+    {o cget -pub}
+    # configure without config body
+    {o configure -pub 5}
+    # configure with config body
+    {o configure -cfg 5}
+    # configure two options
+    {o configure -pub 6 -cfg 6}
+    # configure query one option
+    {o configure -pub}
+    # configure query all options
+    {o configure}
+    cleanup {itcl::delete object o}
+  }
+}
+
+# ensemble dispatch:
+proc test-ensemble {{reptime 1000}} {
+  _test_run $reptime {
+    # ensemble part
+    {::perfEnsemble one}
+    # nested ensemble part
+    {::perfEnsemble sub two}
+  }
+}
+
+# delegation:
+proc test-delegation {{reptime 1000}} {
+  _test_run $reptime {
+    setup {::perfEclass e; ::perfType t}
+    # extendedclass delegated method
+    {e length abc}
+    # extendedclass option cget
+    {e cget -color}
+    # extendedclass option configure
+    {e configure -color blue}
+    # type delegated option cget
+    {t cget -color}
+    # type delegated option configure
+    {t configure -color white}
+    # type delegated method *
+    {t hue}
+    cleanup {itcl::delete object e; t destroy}
+  }
+  if {![catch {package require Tk}]} {
+    wm withdraw .
+    itcl::widget ::perfWidget {
+      delegate option * to itcl_hull
+      constructor {args} {installhull using frame; $self configure {*}$args}
+    }
+    _test_run $reptime {
+      # widget create + destroy
+      {::perfWidget .w; destroy .w}
+      setup {::perfWidget .w}
+      # widget delegated option cget
+      {.w cget -width}
+      # widget delegated option configure
+      {.w configure -width 10}
+      cleanup {destroy .w; itcl::delete class ::perfWidget}
+    }
+  }
+}
+
+# introspection:
+proc test-introspect {{reptime 1000}} {
+  _test_run $reptime {
+    setup {set i 0; while {$i < 100} {::perfDerived io[incr i]}; ::perfDerived o}
+    # find objects (100 objects)
+    {itcl::find objects}
+    # find objects -class
+    {itcl::find objects -class ::perfBase}
+    # find objects -isa
+    {itcl::find objects -isa ::perfMid}
+    # find classes
+    {itcl::find classes}
+    # is object
+    {itcl::is object o}
+    # is class
+    {itcl::is class ::perfDerived}
+    # info class
+    {o info class}
+    # info inherit
+    {o info inherit}
+    # info heritage
+    {o info heritage}
+    # info function
+    {o info function pubm}
+    # info variable
+    {o info variable pub}
+    # info variable -value
+    {o info variable pub -value}
+    cleanup {while {$i > 0} {itcl::delete object io$i; incr i -1}; itcl::delete object o}
+  }
+}
+
+# ------------------------------------------------------------------------
+
+proc test {{reptime 1000}} {
+  setup-classes
+  _test_start $reptime
+  puts "==== method dispatch ====\n"
+  test-dispatch $reptime
+  puts "==== object create/delete ====\n"
+  test-objects [_adjust_maxcount $reptime 10000]
+  puts "==== configure/cget ====\n"
+  test-config $reptime
+  puts "==== ensembles ====\n"
+  test-ensemble $reptime
+  puts "==== delegation ====\n"
+  test-delegation $reptime
+  puts "==== introspection ====\n"
+  test-introspect $reptime
+  _test_out_total
+  cleanup-classes
+
+  puts \n**OK**
+}
+
+}; # end of ::itclTestPerf-Runtime
+
+# ------------------------------------------------------------------------
+
+# if calling direct:
+if {[info exists ::argv0] && [file tail $::argv0] eq [file tail [info script]]} {
+  array set in {-time 500 -lib {} -load {}}
+  array set in $argv
+  if {$in(-load) ne ""} {
+    eval $in(-load)
+  }
+  if {![namespace exists ::itcl]} {
+    if {$in(-lib) eq ""} {
+      set in(-lib) "itcl412"
+    }
+    puts "testing with $in(-lib)"
+    load $in(-lib) itcl
+  }
+
+  ::itclTestPerf-Runtime::test $in(-time)
+}
@@ -0,0 +1,114 @@
+# ------------------------------------------------------------------------
+#
+# perf-harness.tcl --
+#
+#  A small stand-in for the test-performance.tcl helper of the Tcl
+#  source tree, used by the *.perf.tcl files when that helper is not
+#  available (for example when building against an installed Tcl).  It
+#  provides the part of ::tclTestPerf the itcl performance tests use.
+#
+# ------------------------------------------------------------------------
+#
+# See the file "license.terms" for information on usage and redistribution
+# of this file.
+#
+
+if {[namespace which -command ::timerate] eq {}} {
+  namespace eval ::tcl::unsupported {namespace export timerate}
+  namespace import ::tcl::unsupported::timerate
+}
+
+namespace eval ::tclTestPerf {
+
+variable tests_started 0
+variable total {}
+
+# Returns reptime with its count limited to maxcount.
+proc _adjust_maxcount {reptime maxcount} {
+  if {[llength $reptime] > 1} {
+    lreplace $reptime 1 1 [expr {min($maxcount,[lindex $reptime 1])}]
+  } else {
+    lappend reptime $maxcount
+  }
+}
+
+# Prints the result of one timerate measurement and adds it to the total.
+proc _test_iter {args} {
+  variable total
+  if {[llength $args] > 2} {
+    return -code error "wrong # args: should be \"[lindex [info level [info level]] 0] ?level? measure-result\""
+  }
+  set res [lindex $args end]
+  puts [format "%-50s" $res]
+  if {[llength $res] >= 4} {
+    lappend total [lindex $res 0] [lindex $res 2] [lindex $res end-1]
+  }
+  return $res
+}
+
+proc _test_start {reptime} {
+  variable tests_started
+  variable total
+  set tests_started 1
+  set total {}
+  puts [format "Start performance test with %s ms, max %s iterations" \
+    [lindex $reptime 0] [expr {[llength $reptime] > 1 ? [lindex $reptime 1] : "-"}]]
+  puts "-----------------------------------------------------------------\n"
+}
+
+proc _test_out_total {} {
+  variable tests_started
+  variable total
+  if {!$tests_started} return
+  set count 0; set mics 0; set iters 0; set ms 0
+  foreach {m i n} $total {
+    incr count
+    set mics [expr {$mics + $m}]
+    incr iters $i
+    set ms [expr {$ms + $n}]
+  }
+  puts "-----------------------------------------------------------------"
+  if {$count} {
+    puts [format "Total %d cases in %.2f sec., %d iterations:" \
+      $count [expr {$ms / 1000.0}] $iters]
+    puts [format "  %.6f µs/# average of the cases" [expr {$mics / $count}]]
+  }
+  puts "-----------------------------------------------------------------\n"
+  set tests_started 0
+  set total {}
+}
+
+# Runs a list of test cases.  Each case is one complete command on a
+# line of its own; "#" lines are printed as titles, "setup" and
+# "cleanup" scripts are evaluated once, everything else is measured
+# with timerate.
+proc _test_run {reptime lst} {
+  variable tests_started
+  set started $tests_started
+  if {!$started} {
+    _test_start $reptime
+  }
+  set cmd {}
+  foreach line [split $lst \n] {
+    append cmd $line \n
+    if {![info complete $cmd]} continue
+    set cmd [string trim $cmd]
+    if {$cmd eq {}} continue
+    if {[string index $cmd 0] eq "#"} {
+      puts $cmd
+    } elseif {[regexp {^(setup|cleanup)\s+(.*)$} $cmd -> kind script]} {
+      puts "% $kind [string trim [lindex $script 0]]"
+      uplevel 1 [lindex $script 0]
+    } else {
+      set script [lindex $cmd 0]
+      puts "% [string trim $script]"
+      _test_iter [uplevel 1 [list timerate $script {*}$reptime]]
+    }
+    set cmd {}
+  }
+  if {!$started} {
+    _test_out_total
+  }
+}
+
+}; # end of ::tclTestPerf